@@ -107,7 +107,8 @@ static int evey_args_search_short_arg(EVEY_ARGS_OPTION * ops, const char argv)
 static int evey_args_read_value(EVEY_ARGS_OPTION * ops, const char * argv)
 {
     if(argv == NULL) return -1;
-    if(argv[0] == '-' && (argv[1] < '0' || argv[1] > '9')) return -1;
+    /* a lone "-" is a value (stdin/stdout), not an option */
+    if(argv[0] == '-' && argv[1] != '\0' && (argv[1] < '0' || argv[1] > '9')) return -1;
 
     switch(EVEY_ARGS_GET_CMD_OPT_VAL_TYPE(ops->val_type))
     {
@@ -0,0 +1,689 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* End-to-end encoder/decoder benchmark.
+
+   Runs eveya_encoder and eveya_decoder for every canned preset of cfg/ on a
+   synthetic clip, and on a sample clip if one is given. Each run writes its
+   own report (--bench_json) with the wall time per stage, fps and peak
+   memory. The reports are merged into one flat JSON file, which can be
+   compared against a stored baseline report. With --check_seek and
+   --check_nal_sink, it checks the seeking of eveya_decoder with a bitstream
+   index and the CTU row chunks of the NAL sink of eveya_encoder instead. */
+
+#include "evey.h"
+#include "eveya_util.h"
+#include "eveya_args.h"
+
+#define MAX_ENTRY                  (1024)
+#define MAX_PATH_LEN               (1024)
+
+static char op_cfg_dir[256] = "cfg";
+static char op_bin_dir[256] = "\0";
+static char op_work_dir[256] = ".";
+static char op_fname_inp[256] = "\0";
+static char op_fname_out[256] = "bench.json";
+static char op_fname_base[256] = "\0";
+static char op_preset[16] = "all";
+static int  op_w = 416;
+static int  op_h = 240;
+static int  op_in_bit_depth = 8;
+static int  op_frames = 8;
+static int  op_tolerance = 5;
+static int  op_check_seek = 0;
+static int  op_check_nal_sink = 0;
+
+typedef enum _OP_FLAGS
+{
+    OP_FLAG_CFG_DIR,
+    OP_FLAG_BIN_DIR,
+    OP_FLAG_WORK_DIR,
+    OP_FLAG_FNAME_INP,
+    OP_FLAG_FNAME_OUT,
+    OP_FLAG_FNAME_BASE,
+    OP_FLAG_PRESET,
+    OP_FLAG_WIDTH,
+    OP_FLAG_HEIGHT,
+    OP_FLAG_IN_BIT_DEPTH,
+    OP_FLAG_FRAMES,
+    OP_FLAG_TOLERANCE,
+    OP_FLAG_CHECK_SEEK,
+    OP_FLAG_CHECK_NAL_SINK,
+    OP_FLAG_VERBOSE,
+    OP_FLAG_MAX
+
+} OP_FLAGS;
+
+static int op_flag[OP_FLAG_MAX] = {0};
+
+static EVEY_ARGS_OPTION options[] = \
+{
+    {
+        EVEY_ARGS_NO_KEY, "cfg_dir", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_CFG_DIR], op_cfg_dir,
+        "directory of the encoder configuration files (default: cfg)"
+    },
+    {
+        EVEY_ARGS_NO_KEY, "bin_dir", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_BIN_DIR], op_bin_dir,
+        "directory of eveya_encoder and eveya_decoder (default: directory of this program)"
+    },
+    {
+        EVEY_ARGS_NO_KEY, "work_dir", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_WORK_DIR], op_work_dir,
+        "directory of the intermediate clips, bitstreams and reports (default: .)"
+    },
+    {
+        'i', "input", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_INP], op_fname_inp,
+        "file name of a sample YUV 4:2:0 clip, benchmarked in addition to the synthetic clip"
+    },
+    {
+        'o', "output", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_OUT], op_fname_out,
+        "file name of the merged JSON report (default: bench.json)"
+    },
+    {
+        'b', "baseline", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_BASE], op_fname_base,
+        "file name of a stored JSON report to compare against"
+    },
+    {
+        EVEY_ARGS_NO_KEY, "preset", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_PRESET], op_preset,
+        "preset to run: all(default), ld, ldp, ra, ai, sp"
+    },
+    {
+        'w', "width", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_WIDTH], &op_w,
+        "pixel width of the clips (default: 416)"
+    },
+    {
+        'h', "height", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_HEIGHT], &op_h,
+        "pixel height of the clips (default: 240)"
+    },
+    {
+        'd', "input_bit_depth", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_IN_BIT_DEPTH], &op_in_bit_depth,
+        "bit depth of the sample clip (default: 8)"
+    },
+    {
+        'f', "frames", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_FRAMES], &op_frames,
+        "number of frames to encode (default: 8)"
+    },
+    {
+        't', "tolerance", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_TOLERANCE], &op_tolerance,
+        "fps drop against the baseline reported as regression, in percent (default: 5)"
+    },
+    {
+        EVEY_ARGS_NO_KEY, "check_seek", EVEY_ARGS_VAL_TYPE_NONE,
+        &op_flag[OP_FLAG_CHECK_SEEK], &op_check_seek,
+        "instead of benchmarking, check that seeking with a bitstream index\n"
+        "\t gives the frames of the full decoding, on a random access stream\n"
+        "\t with closed GOPs"
+    },
+    {
+        EVEY_ARGS_NO_KEY, "check_nal_sink", EVEY_ARGS_VAL_TYPE_NONE,
+        &op_flag[OP_FLAG_CHECK_NAL_SINK], &op_check_nal_sink,
+        "instead of benchmarking, check that the NAL units put back together\n"
+        "\t from the CTU row chunks of the NAL sink give the normal bitstream"
+    },
+    {
+        'v', "verbose", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_VERBOSE], &op_verbose,
+        "verbose level\n"
+        "\t 0: no message\n"
+        "\t 1: summary (default)\n"
+        "\t 2: all messages\n"
+    },
+    { 0, "", EVEY_ARGS_VAL_TYPE_NONE, NULL, NULL, ""} /* termination */
+};
+
+#define NUM_ARG_OPTION   ((int)(sizeof(options)/sizeof(options[0]))-1)
+static void print_usage(void)
+{
+    int i;
+    char str[1024];
+
+    logv0("< Usage >\n");
+
+    for(i=0; i<NUM_ARG_OPTION; i++)
+    {
+        if(evey_args_get_help(options, i, str) < 0) return;
+        logv0("%s\n", str);
+    }
+}
+
+/* canned encoder settings on top of the configuration file */
+typedef struct _BENCH_PRESET
+{
+    const char * name;
+    const char * cfg;
+    const char * args;
+
+} BENCH_PRESET;
+
+static const BENCH_PRESET presets[] =
+{
+    {"ld",  "encoder_lowdelay.cfg",     "-q 32"},
+    {"ldp", "encoder_lowdelay_P.cfg",   "-q 37 --inter_slice_type 1"},
+    {"ra",  "encoder_randomaccess.cfg", "-q 27"},
+    {"ai",  "encoder_allintra.cfg",     "-q 22 -p 1"},
+    {"sp",  "encoder_still_pic.cfg",    "-q 22 -f 1"},
+};
+
+#define NUM_PRESET   ((int)(sizeof(presets)/sizeof(presets[0])))
+
+typedef struct _BENCH_ENTRY
+{
+    char         key[128];
+    double       val;
+
+} BENCH_ENTRY;
+
+typedef struct _BENCH_REPORT
+{
+    BENCH_ENTRY  ent[MAX_ENTRY];
+    int          num;
+
+} BENCH_REPORT;
+
+static BENCH_REPORT report;
+static BENCH_REPORT baseline;
+
+/* reads a flat JSON report written by bench_json_put(); every key is
+   prefixed with the given string */
+static int report_load(BENCH_REPORT * rep, const char * fname, const char * prefix)
+{
+    FILE * fp;
+    char   line[256], key[100];
+    double val;
+
+    fp = fopen(fname, "r");
+    if(fp == NULL) return -1;
+
+    while(fgets(line, sizeof(line), fp) != NULL && rep->num < MAX_ENTRY)
+    {
+        if(sscanf(line, " \"%99[^\"]\": %lf", key, &val) != 2) continue;
+        snprintf(rep->ent[rep->num].key, sizeof(rep->ent[rep->num].key), "%s%s", prefix, key);
+        rep->ent[rep->num].val = val;
+        rep->num++;
+    }
+    fclose(fp);
+    return 0;
+}
+
+static BENCH_ENTRY * report_find(BENCH_REPORT * rep, const char * key)
+{
+    int i;
+    for(i = 0; i < rep->num; i++)
+    {
+        if(!strcmp(rep->ent[i].key, key)) return &rep->ent[i];
+    }
+    return NULL;
+}
+
+static double report_get(BENCH_REPORT * rep, const char * prefix, const char * key)
+{
+    char          str[256];
+    BENCH_ENTRY * e;
+
+    sprintf(str, "%s%s", prefix, key);
+    e = report_find(rep, str);
+    return e ? e->val : 0;
+}
+
+static int report_write(BENCH_REPORT * rep, const char * fname)
+{
+    BENCH_JSON js;
+    int        i;
+
+    if(bench_json_open(&js, fname)) return -1;
+    for(i = 0; i < rep->num; i++)
+    {
+        bench_json_put(&js, rep->ent[i].key, rep->ent[i].val);
+    }
+    bench_json_close(&js);
+    return 0;
+}
+
+static int key_has_suffix(const char * key, const char * suffix)
+{
+    int len = (int)strlen(key), slen = (int)strlen(suffix);
+    return len >= slen && !strcmp(key + len - slen, suffix);
+}
+
+/* 8-bit 4:2:0 clip with a panning gradient, a moving textured block and
+   low amplitude noise, so that intra, inter and skip modes are all used */
+static int synth_write(const char * fname, int w, int h, int frames)
+{
+    FILE          * fp;
+    unsigned char * buf;
+    unsigned int    rnd = 0x12345678;
+    int             t, x, y, v, bx, by;
+
+    buf = (unsigned char *)malloc(w * h);
+    if(buf == NULL) return -1;
+    fp = fopen(fname, "wb");
+    if(fp == NULL)
+    {
+        free(buf);
+        return -1;
+    }
+
+    for(t = 0; t < frames; t++)
+    {
+        bx = (w / 4 + 3 * t) % (w - 64);
+        by = (h / 2 + h - 2 * t) % (h - 64);
+        for(y = 0; y < h; y++)
+        {
+            for(x = 0; x < w; x++)
+            {
+                rnd ^= rnd << 13;
+                rnd ^= rnd >> 17;
+                rnd ^= rnd << 5;
+                v = ((x + 2 * t) + (y + t) / 2) & 255;
+                if(x >= bx && x < bx + 64 && y >= by && y < by + 64)
+                {
+                    v = (((x - bx) >> 3) ^ ((y - by) >> 3)) & 1 ? 200 : 40;
+                }
+                v += (int)(rnd & 7) - 4;
+                buf[y * w + x] = (unsigned char)EVEYA_CLIP(v, 0, 255);
+            }
+        }
+        fwrite(buf, 1, w * h, fp);
+
+        for(y = 0; y < h / 2; y++)
+        {
+            for(x = 0; x < w / 2; x++)
+            {
+                buf[y * (w / 2) + x] = (unsigned char)(96 + ((x + t) & 63));
+            }
+        }
+        fwrite(buf, 1, (w / 2) * (h / 2), fp);
+        for(y = 0; y < h / 2; y++)
+        {
+            for(x = 0; x < w / 2; x++)
+            {
+                buf[y * (w / 2) + x] = (unsigned char)(96 + ((y + t) & 63));
+            }
+        }
+        fwrite(buf, 1, (w / 2) * (h / 2), fp);
+    }
+
+    fclose(fp);
+    free(buf);
+    return 0;
+}
+
+static int run_cmd(const char * cmd)
+{
+    logv2("%s\n", cmd);
+    return system(cmd);
+}
+
+/* encodes and decodes one clip with one preset, and merges both reports */
+static int run_preset(const char * content, const char * fname_yuv, int bit_depth, const BENCH_PRESET * pre)
+{
+    char cmd[4 * MAX_PATH_LEN];
+    char fname_bs[MAX_PATH_LEN], fname_dec[MAX_PATH_LEN];
+    char fname_enc_js[MAX_PATH_LEN], fname_dec_js[MAX_PATH_LEN];
+    char prefix[128];
+
+    sprintf(fname_bs, "%s/bench_%s_%s.evc", op_work_dir, content, pre->name);
+    sprintf(fname_dec, "%s/bench_%s_%s_dec.yuv", op_work_dir, content, pre->name);
+    sprintf(fname_enc_js, "%s/bench_%s_%s_enc.json", op_work_dir, content, pre->name);
+    sprintf(fname_dec_js, "%s/bench_%s_%s_dec.json", op_work_dir, content, pre->name);
+
+    sprintf(cmd, "\"%s/eveya_encoder\" --config \"%s/%s\" -i \"%s\" -w %d -h %d -d %d -z 30 -f %d %s "
+            "-o \"%s\" --bench_json \"%s\" -v 0",
+            op_bin_dir, op_cfg_dir, pre->cfg, fname_yuv, op_w, op_h, bit_depth, op_frames, pre->args,
+            fname_bs, fname_enc_js);
+    if(run_cmd(cmd))
+    {
+        logv0("ERROR: encoding failed: %s\n", cmd);
+        return -1;
+    }
+
+    sprintf(cmd, "\"%s/eveya_decoder\" -i \"%s\" -o \"%s\" --bench_json \"%s\" -v 0",
+            op_bin_dir, fname_bs, fname_dec, fname_dec_js);
+    if(run_cmd(cmd))
+    {
+        logv0("ERROR: decoding failed: %s\n", cmd);
+        return -1;
+    }
+    remove(fname_dec);
+
+    sprintf(prefix, "%s.%s.enc.", content, pre->name);
+    if(report_load(&report, fname_enc_js, prefix))
+    {
+        logv0("ERROR: cannot read %s\n", fname_enc_js);
+        return -1;
+    }
+    sprintf(prefix, "%s.%s.dec.", content, pre->name);
+    if(report_load(&report, fname_dec_js, prefix))
+    {
+        logv0("ERROR: cannot read %s\n", fname_dec_js);
+        return -1;
+    }
+
+    sprintf(prefix, "%s.%s.", content, pre->name);
+    logv1("%-8s %-4s %10.3f %10.3f %10.1f %10.1f %10.0f %8.4f\n", content, pre->name,
+          report_get(&report, prefix, "enc.fps"), report_get(&report, prefix, "dec.fps"),
+          report_get(&report, prefix, "enc.peak_rss_kb") / 1024, report_get(&report, prefix, "dec.peak_rss_kb") / 1024,
+          report_get(&report, prefix, "enc.bytes"), report_get(&report, prefix, "enc.psnr_y"));
+    return 0;
+}
+
+/* whether the file b holds the bytes of the file a from offset on */
+static int file_same_from(const char * fname_a, long offset, const char * fname_b)
+{
+    FILE * fa, * fb;
+    int    ca, cb, same = 0;
+
+    fa = fopen(fname_a, "rb");
+    fb = fopen(fname_b, "rb");
+    if(fa != NULL && fb != NULL && !fseek(fa, offset, SEEK_SET))
+    {
+        do
+        {
+            ca = fgetc(fa);
+            cb = fgetc(fb);
+        } while(ca == cb && ca != EOF);
+        same = ca == cb;
+    }
+    if(fa) fclose(fa);
+    if(fb) fclose(fb);
+    return same;
+}
+
+/* encodes the synthetic clip in random access with an IDR period shorter
+   than the clip, so that the second IDR picture has leading pictures, then
+   seeks to every frame; returns the number of failures */
+static int check_seek(void)
+{
+    char cmd[4 * MAX_PATH_LEN];
+    char fname_yuv[MAX_PATH_LEN], fname_bs[MAX_PATH_LEN], fname_idx[MAX_PATH_LEN];
+    char fname_full[MAX_PATH_LEN], fname_seek[MAX_PATH_LEN];
+    const int frames = 17;
+    FILE * fp;
+    long   frm_size;
+    int    i, num_fail = 0;
+
+    sprintf(fname_yuv, "%s/seek_synth_%dx%d.yuv", op_work_dir, op_w, op_h);
+    sprintf(fname_bs, "%s/seek_ra_cgop.evc", op_work_dir);
+    sprintf(fname_idx, "%s/seek_ra_cgop.idx", op_work_dir);
+    sprintf(fname_full, "%s/seek_ra_cgop_full.yuv", op_work_dir);
+    sprintf(fname_seek, "%s/seek_ra_cgop_seek.yuv", op_work_dir);
+
+    if(synth_write(fname_yuv, op_w, op_h, frames))
+    {
+        logv0("ERROR: cannot write synthetic clip (%s)\n", fname_yuv);
+        return 1;
+    }
+    sprintf(cmd, "\"%s/eveya_encoder\" --config \"%s/encoder_randomaccess.cfg\" -i \"%s\" -w %d -h %d -d 8 -z 30 -f %d "
+            "-q 37 -p 16 --closed_gop -o \"%s\" --index \"%s\" -v 0",
+            op_bin_dir, op_cfg_dir, fname_yuv, op_w, op_h, frames, fname_bs, fname_idx);
+    if(run_cmd(cmd))
+    {
+        logv0("ERROR: encoding failed: %s\n", cmd);
+        return 1;
+    }
+    remove(fname_yuv);
+    sprintf(cmd, "\"%s/eveya_decoder\" -i \"%s\" -o \"%s\" -v 0", op_bin_dir, fname_bs, fname_full);
+    if(run_cmd(cmd))
+    {
+        logv0("ERROR: decoding failed: %s\n", cmd);
+        return 1;
+    }
+    fp = fopen(fname_full, "rb");
+    if(fp == NULL || fseek(fp, 0, SEEK_END))
+    {
+        logv0("ERROR: cannot read %s\n", fname_full);
+        if(fp) fclose(fp);
+        return 1;
+    }
+    frm_size = ftell(fp) / frames;
+    fclose(fp);
+
+    for(i = 0; i <= frames; i++)
+    {
+        remove(fname_seek);
+        sprintf(cmd, "\"%s/eveya_decoder\" -i \"%s\" --index \"%s\" --seek_frame %d -o \"%s\" -v 0",
+                op_bin_dir, fname_bs, fname_idx, i, fname_seek);
+        if(i == frames)
+        {
+            /* past the last frame */
+            if(!run_cmd(cmd))
+            {
+                logv0("ERROR: seeking to frame %d is not rejected\n", i);
+                num_fail++;
+            }
+        }
+        else if(run_cmd(cmd) || !file_same_from(fname_full, i * frm_size, fname_seek))
+        {
+            logv0("ERROR: seeking to frame %d does not give the frames of the full decoding\n", i);
+            num_fail++;
+        }
+    }
+    remove(fname_seek);
+    remove(fname_full);
+    remove(fname_idx);
+    remove(fname_bs);
+
+    logv1("seek check: %d of %d frame(s) failed\n", num_fail, frames + 1);
+    return num_fail;
+}
+
+/* encodes the synthetic clip with and without the CTU row chunks of the
+   NAL sink, with one or several slices per picture and with and without
+   the entropy coding thread; returns the number of failures */
+static int check_nal_sink(void)
+{
+    static const char * cfgs[] = {"encoder_randomaccess.cfg", "encoder_lowdelay.cfg"};
+    char cmd[4 * MAX_PATH_LEN], args[2 * MAX_PATH_LEN];
+    char fname_yuv[MAX_PATH_LEN], fname_bs[MAX_PATH_LEN], fname_sink[MAX_PATH_LEN];
+    const int frames = 3;
+    int  c, rows, eco, num = 0, num_fail = 0;
+
+    sprintf(fname_yuv, "%s/sink_synth_%dx%d.yuv", op_work_dir, op_w, op_h);
+    sprintf(fname_bs, "%s/sink.evc", op_work_dir);
+    sprintf(fname_sink, "%s/sink_rows.evc", op_work_dir);
+
+    if(synth_write(fname_yuv, op_w, op_h, frames))
+    {
+        logv0("ERROR: cannot write synthetic clip (%s)\n", fname_yuv);
+        return 1;
+    }
+
+    for(c = 0; c < (int)(sizeof(cfgs) / sizeof(cfgs[0])); c++)
+    {
+        for(rows = 0; rows <= 1; rows++)
+        {
+            for(eco = 0; eco <= 1; eco++)
+            {
+                sprintf(args, "--config \"%s/%s\" -i \"%s\" -w %d -h %d -d 8 -z 30 -f %d -q 37 "
+                        "--slice_ctu_rows %d --eco_thread %d -v 0",
+                        op_cfg_dir, cfgs[c], fname_yuv, op_w, op_h, frames, rows, eco);
+                sprintf(cmd, "\"%s/eveya_encoder\" %s -o \"%s\"", op_bin_dir, args, fname_bs);
+                if(run_cmd(cmd))
+                {
+                    logv0("ERROR: encoding failed: %s\n", cmd);
+                    num_fail++;
+                    continue;
+                }
+                sprintf(cmd, "\"%s/eveya_encoder\" %s --nal_sink 2 -o \"%s\"", op_bin_dir, args, fname_sink);
+                if(run_cmd(cmd) || !file_same_from(fname_bs, 0, fname_sink))
+                {
+                    logv0("ERROR: the NAL sink chunks do not give the bitstream: %s\n", cmd);
+                    num_fail++;
+                }
+                num++;
+            }
+        }
+    }
+    remove(fname_sink);
+    remove(fname_bs);
+    remove(fname_yuv);
+
+    logv1("NAL sink check: %d of %d encoding(s) failed\n", num_fail, num);
+    return num_fail;
+}
+
+/* returns the number of regressions against the baseline */
+static int compare_baseline(void)
+{
+    BENCH_ENTRY * cur, * base;
+    double        delta;
+    int           i, num_reg = 0, num_changed = 0;
+
+    logv1_line("Comparison against baseline");
+    for(i = 0; i < report.num; i++)
+    {
+        cur = &report.ent[i];
+        base = report_find(&baseline, cur->key);
+        if(base == NULL) continue;
+
+        if(key_has_suffix(cur->key, "fps"))
+        {
+            delta = base->val > 0 ? (cur->val - base->val) * 100.0 / base->val : 0;
+            logv1("%-32s %10.3f -> %10.3f %+7.2f %%%s\n", cur->key, base->val, cur->val, delta,
+                  delta < -op_tolerance ? "  REGRESSION" : "");
+            if(delta < -op_tolerance) num_reg++;
+        }
+        else if(key_has_suffix(cur->key, "_ms") || key_has_suffix(cur->key, "peak_rss_kb") ||
+                strstr(cur->key, ".mem_"))
+        {
+            delta = base->val > 0 ? (cur->val - base->val) * 100.0 / base->val : 0;
+            logv2("%-32s %10.3f -> %10.3f %+7.2f %%\n", cur->key, base->val, cur->val, delta);
+        }
+        else if(cur->val != base->val)
+        {
+            /* bitstream size and quality are expected to stay the same */
+            logv1("%-32s %10.3f -> %10.3f  CHANGED\n", cur->key, base->val, cur->val);
+            num_changed++;
+        }
+    }
+    logv1("%d regression(s) over %d %%, %d changed output value(s)\n", num_reg, op_tolerance, num_changed);
+    return num_reg;
+}
+
+int main(int argc, const char ** argv)
+{
+    char         fname_synth[MAX_PATH_LEN];
+    const char * p;
+    int          i, ret, num_fail = 0;
+
+    /* parse options */
+    ret = evey_args_parse_all(argc, argv, options);
+    if(ret != 0)
+    {
+        if(ret > 0) logv0("-%c argument should be set\n", ret);
+        print_usage();
+        return -1;
+    }
+
+    if(!op_flag[OP_FLAG_BIN_DIR])
+    {
+        /* the apps are built next to this program */
+        p = strrchr(argv[0], '/');
+        if(p == NULL) p = strrchr(argv[0], '\\');
+        if(p == NULL)
+        {
+            strcpy(op_bin_dir, ".");
+        }
+        else
+        {
+            int len = (int)(p - argv[0]);
+            if(len > (int)sizeof(op_bin_dir) - 1) len = (int)sizeof(op_bin_dir) - 1;
+            memcpy(op_bin_dir, argv[0], len);
+            op_bin_dir[len] = '\0';
+        }
+    }
+
+    if(op_flag[OP_FLAG_FNAME_BASE])
+    {
+        if(report_load(&baseline, op_fname_base, ""))
+        {
+            logv0("ERROR: cannot read baseline report (%s)\n", op_fname_base);
+            return -1;
+        }
+    }
+
+    if(op_check_seek)
+    {
+        return check_seek() ? 1 : 0;
+    }
+    if(op_check_nal_sink)
+    {
+        return check_nal_sink() ? 1 : 0;
+    }
+
+    sprintf(fname_synth, "%s/bench_synth_%dx%d.yuv", op_work_dir, op_w, op_h);
+    if(synth_write(fname_synth, op_w, op_h, op_frames))
+    {
+        logv0("ERROR: cannot write synthetic clip (%s)\n", fname_synth);
+        return -1;
+    }
+
+    logv1_line(NULL);
+    logv1("%-8s %-4s %10s %10s %10s %10s %10s %8s\n", "content", "cfg", "enc fps", "dec fps",
+          "enc MiB", "dec MiB", "bytes", "PSNR Y");
+    logv1_line(NULL);
+
+    for(i = 0; i < NUM_PRESET; i++)
+    {
+        if(strcmp(op_preset, "all") && strcmp(op_preset, presets[i].name)) continue;
+
+        if(run_preset("synth", fname_synth, 8, &presets[i])) num_fail++;
+        if(op_flag[OP_FLAG_FNAME_INP])
+        {
+            if(run_preset("sample", op_fname_inp, op_in_bit_depth, &presets[i])) num_fail++;
+        }
+    }
+    remove(fname_synth);
+
+    if(report_write(&report, op_fname_out))
+    {
+        logv0("ERROR: cannot write report (%s)\n", op_fname_out);
+        return -1;
+    }
+    logv1("report written to %s\n", op_fname_out);
+
+    if(op_flag[OP_FLAG_FNAME_BASE])
+    {
+        num_fail += compare_baseline();
+    }
+
+    return num_fail ? 1 : 0;
+}
@@ -38,7 +38,6 @@
 #define VERBOSE_FRAME              VERBOSE_1
 #define VERBOSE_ALL                VERBOSE_2
 
-#define MAX_BS_BUF                (16*1024*1024) /* byte */
 
 static char op_fname_inp[256] = "\0";
 static char op_fname_out[256] = "\0";
@@ -118,61 +117,6 @@ static void print_usage(void)
     }
 }
 
-static int read_nalu(FILE * fp, int * pos, unsigned char * bs_buf)
-{
-    int read_size, bs_size;
-    unsigned char b = 0;
-
-    bs_size = 0;
-    read_size = 0;
-
-    if (!fseek(fp, *pos, SEEK_SET))
-    {
-        /* read size first */
-        if (4 == fread(&bs_size, 1, 4, fp))
-        {
-            if (bs_size <= 0)
-            {
-                logv0("Invalid bitstream size![%d]\n", bs_size);
-                return -1;
-            }
-
-            while (bs_size)
-            {
-                /* read byte */
-                if (1 != fread(&b, 1, 1, fp))
-                {
-                    logv0("Cannot read bitstream!\n");
-                    return -1;
-                }
-                bs_buf[read_size] = b;
-                read_size++;
-                bs_size--;
-            }
-        }
-        else
-        {
-            if(feof(fp))
-            {
-                logv2("End of file\n");
-            }
-            else
-            {
-                logv0("Cannot read bitstream size!\n");
-            }
-
-            return -1;
-        }
-    }
-    else
-    {
-        logv0("Cannot seek bitstream!\n");
-        return -1;
-    }
-
-    return read_size;
-}
-
 int print_stat(EVEYD_STAT * stat, int ret)
 {
     char stype;
@@ -270,18 +214,17 @@ static int set_extra_config(EVEYD id)
 int main(int argc, const char **argv)
 {
     unsigned char * bs_buf = NULL;
+    BS_SRC          bs_src;
     EVEYD           id = NULL;
     EVEYD_CDSC      cdsc;
     EVEY_BITB       bitb;
     /*temporal buffer for video bit depth less than 10bit */
     EVEY_IMGB     * imgb_t = NULL;
     int             ret;
-    int             bs_size, bs_read_pos = 0;
-    FILE          * fp_bs = NULL;
+    int             bs_size;
     FILE          * fp_bs_write = NULL;
     int             bs_num, max_bs_num;
     u8              tmp_size[4];
-    int             bs_end_pos;
     int             intra_dist[2];
     int             intra_dist_idx = 0;
     EVEYD_BSR     * bsr;
@@ -301,25 +244,17 @@ int main(int argc, const char **argv)
 
     for (bs_num = 0; bs_num < max_bs_num; bs_num++)
     {
-        fp_bs = fopen(argv[bs_num + 1], "rb");
-        if (fp_bs == NULL)
+        if (bs_src_open(&bs_src, argv[bs_num + 1]))
         {
-            logv0("ERROR: cannot open bitstream file = %s\n", op_fname_inp);
+            logv0("ERROR: cannot open bitstream file = %s\n", argv[bs_num + 1]);
             print_usage();
             return -1;
         }
 
-        fseek(fp_bs, 0, SEEK_END);
-        bs_end_pos = ftell(fp_bs);
         intra_dist_idx = 0;
         if (bs_num) intra_dist[0] += intra_dist[1];
-        
-        bs_buf = malloc(MAX_BS_BUF);
-        if (bs_buf == NULL)
-        {
-            logv0("ERROR: cannot allocate bit buffer, size=%d\n", MAX_BS_BUF);
-            return -1;
-        }
+
+        memset(&cdsc, 0, sizeof(EVEYD_CDSC));
         id = eveyd_create(&cdsc, NULL);
         if (id == NULL)
         {
@@ -332,11 +267,9 @@ int main(int argc, const char **argv)
             return -1;
         }
 
-        bs_read_pos = 0;
-
         do
         {
-            bs_size = read_nalu(fp_bs, &bs_read_pos, bs_buf);
+            bs_size = bs_src_read_nalu(&bs_src, &bs_buf);
 
             tmp_size[0] = (bs_size & 0x000000ff) >> 0;
             tmp_size[1] = (bs_size & 0x0000ff00) >> 8;
@@ -348,10 +281,9 @@ int main(int argc, const char **argv)
                 logv1("bumping process starting...\n");
                 continue;
             }
-            bs_read_pos += (4 + bs_size);
             bitb.addr = bs_buf;
             bitb.ssize = bs_size;
-            bitb.bsize = MAX_BS_BUF;
+            bitb.bsize = bs_size;
             EVEYD_ID_TO_CTX_RV(id, ctx, EVEY_ERR_INVALID_ARGUMENT);
 
             bsr = &ctx->bs;
@@ -429,12 +361,11 @@ int main(int argc, const char **argv)
                     }
                     break;
             }
-        }while (bs_read_pos < bs_end_pos);
+        }while (bs_size > 0);
         
         if (id) eveyd_delete(id);
         if (imgb_t) imgb_free(imgb_t);
-        if (fp_bs) fclose(fp_bs);
-        if (bs_buf) free(bs_buf);
+        bs_src_close(&bs_src);
     }
 
     if (fp_bs_write) fclose(fp_bs_write);
@@ -36,8 +36,6 @@
 #define VERBOSE_FRAME              VERBOSE_1
 #define VERBOSE_ALL                VERBOSE_2
 
-#define MAX_BS_BUF                 (16*1024*1024) /* in byte */
-
 static char op_fname_inp[256] = "\0";
 static char op_fname_out[256] = "\0";
 static char op_fname_opl[256] = "\0";
@@ -45,6 +43,14 @@ static int  op_max_frm_num = 0;
 static int  op_use_pic_signature = 0;
 static int  op_out_bit_depth = 0;
 static int  op_out_chroma_format = 1;
+static char op_isa[16] = "auto";
+static char op_fname_bench[256] = "\0";
+static char op_fname_index[256] = "\0";
+static int  op_seek_frame = 0;
+static int  op_segment = 0;
+static int  op_list_segments = 0;
+static int  op_segment_threads = 0;
+static int  op_recon_threads = 0;
 
 typedef enum _STATES
 {
@@ -62,6 +68,14 @@ typedef enum _OP_FLAGS
     OP_FLAG_USE_PIC_SIGN,
     OP_FLAG_OUT_BIT_DEPTH,
     OP_FLAG_VERBOSE,
+    OP_FLAG_ISA,
+    OP_FLAG_FNAME_BENCH,
+    OP_FLAG_FNAME_INDEX,
+    OP_FLAG_SEEK_FRAME,
+    OP_FLAG_SEGMENT,
+    OP_FLAG_LIST_SEGMENTS,
+    OP_FLAG_SEGMENT_THREADS,
+    OP_FLAG_RECON_THREADS,
     OP_FLAG_MAX
 
 } OP_FLAGS;
@@ -73,7 +87,7 @@ static EVEY_ARGS_OPTION options[] = \
     {
         'i', "input", EVEY_ARGS_VAL_TYPE_STRING|EVEY_ARGS_VAL_TYPE_MANDATORY,
         &op_flag[OP_FLAG_FNAME_INP], op_fname_inp,
-        "file name of input bitstream"
+        "file name of input bitstream (\"-\" for stdin)"
     },
     {
         'o', "output", EVEY_ARGS_VAL_TYPE_STRING,
@@ -108,6 +122,55 @@ static EVEY_ARGS_OPTION options[] = \
         &op_flag[OP_FLAG_OUT_BIT_DEPTH], &op_out_bit_depth,
         "output bitdepth (8(default), 10) "
     },
+    {
+        EVEY_ARGS_NO_KEY,  "isa", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_ISA], op_isa,
+        "instruction set of kernels: auto(default), c, sse4, avx2, avx512;\n\t lowered to the highest level with kernels (sse4) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "bench_json", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_BENCH], op_fname_bench,
+        "file name of benchmark report in JSON (time per stage, fps, peak memory) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "index", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_INDEX], op_fname_index,
+        "file name of bitstream index written by the encoder "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "seek_frame", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_SEEK_FRAME], &op_seek_frame,
+        "start decoding at the last IDR picture before the given frame, in\n"
+        "\t output order from the start of the bitstream, and output the frames\n"
+        "\t from it (needs index) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "segment", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_SEGMENT], &op_segment,
+        "decode only the given segment of the bitstream, from an IDR picture\n"
+        "\t to the next one (needs index and closed GOPs) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "list_segments", EVEY_ARGS_VAL_TYPE_NONE,
+        &op_flag[OP_FLAG_LIST_SEGMENTS], &op_list_segments,
+        "print the segments of the bitstream and exit (needs index) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "segment_threads", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_SEGMENT_THREADS], &op_segment_threads,
+        "number of threads decoding the segments of the bitstream from IDR\n"
+        "\t pictures concurrently, each with its own decoder; needs closed GOPs\n"
+        "\t and a bitstream file, and uses the index if it is given\n"
+        "\t 0,1: serial decoding (default) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "recon_threads", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_RECON_THREADS], &op_recon_threads,
+        "number of threads reconstructing the CTU rows of each slice in\n"
+        "\t wavefront order while the main thread parses it; deblocking\n"
+        "\t follows the rows for pictures of one slice\n"
+        "\t 0: parse and reconstruct on the main thread (default) "
+    },
     { 0, "", EVEY_ARGS_VAL_TYPE_NONE, NULL, NULL, ""} /* termination */
 };
 
@@ -126,61 +189,6 @@ static void print_usage(void)
     }
 }
 
-static int read_nalu(FILE * fp, int * pos, unsigned char * bs_buf)
-{
-    int read_size, bs_size;
-    unsigned char b = 0;
-
-    bs_size = 0;
-    read_size = 0;
-
-    if(!fseek(fp, *pos, SEEK_SET))
-    {
-        /* read size first */
-        if(4 == fread(&bs_size, 1, 4, fp)) //@TBC(Chernyak): is it ok from endianness perspective?
-        {
-            if(bs_size <= 0)
-            {
-                logv0("Invalid bitstream size![%d]\n", bs_size);
-                return -1;
-            }
-
-            while(bs_size)
-            {
-                /* read byte */
-                if (1 != fread(&b, 1, 1, fp))
-                {
-                    logv0("Cannot read bitstream!\n");
-                    return -1;
-                }
-                bs_buf[read_size] = b;
-                read_size++;
-                bs_size--;
-            }
-        }
-        else
-        {
-            if(feof(fp))
-            {
-                logv2("End of file\n");
-            }
-            else
-            {
-                logv0("Cannot read bitstream size!\n");
-            }
-
-            return -1;
-        }
-    }
-    else
-    {
-        logv0("Cannot seek bitstream!\n");
-        return -1;
-    }
-
-    return read_size;
-}
-
 static void print_stat(EVEYD_STAT * stat, int ret)
 {
     int i, j;
@@ -269,17 +277,534 @@ static int set_extra_config(EVEYD id)
     return 0;
 }
 
-static int write_dec_img(EVEYD id, char * fname, EVEY_IMGB * img, EVEY_IMGB * imgb_t)
+/* names of EVEYD_STAGE_XXX in the benchmark report */
+static const char * stage_names[EVEYD_STAGE_NUM] =
+{
+    "eco", "recon", "dbk", "picman"
+};
+
+static void print_stage(long long * stage_ns, long long dec_ns, long long io_ns, long long wall_ns)
+{
+    long long others;
+
+    others = dec_ns - stage_ns[EVEYD_STAGE_ECO] - stage_ns[EVEYD_STAGE_RECON]
+        - stage_ns[EVEYD_STAGE_DBK] - stage_ns[EVEYD_STAGE_PICMAN];
+
+    logv1("Wall time per stage:\n");
+    print_stage_time("total", 0, wall_ns, wall_ns);
+    print_stage_time("decoder", 1, dec_ns, wall_ns);
+    print_stage_time("entropy decoding", 2, stage_ns[EVEYD_STAGE_ECO], wall_ns);
+    print_stage_time("reconstruction", 2, stage_ns[EVEYD_STAGE_RECON], wall_ns);
+    print_stage_time("deblocking", 2, stage_ns[EVEYD_STAGE_DBK], wall_ns);
+    print_stage_time("picture manage", 2, stage_ns[EVEYD_STAGE_PICMAN], wall_ns);
+    print_stage_time("others", 2, others, wall_ns);
+    print_stage_time("I/O", 1, io_ns, wall_ns);
+    print_stage_time("application", 1, wall_ns - dec_ns - io_ns, wall_ns);
+}
+
+static void print_stats(EVEYD id)
+{
+    EVEYD_STATS stats;
+    int         i, size = sizeof(stats);
+
+    if(EVEY_FAILED(eveyd_config(id, EVEYD_CFG_GET_STATS, &stats, &size))) return;
+
+    logv2("Decoder counters:\n");
+    for(i = 0; i < EVEYD_STATS_CU_DEPTH_NUM; i++)
+    {
+        if(stats.cu_cnt[i]) logv2("  CUs decoded at depth %d        = %lld\n", i, stats.cu_cnt[i]);
+    }
+    for(i = 0; i < EVEYD_STATS_IPD_NUM; i++)
+    {
+        logv2("  intra CUs of mode %d           = %lld\n", i, stats.intra_cu_cnt[i]);
+    }
+    logv2("  inter CUs                     = %lld\n", stats.inter_cu_cnt);
+    logv2("  skip CUs                      = %lld\n", stats.skip_cu_cnt);
+    logv2("  deblocked edges (4 samples)   = %lld\n", stats.dbk_edge_cnt);
+    print_mem_stats();
+}
+
+static int write_bench(long long * stage_ns, long long dec_ns, long long io_ns, long long wall_ns,
+                       int frames, int nalus)
+{
+    BENCH_JSON js;
+    char       key[64];
+    int        i;
+
+    if(bench_json_open(&js, op_fname_bench)) return -1;
+    bench_json_put(&js, "frames", frames);
+    bench_json_put(&js, "nalus", nalus);
+    bench_json_put(&js, "fps", wall_ns > 0 ? frames * 1e9 / wall_ns : 0);
+    bench_json_put(&js, "total_ms", wall_ns / 1e6);
+    bench_json_put(&js, "decode_ms", dec_ns / 1e6);
+    for(i = 0; i < EVEYD_STAGE_NUM; i++)
+    {
+        sprintf(key, "%s_ms", stage_names[i]);
+        bench_json_put(&js, key, stage_ns[i] / 1e6);
+    }
+    bench_json_put(&js, "io_ms", io_ns / 1e6);
+    bench_json_put(&js, "peak_rss_kb", (double)peak_rss_kb());
+    bench_json_put_mem(&js);
+    bench_json_close(&js);
+    return 0;
+}
+
+/* part of the bitstream to decode, given by the index options; *skip gets
+   the number of pictures decoded before the one to output first */
+static int set_index_range(BS_SRC * src, int * skip)
+{
+    BS_INDEX idx;
+    int    * seg_beg = NULL;
+    int      i, num, first = 0, ret = -1;
+    long long end;
+
+    *skip = 0;
+    if(bs_index_load(&idx, op_fname_index))
+    {
+        logv0("ERROR: cannot read bitstream index file = %s\n", op_fname_index);
+        return -1;
+    }
+    seg_beg = (int *)malloc(sizeof(int) * (idx.num + 1));
+    if(seg_beg == NULL) goto END;
+    num = bs_index_segments(&idx, seg_beg, idx.num + 1);
+
+    if(op_flag[OP_FLAG_LIST_SEGMENTS])
+    {
+        for(i = 0; i < num; i++)
+        {
+            end = i + 1 < num ? idx.rec[seg_beg[i + 1]].offset : idx.rec[idx.num - 1].offset + 4 + idx.rec[idx.num - 1].size;
+            logv0("segment %d: offset %lld, %lld bytes, frame %d\n", i, idx.rec[seg_beg[i]].offset,
+                  end - idx.rec[seg_beg[i]].offset, idx.rec[seg_beg[i]].frame);
+        }
+        ret = 0;
+    }
+    else if(op_flag[OP_FLAG_SEGMENT])
+    {
+        if(op_segment < 0 || op_segment >= num)
+        {
+            logv0("ERROR: no segment %d in the bitstream (%d segments)\n", op_segment, num);
+            goto END;
+        }
+        end = op_segment + 1 < num ? idx.rec[seg_beg[op_segment + 1]].offset : 0;
+        ret = bs_src_range(src, idx.rec[seg_beg[op_segment]].offset, end);
+    }
+    else if(op_flag[OP_FLAG_SEEK_FRAME])
+    {
+        i = bs_index_seek_idr(&idx, op_seek_frame, &first);
+        if(i < 0)
+        {
+            logv0("ERROR: no frame %d after an IDR picture in the bitstream\n", op_seek_frame);
+            goto END;
+        }
+        /* the pictures from an IDR picture are all coded, so the ones
+           before the frame come first in output order */
+        *skip = op_seek_frame - first;
+        ret = bs_src_range(src, idx.rec[i].offset, 0);
+    }
+    else
+    {
+        ret = 0;
+    }
+    if(ret)
+    {
+        logv0("ERROR: cannot seek in the bitstream\n");
+    }
+
+END:
+    free(seg_beg);
+    bs_index_free(&idx);
+    return ret;
+}
+
+static int write_dec_img(WRITER * wr, EVEY_IMGB * img, EVEY_IMGB * imgb_t)
 {
     imgb_cpy(imgb_t, img);
-    if(imgb_write(op_fname_out, imgb_t)) return -1;
+    if(imgb_write(wr, imgb_t)) return -1;
     return EVEY_OK;
 }
 
+static int write_opl(EVEYD_OPL * opl, int w, int h)
+{
+    FILE * fp_opl;
+    int    i, j;
+
+    fp_opl = fopen(op_fname_opl, "a");
+    if(fp_opl == NULL) return -1;
+
+    fprintf(fp_opl, "%d %d %d ", opl->poc, w, h);
+    for(i = 0; i < 3; ++i) /* number of compononets */
+    {
+        for(j = 0; j < 16; ++j)
+        {
+            unsigned int byte = (unsigned char)opl->digest[i][j];
+            fprintf(fp_opl, "%02x", byte);
+        }
+        fprintf(fp_opl, " ");
+    }
+    fprintf(fp_opl, "\n");
+    fclose(fp_opl);
+    return 0;
+}
+
+/* parallel decoding of a closed-GOP bitstream: the segments starting at
+   IDR pictures are decoded by a pool of threads, each segment by its own
+   decoder, and their pictures are written in order by the main thread.
+   the threads run at most SEG_AHEAD segments per thread ahead of the
+   output, which bounds the memory of the pictures waiting to be written */
+#define SEG_AHEAD                  2
+
+typedef struct _SEG_PIC
+{
+    EVEY_IMGB       * imgb;
+    EVEYD_OPL         opl;
+    struct _SEG_PIC * next;
+
+} SEG_PIC;
+
+typedef struct _SEG
+{
+    /* part of the bitstream, end 0 for the end of the bitstream */
+    long long         beg;
+    long long         end;
+    /* decoded pictures in output order */
+    SEG_PIC         * pic;
+    SEG_PIC        ** pic_tail;
+    int               pic_cnt;
+    int               nalu_cnt;
+    long long         stage_ns[EVEYD_STAGE_NUM];
+    long long         dec_ns;
+    /* status of the last NAL unit, or the error */
+    int               ret;
+    int               done;
+
+} SEG;
+
+typedef struct _SEG_POOL
+{
+    SEG             * seg;
+    int               num;
+    EVEYD_CDSC      * cdsc;
+    /* next segment to decode and next segment to write */
+    int               next;
+    int               out;
+    int               ahead;
+    int               stop;
+    APP_LOCK          lock;
+    APP_COND          cond;
+
+} SEG_POOL;
+
+static void seg_pic_free(SEG * seg)
+{
+    SEG_PIC * pic;
+
+    while(seg->pic)
+    {
+        pic = seg->pic;
+        seg->pic = pic->next;
+        imgb_free(pic->imgb);
+        free(pic);
+    }
+    seg->pic_tail = &seg->pic;
+}
+
+/* keep a copy of a decoded picture, in the output bit depth if it is given */
+static int seg_pic_add(SEG * seg, EVEY_IMGB * imgb, EVEYD_OPL * opl)
+{
+    SEG_PIC * pic;
+    int       bd;
+
+    pic = (SEG_PIC *)malloc(sizeof(SEG_PIC));
+    if(pic == NULL) return -1;
+    bd = op_flag[OP_FLAG_OUT_BIT_DEPTH] ? op_out_bit_depth : EVEY_CS_GET_BIT_DEPTH(imgb->cs);
+    pic->imgb = imgb_alloc(imgb->w[0], imgb->h[0], EVEY_CS_SET(EVEY_CS_GET_FORMAT(imgb->cs), bd, 0));
+    if(pic->imgb == NULL)
+    {
+        free(pic);
+        return -1;
+    }
+    imgb_cpy(pic->imgb, imgb);
+    pic->opl = *opl;
+    pic->next = NULL;
+    *seg->pic_tail = pic;
+    seg->pic_tail = &pic->next;
+    seg->pic_cnt++;
+    return 0;
+}
+
+static int seg_decode(SEG_POOL * pool, BS_SRC * src, SEG * seg)
+{
+    EVEYD           id;
+    EVEY_BITB       bitb;
+    EVEY_IMGB     * imgb;
+    EVEYD_STAT      stat;
+    EVEYD_OPL       opl;
+    unsigned char * bs_buf = NULL;
+    int             bs_size, ret, bumping = 0, status = EVEY_OK, i;
+    long long       t0;
+
+    id = eveyd_create(pool->cdsc, NULL);
+    if(id == NULL) return EVEY_ERR;
+    if(set_extra_config(id) || bs_src_range(src, seg->beg, seg->end))
+    {
+        ret = EVEY_ERR;
+        goto END;
+    }
+
+    while(1)
+    {
+        memset(&stat, 0, sizeof(EVEYD_STAT));
+        if(!bumping)
+        {
+            bs_size = bs_src_read_nalu(src, &bs_buf);
+            if(bs_size < 0)
+            {
+                ret = EVEY_ERR;
+                goto END;
+            }
+            if(bs_size == 0)
+            {
+                bumping = 1;
+                continue;
+            }
+            bitb.addr = bs_buf;
+            bitb.ssize = bs_size;
+            bitb.bsize = bs_size;
+
+            t0 = evey_wall_ns();
+            ret = eveyd_decode(id, &bitb, &stat);
+            seg->dec_ns += evey_wall_ns() - t0;
+            if(EVEY_FAILED(ret)) goto END;
+            for(i = 0; i < EVEYD_STAGE_NUM; i++)
+            {
+                seg->stage_ns[i] += stat.stage_ns[i];
+            }
+            seg->nalu_cnt++;
+            status = ret;
+            if(stat.fnum < 0) continue;
+        }
+
+        t0 = evey_wall_ns();
+        ret = eveyd_pull(id, &imgb, &opl);
+        seg->dec_ns += evey_wall_ns() - t0;
+        if(ret == EVEY_ERR_UNEXPECTED && bumping)
+        {
+            ret = status;
+            break;
+        }
+        if(EVEY_FAILED(ret)) goto END;
+        if(imgb)
+        {
+            ret = seg_pic_add(seg, imgb, &opl);
+            imgb->release(imgb);
+            if(ret)
+            {
+                ret = EVEY_ERR_OUT_OF_MEMORY;
+                goto END;
+            }
+        }
+    }
+
+END:
+    eveyd_delete(id);
+    return ret;
+}
+
+static void seg_run(void * arg)
+{
+    SEG_POOL * pool = (SEG_POOL *)arg;
+    BS_SRC     src;
+    int        s, ret, opened;
+
+    /* each thread reads the bitstream through its own source */
+    opened = !bs_src_open(&src, op_fname_inp);
+
+    while(1)
+    {
+        app_lock(&pool->lock);
+        while(!pool->stop && pool->next < pool->num && pool->next >= pool->out + pool->ahead)
+        {
+            app_cond_wait(&pool->cond, &pool->lock);
+        }
+        if(pool->stop || pool->next >= pool->num)
+        {
+            app_unlock(&pool->lock);
+            break;
+        }
+        s = pool->next++;
+        app_unlock(&pool->lock);
+
+        ret = opened ? seg_decode(pool, &src, &pool->seg[s]) : EVEY_ERR;
+
+        app_lock(&pool->lock);
+        pool->seg[s].ret = ret;
+        pool->seg[s].done = 1;
+        app_cond_broadcast(&pool->cond);
+        app_unlock(&pool->lock);
+    }
+    if(opened) bs_src_close(&src);
+}
+
+/* offsets of the segments of the bitstream, from the index if there is
+   one; returns their number, or -1 on error */
+static int get_segments(BS_SRC * src, long long ** seg_off)
+{
+    BS_INDEX idx;
+    int    * seg_beg;
+    int      i, num;
+
+    if(!op_flag[OP_FLAG_FNAME_INDEX]) return bs_src_segments(src, seg_off);
+
+    *seg_off = NULL;
+    if(bs_index_load(&idx, op_fname_index)) return -1;
+    seg_beg = (int *)malloc(sizeof(int) * (idx.num + 1));
+    *seg_off = (long long *)malloc(sizeof(long long) * (idx.num + 1));
+    if(seg_beg == NULL || *seg_off == NULL)
+    {
+        num = -1;
+        goto END;
+    }
+    num = bs_index_segments(&idx, seg_beg, idx.num + 1);
+    for(i = 0; i < num; i++)
+    {
+        (*seg_off)[i] = i == 0 ? 0 : idx.rec[seg_beg[i]].offset;
+    }
+
+END:
+    if(num < 0)
+    {
+        free(*seg_off);
+        *seg_off = NULL;
+    }
+    free(seg_beg);
+    bs_index_free(&idx);
+    return num;
+}
+
+/* decode the bitstream with op_segment_threads threads; returns the status
+   of the last NAL unit like the serial decoding, or -1 on error */
+static int dec_segments(BS_SRC * src, EVEYD_CDSC * cdsc, WRITER * wr, int * pic_cnt, int * nalu_cnt,
+                        int * w, int * h, long long * stage_ns, long long * dec_ns, long long * io_ns)
+{
+    SEG_POOL     pool;
+    APP_THREAD * th = NULL;
+    SEG_PIC    * pic;
+    SEG        * seg;
+    long long  * seg_off = NULL;
+    long long    t0;
+    int          i, k, num, th_num = 0, ret = -1, status = EVEY_OK;
+
+    memset(&pool, 0, sizeof(SEG_POOL));
+    num = get_segments(src, &seg_off);
+    if(num <= 0)
+    {
+        logv0("ERROR: cannot find the segments of the bitstream\n");
+        return -1;
+    }
+    pool.seg = (SEG *)calloc(num, sizeof(SEG));
+    th = (APP_THREAD *)malloc(sizeof(APP_THREAD) * op_segment_threads);
+    if(pool.seg == NULL || th == NULL) goto END;
+    for(i = 0; i < num; i++)
+    {
+        pool.seg[i].beg = seg_off[i];
+        pool.seg[i].end = i + 1 < num ? seg_off[i + 1] : 0;
+        pool.seg[i].pic_tail = &pool.seg[i].pic;
+    }
+    pool.num = num;
+    pool.cdsc = cdsc;
+    pool.ahead = SEG_AHEAD * op_segment_threads;
+    app_lock_init(&pool.lock);
+    app_cond_init(&pool.cond);
+    logv1("%d segments decoded by %d threads\n", num, op_segment_threads);
+
+    for(th_num = 0; th_num < op_segment_threads && th_num < num; th_num++)
+    {
+        if(app_thread_create(&th[th_num], seg_run, &pool)) break;
+    }
+    if(th_num == 0)
+    {
+        logv0("ERROR: cannot create decoding threads\n");
+        goto STOP;
+    }
+
+    for(i = 0; i < num; i++)
+    {
+        seg = &pool.seg[i];
+        app_lock(&pool.lock);
+        while(!seg->done) app_cond_wait(&pool.cond, &pool.lock);
+        app_unlock(&pool.lock);
+
+        if(EVEY_FAILED(seg->ret))
+        {
+            logv0("failed to decode segment %d (error %d)\n", i, seg->ret);
+            goto STOP;
+        }
+        logv1("segment %d: %d NALUs, %d frames\n", i, seg->nalu_cnt, seg->pic_cnt);
+
+        t0 = evey_wall_ns();
+        for(pic = seg->pic; pic; pic = pic->next)
+        {
+            *w = pic->imgb->w[0];
+            *h = pic->imgb->h[0];
+            if(op_flag[OP_FLAG_FNAME_OUT] && imgb_write(wr, pic->imgb))
+            {
+                logv0("cannot write decoded file\n");
+                goto STOP;
+            }
+            if(op_flag[OP_FLAG_FNAME_OPL] && write_opl(&pic->opl, *w, *h))
+            {
+                logv0("ERROR: cannot create an opl file\n");
+                goto STOP;
+            }
+        }
+        *io_ns += evey_wall_ns() - t0;
+
+        *pic_cnt += seg->pic_cnt;
+        *nalu_cnt += seg->nalu_cnt;
+        *dec_ns += seg->dec_ns;
+        for(k = 0; k < EVEYD_STAGE_NUM; k++)
+        {
+            stage_ns[k] += seg->stage_ns[k];
+        }
+        status = seg->ret;
+        seg_pic_free(seg);
+
+        app_lock(&pool.lock);
+        pool.out = i + 1;
+        app_cond_broadcast(&pool.cond);
+        app_unlock(&pool.lock);
+    }
+    ret = status;
+
+STOP:
+    app_lock(&pool.lock);
+    pool.stop = 1;
+    app_cond_broadcast(&pool.cond);
+    app_unlock(&pool.lock);
+    for(i = 0; i < th_num; i++)
+    {
+        app_thread_join(th[i]);
+    }
+    for(i = 0; i < num; i++)
+    {
+        seg_pic_free(&pool.seg[i]);
+    }
+    app_cond_deinit(&pool.cond);
+    app_lock_deinit(&pool.lock);
+
+END:
+    free(th);
+    free(pool.seg);
+    free(seg_off);
+    return ret;
+}
+
 int main(int argc, const char **argv)
 {
     STATES             state = STATE_DECODING;
     unsigned char    * bs_buf = NULL;
+    BS_SRC             bs_src;
+    WRITER             wr_out;
     EVEYD              id = NULL;
     EVEYD_CDSC         cdsc;
     EVEY_BITB          bitb;
@@ -291,9 +816,11 @@ int main(int argc, const char **argv)
     int               ret;
     EVEY_CLK           clk_beg, clk_tot;
     int                bs_cnt, pic_cnt;
-    int                bs_size, bs_read_pos = 0;
+    long long          stage_ns[EVEYD_STAGE_NUM] = {0};
+    long long          wall_beg, wall_ns, dec_ns, io_ns, t0;
+    int                bs_size;
     int                w, h;
-    FILE             * fp_bs = NULL;
+    int                skip_cnt = 0;
        
     clk_beg = evey_clk_get();
 
@@ -307,26 +834,60 @@ int main(int argc, const char **argv)
     }
 
     /* open input bitstream */
-    fp_bs = fopen(op_fname_inp, "rb");
-    if(fp_bs == NULL)
+    if(bs_src_open(&bs_src, op_fname_inp))
     {
         logv0("ERROR: cannot open bitstream file = %s\n", op_fname_inp);
         print_usage();
         return -1;
     }
 
+    if(op_flag[OP_FLAG_SEEK_FRAME] + op_flag[OP_FLAG_SEGMENT] + op_flag[OP_FLAG_LIST_SEGMENTS] > 0)
+    {
+        if(!op_flag[OP_FLAG_FNAME_INDEX] || op_flag[OP_FLAG_SEEK_FRAME] + op_flag[OP_FLAG_SEGMENT] > 1)
+        {
+            logv0("ERROR: seek_frame, segment and list_segments need an index, and seek_frame and segment cannot be combined\n");
+            print_usage();
+            return -1;
+        }
+        if(set_index_range(&bs_src, &skip_cnt))
+        {
+            return -1;
+        }
+        if(op_flag[OP_FLAG_LIST_SEGMENTS])
+        {
+            bs_src_close(&bs_src);
+            return 0;
+        }
+    }
+
+    if(op_segment_threads > 1 && (op_flag[OP_FLAG_SEEK_FRAME] || op_flag[OP_FLAG_SEGMENT] || !strcmp(op_fname_inp, "-")))
+    {
+        logv0("ERROR: segment_threads needs a bitstream file, and cannot be combined with seek_frame and segment\n");
+        print_usage();
+        return -1;
+    }
+
+    pic_cnt = 0;
+    clk_tot = 0;
+    bs_cnt  = 0;
+    w = h   = 0;
+    dec_ns  = 0;
+    io_ns   = 0;
+    wall_beg = evey_wall_ns();
+
+    int process_status = EVEY_OK;
+
+    /* from here on, the errors go through END to flush the decoded file */
+    memset(&wr_out, 0, sizeof(WRITER));
     if(op_flag[OP_FLAG_FNAME_OUT])
     {
-        /* remove decoded file contents if exists */
-        FILE * fp;
-        fp = fopen(op_fname_out, "wb");
-        if(fp == NULL)
+        if(writer_open(&wr_out, op_fname_out))
         {
             logv0("ERROR: cannot create a decoded file\n");
             print_usage();
-            return -1;
+            process_status = -1;
+            goto END;
         }
-        fclose(fp);
     }
 
     if (op_flag[OP_FLAG_FNAME_OPL])
@@ -338,43 +899,52 @@ int main(int argc, const char **argv)
         {
             logv0("ERROR: cannot create an opl file\n");
             print_usage();
-            return -1;
+            process_status = -1;
+            goto END;
         }
         fclose(fp);
     }
 
-    bs_buf = malloc(MAX_BS_BUF);
-    if(bs_buf == NULL)
+    memset(&cdsc, 0, sizeof(EVEYD_CDSC));
+    cdsc.recon_threads = op_recon_threads;
+    cdsc.isa = isa_parse(op_isa);
+    if(cdsc.isa < 0)
     {
-        logv0("ERROR: cannot allocate bit buffer, size=%d\n", MAX_BS_BUF);
-        return -1;
+        logv0("ERROR: unknown instruction set: %s\n", op_isa);
+        print_usage();
+        process_status = -1;
+        goto END;
     }
+
+    if(op_segment_threads > 1)
+    {
+        process_status = dec_segments(&bs_src, &cdsc, &wr_out, &pic_cnt, &bs_cnt, &w, &h, stage_ns, &dec_ns, &io_ns);
+        goto END;
+    }
+
     id = eveyd_create(&cdsc, NULL);
     if(id == NULL)
     {
         logv0("ERROR: cannot create EVEY decoder\n");
-        return -1;
+        process_status = -1;
+        goto END;
     }
     if(set_extra_config(id))
     {
         logv0("ERROR: cannot set extra configurations\n");
-        return -1;
+        process_status = -1;
+        goto END;
     }
 
-    pic_cnt = 0;
-    clk_tot = 0;
-    bs_cnt  = 0;
-    w = h   = 0;
-
-    int process_status = EVEY_OK;
-
     while(1)
     {
         if (state == STATE_DECODING)
         {
             memset(&stat, 0, sizeof(EVEYD_STAT));
 
-            bs_size = read_nalu(fp_bs, &bs_read_pos, bs_buf);
+            t0 = evey_wall_ns();
+            bs_size = bs_src_read_nalu(&bs_src, &bs_buf);
+            io_ns += evey_wall_ns() - t0;
             int nalu_size_field_in_bytes = 4;
 
             if (bs_size <= 0)
@@ -384,22 +954,28 @@ int main(int argc, const char **argv)
                 continue;
             }
 
-            bs_read_pos += (nalu_size_field_in_bytes + bs_size);
             stat.read += nalu_size_field_in_bytes;
             bitb.addr = bs_buf;
             bitb.ssize = bs_size;
-            bitb.bsize = MAX_BS_BUF;
+            bitb.bsize = bs_size;
 
-            logv1("[%4d] NALU --> ", bs_cnt++);
+            logv1("[%4d] NALU --> ", bs_cnt);
+            bs_cnt++;
 
             /* main decoding block */
+            t0 = evey_wall_ns();
             ret = eveyd_decode(id, &bitb, &stat);
+            dec_ns += evey_wall_ns() - t0;
 
             if(EVEY_FAILED(ret))
             {
                 logv0("failed to decode bitstream\n");
                 goto END;
             }
+            for(int i = 0; i < EVEYD_STAGE_NUM; i++)
+            {
+                stage_ns[i] += stat.stage_ns[i];
+            }
 
             print_stat(&stat, ret);
 
@@ -414,7 +990,9 @@ int main(int argc, const char **argv)
 
         if(stat.fnum >= 0 || state == STATE_BUMPING)
         {
+            t0 = evey_wall_ns();
             ret = eveyd_pull(id, &imgb, &opl);
+            dec_ns += evey_wall_ns() - t0;
             if(ret == EVEY_ERR_UNEXPECTED)
             {
                 logv1("bumping process completed\n");
@@ -423,7 +1001,8 @@ int main(int argc, const char **argv)
             else if(EVEY_FAILED(ret))
             {
                 logv0("failed to pull the decoded image\n");
-                return -1;
+                process_status = -1;
+                goto END;
             }
         }
         else
@@ -437,8 +1016,14 @@ int main(int argc, const char **argv)
             h = imgb->h[0];
 
             op_out_bit_depth = op_out_bit_depth == 0 ? EVEY_CS_GET_BIT_DEPTH(imgb->cs) : op_out_bit_depth;
+            t0 = evey_wall_ns();
 
-            if(op_flag[OP_FLAG_FNAME_OUT])
+            if(skip_cnt > 0)
+            {
+                /* decoded only as reference of the pictures to output */
+                skip_cnt--;
+            }
+            else if(op_flag[OP_FLAG_FNAME_OUT])
             {
                 if(imgb_t == NULL)
                 {
@@ -448,38 +1033,33 @@ int main(int argc, const char **argv)
                     if(imgb_t == NULL)
                     {
                         logv0("failed to allocate temporay image buffer\n");
-                        return -1;
+                        imgb->release(imgb);
+                        process_status = -1;
+                        goto END;
                     }
                 }
 
-                write_dec_img(id, op_fname_out, imgb, imgb_t);
+                if(write_dec_img(&wr_out, imgb, imgb_t))
+                {
+                    logv0("cannot write decoded image\n");
+                    imgb->release(imgb);
+                    process_status = -1;
+                    goto END;
+                }
             }
 
             if (op_flag[OP_FLAG_FNAME_OPL])
             {
-                FILE* fp_opl = fopen(op_fname_opl, "a");
-                if (fp_opl == NULL)
+                if (write_opl(&opl, w, h))
                 {
                     logv0("ERROR: cannot create an opl file\n");
                     print_usage();
-                    return -1;
+                    imgb->release(imgb);
+                    process_status = -1;
+                    goto END;
                 }
-
-                fprintf(fp_opl, "%d %d %d ", opl.poc, w, h);
-                for (int i = 0; i < 3; ++i) /* number of compononets */
-                {
-                    for (int j = 0; j < 16; ++j)
-                    {
-                        unsigned int byte = (unsigned char) opl.digest[i][j];
-                        fprintf(fp_opl, "%02x", byte);
-                    }
-                    fprintf(fp_opl, " ");
-                }
-
-                fprintf(fp_opl, "\n");
-
-                fclose(fp_opl);
             }
+            io_ns += evey_wall_ns() - t0;
 
             imgb->release(imgb);
             pic_cnt++;
@@ -509,11 +1089,28 @@ END:
                 ((float)pic_cnt*1000)/((float)evey_clk_msec(clk_tot)));
     }
     logv1("=======================================================================================\n");
+    wall_ns = evey_wall_ns() - wall_beg;
+    /* the decoding time of the segments adds up over the threads */
+    if(id) print_stage(stage_ns, dec_ns, io_ns, wall_ns);
+    if(id) print_stats(id);
+    logv1("=======================================================================================\n");
+
+    if(op_flag[OP_FLAG_FNAME_BENCH])
+    {
+        if(write_bench(stage_ns, dec_ns, io_ns, wall_ns, pic_cnt, bs_cnt))
+        {
+            logv0("cannot write benchmark report (%s)\n", op_fname_bench);
+        }
+    }
 
     if(id) eveyd_delete(id);
     if(imgb_t) imgb_free(imgb_t);
-    if(fp_bs) fclose(fp_bs);
-    if(bs_buf) free(bs_buf);
+    bs_src_close(&bs_src);
+    if(writer_close(&wr_out))
+    {
+        logv0("cannot write decoded file\n");
+        process_status = -1;
+    }
 
     return process_status;
 }
@@ -43,8 +43,7 @@
 typedef enum _STATES
 {
     STATE_ENCODING,
-    STATE_BUMPING,
-    STATE_SKIPPING
+    STATE_BUMPING
 
 } STATES;
 
@@ -94,6 +93,14 @@ static int  op_picture_crop_bottom_offset         = 0;
 static int  op_rdo_dbk_switch                     = 1;
 static int  op_use_rdoq                           = 1;
 static int  op_nn_base_port                       = 0;
+static char op_isa[16]                            = "auto";
+static int  op_complexity                         = 0;
+static int  op_eco_thread                         = 0;
+static int  op_quality_metric                     = 0;
+static int  op_nal_sink                           = 0;
+static int  op_slice_ctu_rows                     = 0;
+static char op_fname_index[256]                   = "\0"; /* bitstream index */
+static char op_fname_bench[256]                   = "\0"; /* benchmark report */
 
 typedef enum _OP_FLAGS
 {
@@ -142,6 +149,14 @@ typedef enum _OP_FLAGS
     OP_PIC_CROP_BOTTOM,
     OP_FLAG_RDO_DBK_SWITCH,
     OP_FLAG_USE_RDOQ,
+    OP_FLAG_ISA,
+    OP_FLAG_FNAME_BENCH,
+    OP_FLAG_COMPLEXITY,
+    OP_FLAG_ECO_THREAD,
+    OP_FLAG_QUALITY_METRIC,
+    OP_FLAG_NAL_SINK,
+    OP_FLAG_SLICE_CTU_ROWS,
+    OP_FLAG_FNAME_INDEX,
     OP_FLAG_MAX,
     OP_NN_BASE_PORT
 
@@ -159,7 +174,7 @@ static EVEY_ARGS_OPTION options[] = \
     {
         'i', "input", EVEY_ARGS_VAL_TYPE_STRING|EVEY_ARGS_VAL_TYPE_MANDATORY,
         &op_flag[OP_FLAG_FNAME_INP], op_fname_inp,
-        "file name of input video"
+        "file name of input video (\"-\" for standard input)"
     },
     {
         'o', "output", EVEY_ARGS_VAL_TYPE_STRING,
@@ -389,6 +404,60 @@ static EVEY_ARGS_OPTION options[] = \
         &op_flag[OP_NN_BASE_PORT], &op_nn_base_port,
         "base port at 127.0.0.1 where the NN server is listening (0(default) means no server is listening) "
     },
+    {
+        EVEY_ARGS_NO_KEY,  "isa", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_ISA], op_isa,
+        "instruction set of kernels: auto(default), c, sse4, avx2, avx512;\n\t lowered to the highest level with kernels (sse4) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "bench_json", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_BENCH], op_fname_bench,
+        "file name of benchmark report in JSON (time per stage, fps, peak memory) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "complexity", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_COMPLEXITY], &op_complexity,
+        "complexity level\n"
+        "\t 0: RDO counts the rate by running the arithmetic coder (default)\n"
+        "\t 1: RDO estimates the fractional rate from the context states\n"
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "eco_thread", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_ECO_THREAD], &op_eco_thread,
+        "run entropy coding on a second thread, pipelined with mode decision (0(default), 1) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "quality_metric", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_QUALITY_METRIC], &op_quality_metric,
+        "quality metrics computed by the encoder on a helper thread instead of the\n"
+        "\t PSNR of this application, sum of\n"
+        "\t 1: PSNR\n"
+        "\t 2: SSIM\n"
+        "\t 4: MS-SSIM of luma\n"
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "nal_sink", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_NAL_SINK], &op_nal_sink,
+        "write each NAL unit to the bitstream file as soon as the encoder\n"
+        "\t completes it, instead of the whole picture after encoding\n"
+        "\t 0: disabled (default)\n"
+        "\t 1: one call per NAL unit\n"
+        "\t 2: the slice data in chunks of CTU rows, put back together\n"
+        "\t    and checked before writing "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "slice_ctu_rows", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_SLICE_CTU_ROWS], &op_slice_ctu_rows,
+        "CTU rows of each slice; with nal_sink, a slice is written as soon as\n"
+        "\t it is coded (0(default): one slice per picture) "
+    },
+    {
+        EVEY_ARGS_NO_KEY,  "index", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_INDEX], op_fname_index,
+        "file name of bitstream index, with the offset, size, POC, frame number,\n"
+        "\t slice type, temporal ID and IDR flag of each NAL unit, for seeking\n"
+        "\t and splitting the bitstream in the decoder "
+    },
     {0, "", EVEY_ARGS_VAL_TYPE_NONE, NULL, NULL, ""} /* termination */
 };
 
@@ -481,6 +550,10 @@ static int get_conf(EVEYE_CDSC * cdsc)
     cdsc->rdo_dbk_switch = op_rdo_dbk_switch;
     cdsc->use_rdoq = op_use_rdoq;
     cdsc->nn_base_port = op_nn_base_port;
+    cdsc->isa = isa_parse(op_isa);
+    cdsc->eco_thread = op_eco_thread;
+    cdsc->quality_metric = op_quality_metric;
+    cdsc->slice_ctu_rows = op_slice_ctu_rows;
     cdsc->chroma_qp_table_present_flag = op_chroma_qp_table_present_flag;
     if (cdsc->chroma_qp_table_present_flag)
     {
@@ -571,6 +644,14 @@ int check_conf(EVEYE_CDSC * cdsc)
     {
         logv0("Current encoder does not support picture height, not multiple of max(8, minimum CU size)\n"); success = 0;
     }
+    if(cdsc->isa < 0)
+    {
+        logv0("unknown instruction set: %s\n", op_isa); success = 0;
+    }
+    if(op_nal_sink < 0 || op_nal_sink > 2)
+    {
+        logv0("nal_sink should be 0, 1 or 2\n"); success = 0;
+    }
 
     return success;
 }
@@ -590,6 +671,31 @@ static int set_extra_config(EVEYE id)
             return -1;
         }
     }
+    /* the original image list outlives the encoding of its pictures when
+       the PSNR is computed here; frames of another bit depth are left to
+       the copy, as the PSNR expects them unchanged */
+    if(op_in_bit_depth == op_codec_bit_depth && !op_quality_metric)
+    {
+        value = 1;
+        size = 4;
+        ret = eveye_config(id, EVEYE_CFG_SET_INPUT_REF, &value, &size);
+        if(EVEY_FAILED(ret))
+        {
+            logv0("failed to set config for input reference\n");
+            return -1;
+        }
+    }
+    if(op_flag[OP_FLAG_COMPLEXITY])
+    {
+        value = op_complexity;
+        size = 4;
+        ret = eveye_config(id, EVEYE_CFG_SET_COMPLEXITY, &value, &size);
+        if(EVEY_FAILED(ret))
+        {
+            logv0("failed to set config for complexity\n");
+            return -1;
+        }
+    }
     return 0;
 }
 
@@ -607,6 +713,10 @@ static void print_stat_init(void)
     {
         logv1("  Output YUV file         : %s \n", op_fname_rec);
     }
+    if(op_flag[OP_FLAG_FNAME_INDEX])
+    {
+        logv1("  Output bitstream index  : %s \n", op_fname_index);
+    }
     logv1("---------------------------------------------------------------------------------------\n");
     logv1("POC   Tid   Ftype   QP   PSNR-Y    PSNR-U    PSNR-V    Bits      EncT(ms)  ");
     logv1("Ref. List\n");
@@ -643,9 +753,17 @@ static void print_config(EVEYE id)
     logv1("\tGOP type                 = %s\n", v? "closed": "open");
     eveye_config(id, EVEYE_CFG_GET_HIERARCHICAL_GOP, (void *)(&v), &s);
     logv1("\thierarchical GOP         = %s\n", v? "enabled": "disabled");
+    eveye_config(id, EVEYE_CFG_GET_ISA, (void *)(&v), &s);
+    logv1("\tkernel instruction set   = %s\n", isa_names[v]);
+    eveye_config(id, EVEYE_CFG_GET_COMPLEXITY, (void *)(&v), &s);
+    logv1("\tcomplexity level         = %d\n", v);
+    logv1("\tentropy coding thread    = %s\n", op_eco_thread? "enabled": "disabled");
+    logv1("\tquality metrics          = %d\n", op_quality_metric);
+    logv1("\tNAL sink                 = %s\n", op_nal_sink == 2? "CTU rows": op_nal_sink? "NAL units": "disabled");
+    logv1("\tCTU rows of slice        = %d\n", op_slice_ctu_rows);
 }
 
-static int write_rec(IMGB_LIST * list, EVEY_MTIME * ts)
+static int write_rec(WRITER * wr, IMGB_LIST * list, EVEY_MTIME * ts)
 {
     int i;
 
@@ -655,7 +773,7 @@ static int write_rec(IMGB_LIST * list, EVEY_MTIME * ts)
         {
             if(op_flag[OP_FLAG_FNAME_REC])
             {
-                if(imgb_write(op_fname_rec, list[i].imgb))
+                if(imgb_write(wr, list[i].imgb))
                 {
                     logv0("cannot write reconstruction image\n");
                     return -1;
@@ -669,6 +787,88 @@ static int write_rec(IMGB_LIST * list, EVEY_MTIME * ts)
     return 0;
 }
 
+/* names of EVEYE_STAGE_XXX in the benchmark report */
+static const char * stage_names[EVEYE_STAGE_NUM] =
+{
+    "mode", "intra", "inter", "me", "nn", "eco", "dbk", "picman"
+};
+
+static void print_stage(long long * stage_ns, long long enc_ns, long long io_ns, long long wall_ns)
+{
+    long long others;
+
+    others = enc_ns - stage_ns[EVEYE_STAGE_MODE] - stage_ns[EVEYE_STAGE_ECO]
+        - stage_ns[EVEYE_STAGE_DBK] - stage_ns[EVEYE_STAGE_PICMAN];
+
+    logv1("Wall time per stage:\n");
+    print_stage_time("total", 0, wall_ns, wall_ns);
+    print_stage_time("encoder", 1, enc_ns, wall_ns);
+    print_stage_time("mode decision", 2, stage_ns[EVEYE_STAGE_MODE], wall_ns);
+    print_stage_time("intra RDO", 3, stage_ns[EVEYE_STAGE_INTRA], wall_ns);
+    print_stage_time("NN wait", 4, stage_ns[EVEYE_STAGE_NN], wall_ns);
+    print_stage_time("inter RDO", 3, stage_ns[EVEYE_STAGE_INTER], wall_ns);
+    print_stage_time("ME", 4, stage_ns[EVEYE_STAGE_ME], wall_ns);
+    print_stage_time("entropy coding", 2, stage_ns[EVEYE_STAGE_ECO], wall_ns);
+    print_stage_time("deblocking", 2, stage_ns[EVEYE_STAGE_DBK], wall_ns);
+    print_stage_time("picture manage", 2, stage_ns[EVEYE_STAGE_PICMAN], wall_ns);
+    print_stage_time("others", 2, others, wall_ns);
+    print_stage_time("I/O", 1, io_ns, wall_ns);
+    print_stage_time("application", 1, wall_ns - enc_ns - io_ns, wall_ns);
+}
+
+static void print_stats(EVEYE id)
+{
+    EVEYE_STATS stats;
+    int         i, size = sizeof(stats);
+
+    if(EVEY_FAILED(eveye_config(id, EVEYE_CFG_GET_STATS, &stats, &size))) return;
+
+    logv2("Encoder counters:\n");
+    for(i = 0; i < EVEYE_STATS_CU_DEPTH_NUM; i++)
+    {
+        if(stats.cu_cnt[i]) logv2("  CUs evaluated at depth %d      = %lld\n", i, stats.cu_cnt[i]);
+    }
+    for(i = 0; i < EVEYE_STATS_IPD_NUM; i++)
+    {
+        logv2("  RDO of intra mode %d           = %lld\n", i, stats.intra_rdo_cnt[i]);
+    }
+    logv2("  motion searches               = %lld\n", stats.me_cnt);
+    logv2("  ME points per search          = %.1f\n", stats.me_cnt ? (double)stats.me_pts / stats.me_cnt : 0);
+    logv2("  SBAC rate estimations         = %lld\n", stats.sbac_est_cnt);
+    logv2("  SBAC estimated bits           = %lld\n", stats.sbac_est_bits);
+    logv2("  deblocked edges (4 samples)   = %lld\n", stats.dbk_edge_cnt);
+    print_mem_stats();
+}
+
+static int write_bench(long long * stage_ns, long long enc_ns, long long io_ns, long long wall_ns,
+                       int frames, double bytes, double bitrate, double * psnr)
+{
+    BENCH_JSON js;
+    char       key[64];
+    int        i;
+
+    if(bench_json_open(&js, op_fname_bench)) return -1;
+    bench_json_put(&js, "frames", frames);
+    bench_json_put(&js, "fps", wall_ns > 0 ? frames * 1e9 / wall_ns : 0);
+    bench_json_put(&js, "total_ms", wall_ns / 1e6);
+    bench_json_put(&js, "encode_ms", enc_ns / 1e6);
+    for(i = 0; i < EVEYE_STAGE_NUM; i++)
+    {
+        sprintf(key, "%s_ms", stage_names[i]);
+        bench_json_put(&js, key, stage_ns[i] / 1e6);
+    }
+    bench_json_put(&js, "io_ms", io_ns / 1e6);
+    bench_json_put(&js, "peak_rss_kb", (double)peak_rss_kb());
+    bench_json_put_mem(&js);
+    bench_json_put(&js, "bytes", bytes);
+    bench_json_put(&js, "bitrate_kbps", bitrate);
+    bench_json_put(&js, "psnr_y", psnr[0]);
+    bench_json_put(&js, "psnr_u", psnr[1]);
+    bench_json_put(&js, "psnr_v", psnr[2]);
+    bench_json_close(&js);
+    return 0;
+}
+
 void print_psnr(EVEYE_STAT * stat, double * psnr, int bitrate, EVEY_CLK clk_end)
 {
     char  stype;
@@ -710,6 +910,78 @@ void print_psnr(EVEYE_STAT * stat, double * psnr, int bitrate, EVEY_CLK clk_end)
     fflush(stderr);
 }
 
+/* print the line of a picture with the metrics computed by the encoder and
+   add them to the averages */
+static void print_qm(EVEYE_STAT * stat, EVEYE_QM * qm, int bitrate, EVEY_CLK clk_end,
+                     double psnr_avg[3], double ssim_avg[4])
+{
+    int i;
+
+    print_psnr(stat, qm->psnr, bitrate, clk_end);
+    for(i = 0; i < 3; i++)
+    {
+        psnr_avg[i] += qm->psnr[i];
+        ssim_avg[i] += qm->ssim[i];
+    }
+    ssim_avg[3] += qm->ms_ssim;
+}
+
+/* NAL units given to the NAL sink in chunks; the size field comes first
+   in the bitstream, so the chunks are kept until the NAL unit ends */
+typedef struct _NAL_SINK_BUF
+{
+    WRITER              * wr;
+    unsigned char       * buf;
+    int                   size;
+    int                   max;
+    /* the next chunk of the NAL unit follows the last one */
+    const unsigned char * next;
+    int                   nalu_type;
+} NAL_SINK_BUF;
+
+/* NAL sink writing each NAL unit with its size field, as it is in the
+   bitstream buffer */
+static int nal_sink_write(void * opaque, const unsigned char * data, int size,
+                          int nalu_type, int flag)
+{
+    NAL_SINK_BUF  * nb = (NAL_SINK_BUF *)opaque;
+    unsigned char * buf;
+
+    if(flag == (EVEYE_NAL_BEGIN | EVEYE_NAL_END))
+    {
+        return writer_write(nb->wr, &size, 4) || writer_write(nb->wr, data, size) ? -1 : 0;
+    }
+
+    if((flag & EVEYE_NAL_BEGIN) != (nb->next == NULL) ||
+       (nb->next != NULL && (data != nb->next || nalu_type != nb->nalu_type)))
+    {
+        logv0("NAL sink: chunk of %d bytes does not follow the NAL unit\n", size);
+        return -1;
+    }
+    if(nb->size + size > nb->max)
+    {
+        buf = (unsigned char *)realloc(nb->buf, nb->size + size);
+        if(buf == NULL) return -1;
+        nb->buf = buf;
+        nb->max = nb->size + size;
+    }
+    memcpy(nb->buf + nb->size, data, size);
+    nb->size += size;
+    nb->next = data + size;
+    nb->nalu_type = nalu_type;
+
+    if(flag & EVEYE_NAL_END)
+    {
+        if(writer_write(nb->wr, &nb->size, 4) || writer_write(nb->wr, nb->buf, nb->size))
+        {
+            return -1;
+        }
+        nb->size = 0;
+        nb->next = NULL;
+    }
+    return 0;
+}
+
 int setup_bumping(EVEYE id)
 {
     int val, size;
@@ -730,8 +1002,12 @@ int main(int argc, const char **argv)
 {
     STATES          state = STATE_ENCODING;
     unsigned char * bs_buf = NULL;
-    FILE          * fp_inp = NULL;
-    EVEYE           id;
+    YUV_SRC         src_inp;
+    WRITER          wr_bs, wr_rec;
+    NAL_SINK_BUF    nal_buf;
+    FILE          * fp_index = NULL;
+    long long       bs_pos = 0;
+    EVEYE           id = NULL;
     EVEYE_CDSC      cdsc;
     EVEY_BITB       bitb;
     EVEY_IMGB     * imgb_enc = NULL;
@@ -739,14 +1015,22 @@ int main(int argc, const char **argv)
     EVEYE_STAT      stat;
     int             i, ret, size;
     EVEY_CLK        clk_beg, clk_end, clk_tot;
-    EVEY_MTIME      pic_icnt, pic_ocnt, pic_skip;
+    EVEY_MTIME      pic_icnt, pic_ocnt;
     double          bitrate;
     double          psnr[3] = { 0, };
     double          psnr_avg[3] = { 0, };
+    double          ssim_avg[4] = { 0, };
+    EVEYE_STAT      stat_qm;
+    EVEYE_QM        qm;
+    EVEY_CLK        clk_qm = 0;
+    int             bits, bits_qm = 0, qm_pend = 0;
     IMGB_LIST       ilist_org[MAX_BUMP_FRM_CNT];
     IMGB_LIST       ilist_rec[MAX_BUMP_FRM_CNT];
     IMGB_LIST     * ilist_t = NULL;
     static int      is_first_enc = 1;
+    long long       stage_ns[EVEYE_STAGE_NUM] = {0};
+    long long       wall_beg, wall_ns, enc_ns, io_ns, t0;
+    double          bytes;
 
     /* parse options */
     ret = evey_args_parse_all(argc, argv, options);
@@ -758,39 +1042,41 @@ int main(int argc, const char **argv)
         return -1;
     }
 
+    memset(&wr_bs, 0, sizeof(WRITER));
+    memset(&wr_rec, 0, sizeof(WRITER));
+    memset(&src_inp, 0, sizeof(YUV_SRC));
+    memset(&nal_buf, 0, sizeof(NAL_SINK_BUF));
+    memset(ilist_org, 0, sizeof(ilist_org));
+    memset(ilist_rec, 0, sizeof(ilist_rec));
     if(op_flag[OP_FLAG_FNAME_OUT])
     {
-        /* bitstream file - remove contents and close */
-        FILE * fp;
-        fp = fopen(op_fname_out, "wb");
-        if(fp == NULL)
+        if(writer_open(&wr_bs, op_fname_out))
         {
             logv0("cannot open bitstream file (%s)\n", op_fname_out);
-            return -1;
+            ret = -1;
+            goto ERR;
         }
-        fclose(fp);
     }
 
     if(op_flag[OP_FLAG_FNAME_REC])
     {
-        /* reconstruction file - remove contents and close */
-        FILE * fp;
-        fp = fopen(op_fname_rec, "wb");
-        if(fp == NULL)
+        if(writer_open(&wr_rec, op_fname_rec))
         {
             logv0("cannot open reconstruction file (%s)\n", op_fname_rec);
-            return -1;
+            ret = -1;
+            goto ERR;
         }
-        fclose(fp);
     }
 
-    /* open original file */
-    fp_inp = fopen(op_fname_inp, "rb");
-    if(fp_inp == NULL)
+    if(op_flag[OP_FLAG_FNAME_INDEX])
     {
-        logv0("cannot open original file (%s)\n", op_fname_inp);
-        print_usage();
-        return -1;
+        fp_index = bs_index_create(op_fname_index);
+        if(fp_index == NULL)
+        {
+            logv0("cannot open bitstream index file (%s)\n", op_fname_index);
+            ret = -1;
+            goto ERR;
+        }
     }
 
     /* allocate bitstream buffer */
@@ -798,7 +1084,8 @@ int main(int argc, const char **argv)
     if(bs_buf == NULL)
     {
         logv0("cannot allocate bitstream buffer, size=%d", MAX_BS_BUF);
-        return -1;
+        ret = -1;
+        goto ERR;
     }
 
     /* read configurations and set values for create descriptor */
@@ -810,13 +1097,15 @@ int main(int argc, const char **argv)
         {
             logv0("Number of tiles should be equal or more than number of slices\n");
             print_usage();
-            return -1;
+            ret = -1;
+            goto ERR;
         }
         if(val == -2)
         {
             logv0("for DRA internal bit depth should be 10\n");
             print_usage();
-            return -1;
+            ret = -1;
+            goto ERR;
         }
     }
 
@@ -826,7 +1115,8 @@ int main(int argc, const char **argv)
     if (!check_conf(&cdsc))
     {
         logv0("invalid configuration\n");
-        return -1;
+        ret = -1;
+        goto ERR;
     }
 
     /* create encoder */
@@ -834,25 +1124,56 @@ int main(int argc, const char **argv)
     if(id == NULL)
     {
         logv0("cannot create EVEY encoder\n");
-        return -1;
+        ret = -1;
+        goto ERR;
     }
 
     if(set_extra_config(id))
     {
         logv0("cannot set extra configurations\n");
-        return -1;
+        ret = -1;
+        goto ERR;
+    }
+
+    if(op_nal_sink && op_flag[OP_FLAG_FNAME_OUT])
+    {
+        EVEYE_NAL_SINK sink;
+
+        nal_buf.wr = &wr_bs;
+        sink.fn_sink = nal_sink_write;
+        sink.opaque = &nal_buf;
+        sink.row = op_nal_sink == 2;
+        size = sizeof(EVEYE_NAL_SINK);
+        ret = eveye_config(id, EVEYE_CFG_SET_NAL_SINK, &sink, &size);
+        if(EVEY_FAILED(ret))
+        {
+            logv0("failed to set config for NAL sink\n");
+            ret = -1;
+            goto ERR;
+        }
     }
 
     /* create image lists */
     if(imgb_list_alloc(ilist_org, cdsc.w, cdsc.h, op_in_bit_depth, op_chroma_format_idc))
     {
         logv0("cannot allocate image list for original image\n");
-        return -1;
+        ret = -1;
+        goto ERR;
     }
     if(imgb_list_alloc(ilist_rec, cdsc.w, cdsc.h, op_out_bit_depth, op_chroma_format_idc))
     {
         logv0("cannot allocate image list for reconstructed image\n");
-        return -1;
+        ret = -1;
+        goto ERR;
+    }
+
+    /* open original file */
+    if(yuv_src_open(&src_inp, op_fname_inp, ilist_org[0].imgb))
+    {
+        logv0("cannot open original file (%s)\n", op_fname_inp);
+        print_usage();
+        ret = -1;
+        goto ERR;
     }
 
     print_config(id);
@@ -863,61 +1184,48 @@ int main(int argc, const char **argv)
     bitb.addr = bs_buf;
     bitb.bsize = MAX_BS_BUF;
 
-    if(op_flag[OP_FLAG_SKIP_FRAMES] && op_skip_frames > 0)
-    {
-        state = STATE_SKIPPING;
-    }
-
     clk_tot = 0;
     pic_icnt = 0;
     pic_ocnt = 0;
-    pic_skip = 0;
+    enc_ns = 0;
+    io_ns = 0;
+    wall_beg = evey_wall_ns();
 
-    /* encode pictures *******************************************************/
-    while(1)
+    if(op_flag[OP_FLAG_SKIP_FRAMES] && op_skip_frames > 0)
     {
-        if(state == STATE_SKIPPING)
+        t0 = evey_wall_ns();
+        if(yuv_src_skip(&src_inp, op_skip_frames))
         {
-            if(pic_skip < op_skip_frames)
-            {
-                ilist_t = imgb_list_get_empty(ilist_org);
-                if(ilist_t == NULL)
-                {
-                    logv0("cannot get empty orignal buffer\n");
-                    goto ERR;
-                }
-                if(imgb_read(fp_inp, ilist_t->imgb))
-                {
-                    logv2("reached end of original file (or reading error)\n");
-                    goto ERR;
-                }
-            }
-            else
-            {
-                state = STATE_ENCODING;
-            }
-
-            pic_skip++;
-            continue;
+            logv2("reached end of original file (or reading error)\n");
+            ret = 0;
+            goto ERR;
         }
+        io_ns += evey_wall_ns() - t0;
+    }
 
+    /* encode pictures *******************************************************/
+    while(1)
+    {
         if(state == STATE_ENCODING)
         {
             ilist_t = imgb_list_get_empty(ilist_org);
             if(ilist_t == NULL)
             {
                 logv0("cannot get empty orignal buffer\n");
-                return -1;
+                ret = -1;
+                goto ERR;
             }
 
             /* read original image */
-            if(pic_icnt >= op_max_frm_num || imgb_read(fp_inp, ilist_t->imgb))
+            t0 = evey_wall_ns();
+            if(pic_icnt >= op_max_frm_num || yuv_src_read(&src_inp, ilist_t->imgb))
             {
                 logv2("reached end of original file (or reading error)\n");
                 state = STATE_BUMPING;
                 setup_bumping(id);
                 continue;
             }
+            io_ns += evey_wall_ns() - t0;
             imgb_list_make_used(ilist_t, pic_icnt);
 
             /* push image to encoder */
@@ -925,21 +1233,30 @@ int main(int argc, const char **argv)
             if(EVEY_FAILED(ret))
             {
                 logv0("eveye_push() failed\n");
-                return -1;
+                ret = -1;
+                goto ERR;
+            }
+            /* the encoder keeps its own copy for the metrics */
+            if(op_quality_metric)
+            {
+                ilist_t->used = 0;
             }
             pic_icnt++;
         }
 
         /* encoding */
         clk_beg = evey_clk_get();
+        t0 = evey_wall_ns();
 
         ret = eveye_encode(id, &bitb, &stat);
         if(EVEY_FAILED(ret))
         {
             logv0("eveye_encode() failed\n");
-            return -1;
+            ret = -1;
+            goto ERR;
         }
 
+        enc_ns += evey_wall_ns() - t0;
         clk_end = evey_clk_from(clk_beg);
         clk_tot += clk_end;
 
@@ -951,14 +1268,22 @@ int main(int argc, const char **argv)
         }
         else if(ret == EVEY_OK)
         {
-            if(op_flag[OP_FLAG_FNAME_OUT] && stat.write > 0)
+            for(i = 0; i < EVEYE_STAGE_NUM; i++)
             {
-                if(write_data(op_fname_out, bs_buf, stat.write))
+                stage_ns[i] += stat.stage_ns[i];
+            }
+
+            t0 = evey_wall_ns();
+            if(op_flag[OP_FLAG_FNAME_OUT] && !op_nal_sink && stat.write > 0)
+            {
+                if(writer_write(&wr_bs, bs_buf, stat.write))
                 {
                     logv0("cannot write bitstream\n");
-                    return -1;
+                    ret = -1;
+                    goto ERR;
                 }
             }
+            io_ns += evey_wall_ns() - t0;
 
             /* get reconstructed image */
             size = sizeof(EVEY_IMGB**);
@@ -966,45 +1291,84 @@ int main(int argc, const char **argv)
             if(EVEY_FAILED(ret))
             {
                 logv0("failed to get reconstruction image\n");
-                return -1;
+                ret = -1;
+                goto ERR;
+            }
+
+            /* the POC is not in output order across IDR pictures, the
+               timestamp of the input picture is */
+            t0 = evey_wall_ns();
+            if(fp_index && stat.write > 0)
+            {
+                if(bs_index_write(fp_index, bs_buf, stat.write, bs_pos, stat.poc, (int)imgb_rec->ts[0], stat.stype))
+                {
+                    logv0("cannot write bitstream index\n");
+                    ret = -1;
+                    goto ERR;
+                }
             }
+            bs_pos += stat.write;
+            io_ns += evey_wall_ns() - t0;
 
             ilist_t = imgb_list_put(ilist_rec, imgb_rec, imgb_rec->ts[0]);
             if(ilist_t == NULL)
             {
                 logv0("cannot put reconstructed image to list\n");
-                return -1;
+                ret = -1;
+                goto ERR;
             }
 
             /* calculate PSNR */
-            if(cal_psnr(ilist_org, ilist_t->imgb, ilist_t->ts, op_in_bit_depth, op_out_bit_depth, op_chroma_format_idc, psnr))
+            if(!op_quality_metric &&
+               cal_psnr(ilist_org, ilist_t->imgb, ilist_t->ts, op_in_bit_depth, op_out_bit_depth, op_chroma_format_idc, psnr))
             {
                 logv0("cannot calculate PSNR\n");
-                return -1;
+                ret = -1;
+                goto ERR;
             }
 
             /* store reconstructed image */
-            if (write_rec(ilist_rec, &pic_ocnt))
+            t0 = evey_wall_ns();
+            if (write_rec(&wr_rec, ilist_rec, &pic_ocnt))
             {
                 logv0("cannot write reconstruction image\n");
-                return -1;
+                ret = -1;
+                goto ERR;
             }
+            io_ns += evey_wall_ns() - t0;
 
             if(is_first_enc)
             {
-                print_psnr(&stat, psnr, (stat.write - stat.sei_size + (int)bitrate) << 3, clk_end);
+                bits = (stat.write - stat.sei_size + (int)bitrate) << 3;
                 is_first_enc = 0;
             }
             else
             {
-                print_psnr(&stat, psnr, (stat.write - stat.sei_size) << 3, clk_end);
+                bits = (stat.write - stat.sei_size) << 3;
             }
 
-            bitrate += (stat.write - stat.sei_size);
-            for(i = 0; i < 3; i++)
+            if(op_quality_metric)
             {
-                psnr_avg[i] += psnr[i];
+                /* the metrics of a picture come with the next one */
+                if(qm_pend)
+                {
+                    print_qm(&stat_qm, &stat.qm, bits_qm, clk_qm, psnr_avg, ssim_avg);
+                }
+                stat_qm = stat;
+                bits_qm = bits;
+                clk_qm = clk_end;
+                qm_pend = 1;
             }
+            else
+            {
+                print_psnr(&stat, psnr, bits, clk_end);
+                for(i = 0; i < 3; i++)
+                {
+                    psnr_avg[i] += psnr[i];
+                }
+            }
+
+            bitrate += (stat.write - stat.sei_size);
 
             /* release recon buffer */
             if (imgb_rec)
@@ -1019,7 +1383,8 @@ int main(int argc, const char **argv)
         else
         {
             logv2("invaild return value (%d)\n", ret);
-            return -1;
+            ret = -1;
+            goto ERR;
         }
 
         if(op_flag[OP_FLAG_MAX_FRM_NUM] && pic_icnt >= op_max_frm_num
@@ -1030,11 +1395,27 @@ int main(int argc, const char **argv)
         }
     }
 
+    if(qm_pend)
+    {
+        size = sizeof(EVEYE_QM);
+        ret = eveye_config(id, EVEYE_CFG_GET_QM, (void *)&qm, &size);
+        if(EVEY_FAILED(ret))
+        {
+            logv0("failed to get quality metrics\n");
+            ret = -1;
+            goto ERR;
+        }
+        print_qm(&stat_qm, &qm, bits_qm, clk_qm, psnr_avg, ssim_avg);
+    }
+
     /* store remained reconstructed pictures in output list */
+    t0 = evey_wall_ns();
     while(pic_icnt - pic_ocnt > 0)
     {
-        write_rec(ilist_rec, &pic_ocnt);
+        write_rec(&wr_rec, ilist_rec, &pic_ocnt);
     }
+    io_ns += evey_wall_ns() - t0;
+    wall_ns = evey_wall_ns() - wall_beg;
     if(pic_icnt != pic_ocnt)
     {
         logv2("number of input(=%d) and output(=%d) is not matched\n", (int)pic_icnt, (int)pic_ocnt);
@@ -1048,8 +1429,19 @@ int main(int argc, const char **argv)
     logv1("  PSNR Y(dB)       : %-5.4f\n", psnr_avg[0]);
     logv1("  PSNR U(dB)       : %-5.4f\n", psnr_avg[1]);
     logv1("  PSNR V(dB)       : %-5.4f\n", psnr_avg[2]);
+    if(op_quality_metric & EVEYE_QM_SSIM)
+    {
+        logv1("  SSIM Y           : %-5.6f\n", ssim_avg[0] / pic_ocnt);
+        logv1("  SSIM U           : %-5.6f\n", ssim_avg[1] / pic_ocnt);
+        logv1("  SSIM V           : %-5.6f\n", ssim_avg[2] / pic_ocnt);
+    }
+    if(op_quality_metric & EVEYE_QM_MS_SSIM)
+    {
+        logv1("  MS-SSIM Y        : %-5.6f\n", ssim_avg[3] / pic_ocnt);
+    }
 
     logv1("  Total bits(bits) : %-.0f\n", bitrate*8);
+    bytes = bitrate;
     bitrate *= (cdsc.fps * 8);
     bitrate /= pic_ocnt;
     bitrate /= 1000;
@@ -1069,19 +1461,49 @@ int main(int argc, const char **argv)
     logv1("Average encoding speed            = %.3f frames/sec\n",
         ((float)pic_ocnt * 1000) / ((float)evey_clk_msec(clk_tot)));
     logv1("====================================================================\n");
+    print_stage(stage_ns, enc_ns, io_ns, wall_ns);
+    print_stats(id);
+    logv1("====================================================================\n");
+
+    if(op_flag[OP_FLAG_FNAME_BENCH])
+    {
+        if(write_bench(stage_ns, enc_ns, io_ns, wall_ns, (int)pic_ocnt, bytes, bitrate, psnr_avg))
+        {
+            logv0("cannot write benchmark report (%s)\n", op_fname_bench);
+        }
+    }
 
     if (pic_ocnt != op_max_frm_num)
     {
         logv2("Wrong frames count: should be %d was %d\n", op_max_frm_num, (int)pic_ocnt);
     }
+    ret = 0;
 
 ERR:
-    eveye_delete(id);
+    /* the bitstream written so far is kept on errors */
+    if(id) eveye_delete(id);
+
+    if(writer_close(&wr_bs))
+    {
+        logv0("cannot write bitstream\n");
+        ret = -1;
+    }
+    if(writer_close(&wr_rec))
+    {
+        logv0("cannot write reconstruction image\n");
+        ret = -1;
+    }
+    if(fp_index && fclose(fp_index))
+    {
+        logv0("cannot write bitstream index\n");
+        ret = -1;
+    }
 
     imgb_list_free(ilist_org);
     imgb_list_free(ilist_rec);
 
-    if(fp_inp) fclose(fp_inp);
+    yuv_src_close(&src_inp);
+    if(nal_buf.buf) free(nal_buf.buf);
     if(bs_buf) free(bs_buf); /* release bitstream buffer */
-    return 0;
+    return ret;
 }
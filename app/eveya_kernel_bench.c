@@ -0,0 +1,813 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Kernel equivalence check and micro-benchmark.
+
+   Every ISA level the CPU supports gets its own copy of the kernel tables
+   (EVEY_KFN/EVEYE_KFN). Each kernel is run on the same random input at every
+   level and the outputs are compared bit by bit against the C level at bit
+   depths 8, 10 and 12. Afterwards each kernel is timed at every level and the
+   cost is reported as time stamp counter ticks per pixel. */
+
+#include "evey.h"
+#include "eveya_util.h"
+#include "eveya_args.h"
+#include "eveye_def.h"
+
+#if X86_SSE
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#define BENCH_STRIDE               (MAX_CU_SIZE + 32)
+#define BENCH_PAD                  (16)
+#define BENCH_PLANE                (BENCH_STRIDE * (MAX_CU_SIZE + 2 * BENCH_PAD))
+#define BENCH_MAX_LEVELS           (EVEY_ISA_AVX512 + 1)
+
+static int  op_trials = 16;
+static int  op_pels = 1 << 21;
+static int  op_seed = 1;
+static int  op_check_only = 0;
+static char op_kernel[32] = "all";
+
+typedef enum _OP_FLAGS
+{
+    OP_FLAG_TRIALS,
+    OP_FLAG_PELS,
+    OP_FLAG_SEED,
+    OP_FLAG_CHECK_ONLY,
+    OP_FLAG_KERNEL,
+    OP_FLAG_VERBOSE,
+    OP_FLAG_MAX
+
+} OP_FLAGS;
+
+static int op_flag[OP_FLAG_MAX] = {0};
+
+static EVEY_ARGS_OPTION options[] = \
+{
+    {
+        't', "trials", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_TRIALS], &op_trials,
+        "number of random inputs checked per kernel, size and bit depth (default: 16)"
+    },
+    {
+        'n', "pels", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_PELS], &op_pels,
+        "number of pixels processed per timing measurement (default: 2097152)"
+    },
+    {
+        EVEY_ARGS_NO_KEY, "seed", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_SEED], &op_seed,
+        "seed of the random input (default: 1)"
+    },
+    {
+        'c', "check_only", EVEY_ARGS_VAL_TYPE_NONE,
+        &op_flag[OP_FLAG_CHECK_ONLY], &op_check_only,
+        "check equivalence only, skip timing"
+    },
+    {
+        'k', "kernel", EVEY_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_KERNEL], op_kernel,
+        "kernel group to run: all(default), sad, ssd, satd, diff, mc_l, mc_c, avg, quant, qm"
+    },
+    {
+        'v', "verbose", EVEY_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_VERBOSE], &op_verbose,
+        "verbose level\n"
+        "\t 0: no message\n"
+        "\t 1: results (default)\n"
+        "\t 2: all messages\n"
+    },
+    { 0, "", EVEY_ARGS_VAL_TYPE_NONE, NULL, NULL, ""} /* termination */
+};
+
+#define NUM_ARG_OPTION   ((int)(sizeof(options)/sizeof(options[0]))-1)
+static void print_usage(void)
+{
+    int i;
+    char str[1024];
+
+    logv0("< Usage >\n");
+
+    for(i=0; i<NUM_ARG_OPTION; i++)
+    {
+        if(evey_args_get_help(options, i, str) < 0) return;
+        logv0("%s\n", str);
+    }
+}
+
+/* kernel tables of a single ISA level */
+typedef struct _BENCH_LEVEL
+{
+    int          isa;
+    EVEY_KFN     kfn;
+    EVEYE_KFN    kfne;
+
+} BENCH_LEVEL;
+
+static BENCH_LEVEL levels[BENCH_MAX_LEVELS];
+static int         num_levels;
+
+/* input and output buffers, shared by all kernels */
+static pel  buf_org[BENCH_PLANE];
+static pel  buf_cur[BENCH_PLANE];
+static pel  buf_out[BENCH_MAX_LEVELS][BENCH_PLANE];
+static s16  buf_coef[BENCH_MAX_LEVELS][MAX_CU_DIM];
+static s16  buf_tmp[BENCH_MAX_LEVELS][MAX_CU_DIM];
+static s32  buf_lev[BENCH_MAX_LEVELS][MAX_CU_DIM];
+
+static int  num_mismatch;
+static volatile s64 sink;
+
+extern const int quant_scale[6];
+
+static void levels_init(void)
+{
+    BENCH_LEVEL * lv;
+
+    lv = &levels[0];
+    lv->isa = EVEY_ISA_C;
+    evey_kfn_init_c(&lv->kfn);
+    eveye_kfn_init_c(&lv->kfne);
+    num_levels = 1;
+
+#if X86_SSE
+    if(evey_isa_max() >= EVEY_ISA_SSE4)
+    {
+        lv = &levels[num_levels++];
+        *lv = levels[0];
+        lv->isa = EVEY_ISA_SSE4;
+        evey_kfn_init_sse(&lv->kfn);
+        eveye_kfn_init_sse(&lv->kfne);
+    }
+#endif
+}
+
+/* kernels may call other table entries (e.g. evey_had), so the globals
+   are switched together with the table under test */
+static void level_set(int lidx)
+{
+    evey_kfn = levels[lidx].kfn;
+    eveye_kfn = levels[lidx].kfne;
+}
+
+static u32 rnd_state;
+
+static u32 rnd(void)
+{
+    /* xorshift32 */
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+static void rnd_fill(pel * buf, int num, int bit_depth)
+{
+    int i, mode = rnd() & 3;
+    int max = (1 << bit_depth) - 1;
+
+    for(i = 0; i < num; i++)
+    {
+        switch(mode)
+        {
+            /* extremes trigger overflows and saturation */
+            case 0: buf[i] = (rnd() & 1) ? max : 0; break;
+            case 1: buf[i] = (pel)((max >> 1) + (int)(rnd() & 7) - 4); break;
+            default: buf[i] = (pel)(rnd() & max); break;
+        }
+    }
+}
+
+static u64 ticks_get(void)
+{
+#if X86_SSE
+    return __rdtsc();
+#else
+    return (u64)evey_clk_get();
+#endif
+}
+
+static int bench_iter(int num_pels)
+{
+    return EVEY_MAX(1, op_pels / num_pels);
+}
+
+static void report_mismatch(const char * name, int w, int h, int bit_depth, int lidx)
+{
+    num_mismatch++;
+    logv0("MISMATCH: %s %dx%d bit_depth=%d isa=%s\n", name, w, h, bit_depth,
+          evey_isa_name(levels[lidx].isa));
+}
+
+static void report_timing(const char * name, int w, int h, double * tpp)
+{
+    char str[256];
+    int  i, len;
+
+    len = sprintf(str, "%-10s %3dx%-3d", name, w, h);
+    for(i = 0; i < num_levels; i++)
+    {
+        len += sprintf(str + len, " %10.3f", tpp[i]);
+    }
+    if(num_levels > 1 && tpp[num_levels - 1] > 0)
+    {
+        sprintf(str + len, " %8.2fx", tpp[0] / tpp[num_levels - 1]);
+    }
+    logv1("%s\n", str);
+}
+
+static int kernel_enabled(const char * name)
+{
+    return !strcmp(op_kernel, "all") || !strcmp(op_kernel, name);
+}
+
+/* pixel pointer inside the padded plane, so that filter taps stay in it */
+#define PLANE_POS(buf)   ((buf) + BENCH_PAD * BENCH_STRIDE + BENCH_PAD)
+
+/*****************************************************************************
+ * distortion kernels: sad, ssd, satd
+ *****************************************************************************/
+typedef s64(*BENCH_FN_DIST)(int lidx, int w, int h, pel * org, pel * cur, int bit_depth);
+
+static s64 dist_sad(int lidx, int w, int h, pel * org, pel * cur, int bit_depth)
+{
+    return levels[lidx].kfne.sad[evey_tbl_log2[w]][evey_tbl_log2[h]](w, h, org, cur, BENCH_STRIDE, BENCH_STRIDE, bit_depth);
+}
+
+static s64 dist_ssd(int lidx, int w, int h, pel * org, pel * cur, int bit_depth)
+{
+    return levels[lidx].kfne.ssd[evey_tbl_log2[w]][evey_tbl_log2[h]](w, h, org, cur, BENCH_STRIDE, BENCH_STRIDE, bit_depth);
+}
+
+static s64 dist_satd(int lidx, int w, int h, pel * org, pel * cur, int bit_depth)
+{
+    return evey_had(w, h, org, cur, BENCH_STRIDE, BENCH_STRIDE, bit_depth);
+}
+
+static void run_dist(const char * name, BENCH_FN_DIST fn, int log2_min)
+{
+    int    log2w, log2h, w, h, bd, t, l, i, iter;
+    s64    ref, res;
+    double tpp[BENCH_MAX_LEVELS];
+    u64    tick;
+
+    for(log2w = log2_min; log2w <= MAX_CU_LOG2; log2w++)
+    {
+        for(log2h = log2_min; log2h <= MAX_CU_LOG2; log2h++)
+        {
+            w = 1 << log2w;
+            h = 1 << log2h;
+            for(bd = 8; bd <= 12; bd += 2)
+            {
+                for(t = 0; t < op_trials; t++)
+                {
+                    rnd_fill(buf_org, BENCH_PLANE, bd);
+                    rnd_fill(buf_cur, BENCH_PLANE, bd);
+                    level_set(0);
+                    ref = fn(0, w, h, PLANE_POS(buf_org), PLANE_POS(buf_cur), bd);
+                    for(l = 1; l < num_levels; l++)
+                    {
+                        level_set(l);
+                        res = fn(l, w, h, PLANE_POS(buf_org), PLANE_POS(buf_cur), bd);
+                        if(res != ref)
+                        {
+                            report_mismatch(name, w, h, bd, l);
+                            break;
+                        }
+                    }
+                }
+            }
+            if(op_check_only || log2w != log2h) continue;
+
+            iter = bench_iter(w * h);
+            for(l = 0; l < num_levels; l++)
+            {
+                level_set(l);
+                tick = ticks_get();
+                for(i = 0; i < iter; i++)
+                {
+                    sink += fn(l, w, h, PLANE_POS(buf_org), PLANE_POS(buf_cur), 10);
+                }
+                tpp[l] = (double)(ticks_get() - tick) / ((double)iter * w * h);
+            }
+            report_timing(name, w, h, tpp);
+        }
+    }
+}
+
+/*****************************************************************************
+ * residual
+ *****************************************************************************/
+static void run_diff(void)
+{
+    int    log2w, log2h, w, h, bd, t, l, i, y, iter;
+    double tpp[BENCH_MAX_LEVELS];
+    u64    tick;
+
+    for(log2w = 1; log2w <= MAX_CU_LOG2; log2w++)
+    {
+        for(log2h = 1; log2h <= MAX_CU_LOG2; log2h++)
+        {
+            w = 1 << log2w;
+            h = 1 << log2h;
+            for(bd = 8; bd <= 12; bd += 2)
+            {
+                for(t = 0; t < op_trials; t++)
+                {
+                    rnd_fill(buf_org, BENCH_PLANE, bd);
+                    rnd_fill(buf_cur, BENCH_PLANE, bd);
+                    for(l = 0; l < num_levels; l++)
+                    {
+                        memset(buf_coef[l], 0, sizeof(buf_coef[l]));
+                        levels[l].kfne.diff[log2w][log2h](w, h, PLANE_POS(buf_org), PLANE_POS(buf_cur),
+                                                          BENCH_STRIDE, BENCH_STRIDE, w, buf_coef[l], bd);
+                    }
+                    for(l = 1; l < num_levels; l++)
+                    {
+                        if(memcmp(buf_coef[0], buf_coef[l], sizeof(s16) * w * h))
+                        {
+                            report_mismatch("diff", w, h, bd, l);
+                            break;
+                        }
+                    }
+                }
+            }
+            if(op_check_only || log2w != log2h) continue;
+
+            iter = bench_iter(w * h);
+            for(l = 0; l < num_levels; l++)
+            {
+                tick = ticks_get();
+                for(i = 0; i < iter; i++)
+                {
+                    levels[l].kfne.diff[log2w][log2h](w, h, PLANE_POS(buf_org), PLANE_POS(buf_cur),
+                                                      BENCH_STRIDE, BENCH_STRIDE, w, buf_coef[l], 10);
+                }
+                tpp[l] = (double)(ticks_get() - tick) / ((double)iter * w * h);
+            }
+            for(y = 0; y < w * h; y++) sink += buf_coef[0][y];
+            report_timing("diff", w, h, tpp);
+        }
+    }
+}
+
+/*****************************************************************************
+ * motion compensation
+ *****************************************************************************/
+static int mc_out_cmp(int l, int w, int h)
+{
+    int y;
+    for(y = 0; y < h; y++)
+    {
+        if(memcmp(buf_out[0] + y * BENCH_STRIDE, buf_out[l] + y * BENCH_STRIDE, sizeof(pel) * w)) return 1;
+    }
+    return 0;
+}
+
+/* chroma: 1/32 pel motion vectors, frac_max = 32 */
+static void run_mc(const char * name, int chroma)
+{
+    static const char * frac_names[2][2] = {{"00", "0n"}, {"n0", "nn"}};
+    const int frac_max = chroma ? 32 : 16;
+    const int frac_step = frac_max >> 2;
+    const int log2_min = chroma ? 1 : 2;
+    const int log2_max = chroma ? MAX_CU_LOG2 - 1 : MAX_CU_LOG2;
+    int       log2s, w, h, bd, t, l, i, fx, fy, ix, iy, iter;
+    int       gmv_x, gmv_y;
+    double    tpp[BENCH_MAX_LEVELS];
+    char      str[32];
+    u64       tick;
+
+    for(log2s = log2_min; log2s <= log2_max; log2s++)
+    {
+        /* square and 2:1 shapes cover both loop orders of the filters */
+        for(h = 1 << log2s; h >= (1 << log2s) >> 1 && h >= (1 << log2_min); h >>= 1)
+        {
+            w = 1 << log2s;
+            for(bd = 8; bd <= 12; bd += 2)
+            {
+                for(t = 0; t < op_trials; t++)
+                {
+                    rnd_fill(buf_cur, BENCH_PLANE, bd);
+                    for(fy = 0; fy < frac_max; fy += frac_step)
+                    {
+                        for(fx = 0; fx < frac_max; fx += frac_step)
+                        {
+                            ix = fx > 0;
+                            iy = fy > 0;
+                            for(l = 0; l < num_levels; l++)
+                            {
+                                memset(buf_out[l], 0, sizeof(pel) * BENCH_STRIDE * h);
+                                if(chroma)
+                                {
+                                    levels[l].kfn.mc_c[ix][iy](PLANE_POS(buf_cur), fx, fy, BENCH_STRIDE, BENCH_STRIDE,
+                                                               buf_out[l], w, h, bd);
+                                }
+                                else
+                                {
+                                    levels[l].kfn.mc_l[ix][iy](PLANE_POS(buf_cur), fx, fy, BENCH_STRIDE, BENCH_STRIDE,
+                                                               buf_out[l], w, h, bd);
+                                }
+                            }
+                            for(l = 1; l < num_levels; l++)
+                            {
+                                if(mc_out_cmp(l, w, h))
+                                {
+                                    sprintf(str, "%s_%s(%d,%d)", name, frac_names[ix][iy], fx, fy);
+                                    report_mismatch(str, w, h, bd, l);
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            if(op_check_only || w != h) continue;
+
+            iter = bench_iter(w * h);
+            for(ix = 0; ix < 2; ix++)
+            {
+                for(iy = 0; iy < 2; iy++)
+                {
+                    gmv_x = ix ? frac_step : 0;
+                    gmv_y = iy ? frac_step : 0;
+                    for(l = 0; l < num_levels; l++)
+                    {
+                        tick = ticks_get();
+                        for(i = 0; i < iter; i++)
+                        {
+                            if(chroma)
+                            {
+                                levels[l].kfn.mc_c[ix][iy](PLANE_POS(buf_cur), gmv_x, gmv_y, BENCH_STRIDE, BENCH_STRIDE,
+                                                           buf_out[l], w, h, 10);
+                            }
+                            else
+                            {
+                                levels[l].kfn.mc_l[ix][iy](PLANE_POS(buf_cur), gmv_x, gmv_y, BENCH_STRIDE, BENCH_STRIDE,
+                                                           buf_out[l], w, h, 10);
+                            }
+                        }
+                        tpp[l] = (double)(ticks_get() - tick) / ((double)iter * w * h);
+                    }
+                    sprintf(str, "%s_%s", name, frac_names[ix][iy]);
+                    report_timing(str, w, h, tpp);
+                }
+            }
+        }
+    }
+}
+
+static void run_avg(void)
+{
+    int    log2w, log2h, w, h, bd, t, l, i, iter;
+    double tpp[BENCH_MAX_LEVELS];
+    u64    tick;
+
+    for(log2w = 1; log2w <= MAX_CU_LOG2; log2w++)
+    {
+        for(log2h = 1; log2h <= MAX_CU_LOG2; log2h++)
+        {
+            w = 1 << log2w;
+            h = 1 << log2h;
+            for(bd = 8; bd <= 12; bd += 2)
+            {
+                for(t = 0; t < op_trials; t++)
+                {
+                    rnd_fill(buf_org, BENCH_PLANE, bd);
+                    rnd_fill(buf_cur, BENCH_PLANE, bd);
+                    for(l = 0; l < num_levels; l++)
+                    {
+                        memset(buf_out[l], 0, sizeof(pel) * BENCH_STRIDE * h);
+                        levels[l].kfn.average_no_clip(buf_org, buf_cur, buf_out[l], BENCH_STRIDE, BENCH_STRIDE,
+                                                      BENCH_STRIDE, w, h, bd);
+                    }
+                    for(l = 1; l < num_levels; l++)
+                    {
+                        if(mc_out_cmp(l, w, h))
+                        {
+                            report_mismatch("avg", w, h, bd, l);
+                            break;
+                        }
+                    }
+                }
+            }
+            if(op_check_only || log2w != log2h || log2w < 2) continue;
+
+            iter = bench_iter(w * h);
+            for(l = 0; l < num_levels; l++)
+            {
+                tick = ticks_get();
+                for(i = 0; i < iter; i++)
+                {
+                    levels[l].kfn.average_no_clip(buf_org, buf_cur, buf_out[l], BENCH_STRIDE, BENCH_STRIDE,
+                                                  BENCH_STRIDE, w, h, 10);
+                }
+                tpp[l] = (double)(ticks_get() - tick) / ((double)iter * w * h);
+            }
+            report_timing("avg", w, h, tpp);
+        }
+    }
+}
+
+/*****************************************************************************
+ * quantization
+ *****************************************************************************/
+static void rnd_fill_coef(s16 * coef, int num)
+{
+    int i, mode = rnd() & 3;
+
+    for(i = 0; i < num; i++)
+    {
+        switch(mode)
+        {
+            case 0: coef[i] = (s16)rnd(); break;
+            case 1: coef[i] = (s16)((int)(rnd() & 63) - 32); break;
+            case 2: coef[i] = (rnd() & 1) ? 32767 : -32768; break;
+            default: coef[i] = (s16)((int)(rnd() % 2001) - 1000); break;
+        }
+    }
+}
+
+/* same derivation of the quantization parameters as eveye_quant_nnz() and
+   eveye_rdoq_run_length_cc(); returns 0 if the combination is not used */
+typedef struct _BENCH_QPARAM
+{
+    int   scale;
+    int   ns_scale;
+    s64   offset;
+    int   shift;
+    int   q_value;
+    int   q_bits;
+    s64   err_scale;
+
+} BENCH_QPARAM;
+
+static int qparam_get(BENCH_QPARAM * qp, int log2w, int log2h, int qp_val, int bit_depth)
+{
+    int    log2_size = (log2w + log2h) >> 1;
+    int    ns_shift = ((log2w + log2h) & 1) ? 7 : 0;
+    int    ns_offset = ns_shift ? (1 << (ns_shift - 1)) : 0;
+    int    tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
+    double err_scale;
+
+    qp->ns_scale = ns_shift ? 181 : 1;
+    qp->scale = quant_scale[qp_val % 6];
+    qp->shift = QUANT_SHIFT + tr_shift + ns_shift + qp_val / 6;
+    if(qp->shift < 9) return 0;
+    qp->offset = (s64)((rnd() & 1) ? 171 : 85) << (qp->shift - 9);
+
+    qp->q_value = (qp->scale * qp->ns_scale + ns_offset) >> ns_shift;
+    qp->q_bits = QUANT_SHIFT + tr_shift + qp_val / 6;
+    if(qp->q_bits < 1) return 0;
+    err_scale = (double)(1 << SCALE_BITS) * pow(2.0, -tr_shift);
+    err_scale = err_scale / qp->scale / (1 << (bit_depth - 8));
+    qp->err_scale = (s64)(err_scale * (double)(1 << ERR_SCALE_PRECISION_BITS));
+    return 1;
+}
+
+static void run_quant(void)
+{
+    int          log2w, log2h, w, h, n, bd, t, l, i, iter, qp_val;
+    int          nnz[BENCH_MAX_LEVELS], sum[BENCH_MAX_LEVELS];
+    s64          cost[BENCH_MAX_LEVELS];
+    double       tpp[3][BENCH_MAX_LEVELS];
+    BENCH_QPARAM qp;
+    u64          tick;
+
+    for(log2w = 1; log2w <= MAX_TR_LOG2; log2w++)
+    {
+        for(log2h = 1; log2h <= MAX_TR_LOG2; log2h++)
+        {
+            w = 1 << log2w;
+            h = 1 << log2h;
+            n = w * h;
+            for(bd = 8; bd <= 12; bd += 2)
+            {
+                for(t = 0; t < op_trials; t++)
+                {
+                    /* luma qp range including the bit depth offset */
+                    qp_val = rnd() % (52 + 6 * (bd - 8));
+                    if(!qparam_get(&qp, log2w, log2h, qp_val, bd)) continue;
+
+                    rnd_fill_coef(buf_coef[0], n);
+                    for(l = 1; l < num_levels; l++) memcpy(buf_coef[l], buf_coef[0], sizeof(s16) * n);
+                    for(l = 0; l < num_levels; l++)
+                    {
+                        nnz[l] = levels[l].kfne.get_max_abs_coef(buf_coef[l], n);
+                        sum[l] = levels[l].kfne.rdoq_prepass(buf_coef[l], n, qp.q_value, qp.q_bits, qp.err_scale,
+                                                             buf_tmp[l], buf_lev[l], &cost[l]);
+                    }
+                    for(l = 1; l < num_levels; l++)
+                    {
+                        if(nnz[l] != nnz[0])
+                        {
+                            report_mismatch("max_abs", w, h, bd, l);
+                        }
+                        if(sum[l] != sum[0] || cost[l] != cost[0] ||
+                           memcmp(buf_tmp[0], buf_tmp[l], sizeof(s16) * n) ||
+                           memcmp(buf_lev[0], buf_lev[l], sizeof(s32) * n))
+                        {
+                            report_mismatch("rdoq_pre", w, h, bd, l);
+                        }
+                    }
+
+                    for(l = 0; l < num_levels; l++)
+                    {
+                        nnz[l] = levels[l].kfne.quant_block(buf_coef[l], n, qp.scale, qp.ns_scale, qp.offset, qp.shift);
+                    }
+                    for(l = 1; l < num_levels; l++)
+                    {
+                        if(nnz[l] != nnz[0] || memcmp(buf_coef[0], buf_coef[l], sizeof(s16) * n))
+                        {
+                            report_mismatch("quant", w, h, bd, l);
+                        }
+                    }
+                }
+            }
+            if(op_check_only || log2w != log2h || log2w < 2) continue;
+
+            qparam_get(&qp, log2w, log2h, 32, 10);
+            iter = bench_iter(n);
+            for(l = 0; l < num_levels; l++)
+            {
+                rnd_state = (u32)op_seed | 1;
+                rnd_fill_coef(buf_tmp[l], n);
+
+                tick = ticks_get();
+                for(i = 0; i < iter; i++)
+                {
+                    sink += levels[l].kfne.get_max_abs_coef(buf_tmp[l], n);
+                }
+                tpp[0][l] = (double)(ticks_get() - tick) / ((double)iter * n);
+
+                tick = ticks_get();
+                for(i = 0; i < iter; i++)
+                {
+                    sink += levels[l].kfne.rdoq_prepass(buf_tmp[l], n, qp.q_value, qp.q_bits, qp.err_scale,
+                                                        buf_coef[l], buf_lev[l], &cost[l]);
+                }
+                tpp[1][l] = (double)(ticks_get() - tick) / ((double)iter * n);
+
+                tick = ticks_get();
+                for(i = 0; i < iter; i++)
+                {
+                    /* quantize a fresh copy each time; the copy is part of the cost */
+                    memcpy(buf_coef[l], buf_tmp[l], sizeof(s16) * n);
+                    sink += levels[l].kfne.quant_block(buf_coef[l], n, qp.scale, qp.ns_scale, qp.offset, qp.shift);
+                }
+                tpp[2][l] = (double)(ticks_get() - tick) / ((double)iter * n);
+            }
+            report_timing("max_abs", w, h, tpp[0]);
+            report_timing("rdoq_pre", w, h, tpp[1]);
+            report_timing("quant", w, h, tpp[2]);
+        }
+    }
+}
+
+/*****************************************************************************
+ * quality metrics
+ *****************************************************************************/
+static void run_qm(void)
+{
+    int    w, h, n, bd, t, l, i, iter;
+    int    sum[BENCH_MAX_LEVELS][MAX_CU_SIZE >> 2][4];
+    s64    sse[BENCH_MAX_LEVELS];
+    double tpp[2][BENCH_MAX_LEVELS];
+    u64    tick;
+
+    /* widths of any remainder after the vector loops */
+    for(w = 4; w <= MAX_CU_SIZE; w += (w < 16) ? 1 : 16)
+    {
+        h = 16;
+        n = w >> 2;
+        for(bd = 8; bd <= 12; bd += 2)
+        {
+            for(t = 0; t < op_trials; t++)
+            {
+                rnd_fill(buf_org, BENCH_PLANE, bd);
+                rnd_fill(buf_cur, BENCH_PLANE, bd);
+                for(l = 0; l < num_levels; l++)
+                {
+                    sse[l] = levels[l].kfne.sse_plane(buf_org, buf_cur, BENCH_STRIDE, BENCH_STRIDE, w, h);
+                    levels[l].kfne.ssim_4x4(buf_org, buf_cur, BENCH_STRIDE, BENCH_STRIDE, n, sum[l]);
+                }
+                for(l = 1; l < num_levels; l++)
+                {
+                    if(sse[l] != sse[0])
+                    {
+                        report_mismatch("sse_plane", w, h, bd, l);
+                    }
+                    if(memcmp(sum[l], sum[0], sizeof(int) * 4 * n))
+                    {
+                        report_mismatch("ssim_4x4", w, 4, bd, l);
+                    }
+                }
+            }
+        }
+        if(op_check_only || w != MAX_CU_SIZE) continue;
+
+        iter = bench_iter(w * h);
+        for(l = 0; l < num_levels; l++)
+        {
+            tick = ticks_get();
+            for(i = 0; i < iter; i++)
+            {
+                sink += levels[l].kfne.sse_plane(buf_org, buf_cur, BENCH_STRIDE, BENCH_STRIDE, w, h);
+            }
+            tpp[0][l] = (double)(ticks_get() - tick) / ((double)iter * w * h);
+
+            tick = ticks_get();
+            for(i = 0; i < iter * 4; i++)
+            {
+                levels[l].kfne.ssim_4x4(buf_org, buf_cur, BENCH_STRIDE, BENCH_STRIDE, n, sum[l]);
+            }
+            tpp[1][l] = (double)(ticks_get() - tick) / ((double)iter * w * h);
+        }
+        report_timing("sse_plane", w, h, tpp[0]);
+        report_timing("ssim_4x4", w, h, tpp[1]);
+    }
+}
+
+int main(int argc, const char ** argv)
+{
+    char str[256];
+    int  i, len, ret;
+
+    /* parse options */
+    ret = evey_args_parse_all(argc, argv, options);
+    if(ret != 0)
+    {
+        if(ret > 0) logv0("-%c argument should be set\n", ret);
+        print_usage();
+        return -1;
+    }
+
+    levels_init();
+    rnd_state = (u32)op_seed | 1;
+
+    len = sprintf(str, "%-10s %-7s", "kernel", "size");
+    for(i = 0; i < num_levels; i++)
+    {
+        len += sprintf(str + len, " %10s", evey_isa_name(levels[i].isa));
+    }
+    if(num_levels > 1) sprintf(str + len, " %9s", "speedup");
+
+    logv1("max ISA level of this CPU and build: %s\n", evey_isa_name(evey_isa_max()));
+    if(!op_check_only)
+    {
+        logv1("timings in time stamp counter ticks per pixel, bit depth 10\n");
+        logv1_line(NULL);
+        logv1("%s\n", str);
+        logv1_line(NULL);
+    }
+
+    if(kernel_enabled("sad"))   run_dist("sad", dist_sad, 1);
+    if(kernel_enabled("ssd"))   run_dist("ssd", dist_ssd, 1);
+    if(kernel_enabled("satd"))  run_dist("satd", dist_satd, 1);
+    if(kernel_enabled("diff"))  run_diff();
+    if(kernel_enabled("mc_l"))  run_mc("mc_l", 0);
+    if(kernel_enabled("mc_c"))  run_mc("mc_c", 1);
+    if(kernel_enabled("avg"))   run_avg();
+    if(kernel_enabled("quant")) run_quant();
+    if(kernel_enabled("qm"))    run_qm();
+
+    level_set(0);
+    if(num_levels == 1)
+    {
+        logv1("only C kernels are available on this CPU, nothing to compare\n");
+    }
+    logv0("%s: %d mismatch(es)\n", num_mismatch ? "FAIL" : "PASS", num_mismatch);
+    return num_mismatch ? 1 : 0;
+}
@@ -34,6 +34,9 @@
 #ifndef _CRT_SECURE_NO_WARNINGS
 #define _CRT_SECURE_NO_WARNINGS
 #endif
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L /* clock_gettime() */
+#endif
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -158,10 +161,131 @@ static EVEY_CLK evey_clk_from(EVEY_CLK from) \
 #define evey_clk_sec(clk)  \
     ((int)((clk + (EVEY_CLK_PER_SEC/2))/EVEY_CLK_PER_SEC))
 
+/* wall clock in nanoseconds; unlike evey_clk_get() it also counts the time
+   blocked on I/O */
+static long long evey_wall_ns(void)
+{
+#if defined(_WIN64) || defined(_WIN32)
+    LARGE_INTEGER freq, cnt;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&cnt);
+    return (long long)((double)cnt.QuadPart * 1e9 / (double)freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+    return (long long)clock() * (1000000000 / CLOCKS_PER_SEC);
+#endif
+}
+
+/* peak resident set size of the process in KiB */
+#if defined(_WIN64) || defined(_WIN32)
+#include <psapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+static long long peak_rss_kb(void)
+{
+    PROCESS_MEMORY_COUNTERS pmc;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return (long long)(pmc.PeakWorkingSetSize >> 10);
+}
+#else
+#include <sys/resource.h>
+static long long peak_rss_kb(void)
+{
+    struct rusage ru;
+    if(getrusage(RUSAGE_SELF, &ru)) return 0;
+    return (long long)ru.ru_maxrss; /* KiB on linux */
+}
+#endif
+
+/* flat JSON object of "key": number pairs, one per line, which keeps the
+   reports easy to diff and to compare against a stored baseline */
+typedef struct _BENCH_JSON
+{
+    FILE * fp;
+    int    cnt;
+
+} BENCH_JSON;
+
+static int bench_json_open(BENCH_JSON * js, const char * fname)
+{
+    js->cnt = 0;
+    js->fp = fopen(fname, "w");
+    if(js->fp == NULL) return -1;
+    fprintf(js->fp, "{\n");
+    return 0;
+}
+
+static void bench_json_put(BENCH_JSON * js, const char * key, double val)
+{
+    if(js->fp == NULL) return;
+    fprintf(js->fp, "%s  \"%s\": %.*f", js->cnt ? ",\n" : "", key,
+            val == (double)(long long)val ? 0 : 3, val);
+    js->cnt++;
+}
+
+static void bench_json_close(BENCH_JSON * js)
+{
+    if(js->fp == NULL) return;
+    fprintf(js->fp, "\n}\n");
+    fclose(js->fp);
+    js->fp = NULL;
+}
+
+/* memory counters of the library */
+static void bench_json_put_mem(BENCH_JSON * js)
+{
+    EVEY_MEM_STATS mem;
+
+    evey_mem_get_stats(&mem);
+    bench_json_put(js, "mem_alloc_cnt", (double)mem.alloc_cnt);
+    bench_json_put(js, "mem_alloc_kb", (double)(mem.alloc_bytes >> 10));
+    bench_json_put(js, "mem_pool_hit", (double)mem.pool_hit);
+    bench_json_put(js, "mem_pool_miss", (double)mem.pool_miss);
+}
+
+static void print_mem_stats(void)
+{
+    EVEY_MEM_STATS mem;
+
+    evey_mem_get_stats(&mem);
+    logv2("Memory counters:\n");
+    logv2("  allocations                   = %lld\n", mem.alloc_cnt);
+    logv2("  allocated KiB                 = %lld\n", mem.alloc_bytes >> 10);
+    logv2("  releases                      = %lld\n", mem.free_cnt);
+    logv2("  planes reused from pool       = %lld\n", mem.pool_hit);
+    logv2("  planes allocated on pool miss = %lld\n", mem.pool_miss);
+    logv2("  planes kept in pool           = %lld (%lld KiB)\n", mem.pool_cnt, mem.pool_bytes >> 10);
+}
+
+/* one line of the per-stage time breakdown; depth indents sub-stages */
+static void print_stage_time(const char * name, int depth, long long ns, long long ns_tot)
+{
+    logv1("  %*s%-*s: %10.3f msec %6.2f %%\n", depth * 2, "", 24 - depth * 2, name,
+          (double)ns / 1000000.0, ns_tot > 0 ? (double)ns * 100.0 / (double)ns_tot : 0.0);
+}
+
 #define EVEYA_CLIP(n,min,max) (((n)>(max))? (max) : (((n)<(min))? (min) : (n)))
 
 #define MAX_BUMP_FRM_CNT           (8 << 1)
 
+/* names of the --isa option, indexed by EVEY_ISA_XXX */
+static const char * isa_names[] = {"auto", "c", "sse4", "avx2", "avx512"};
+
+/* returns EVEY_ISA_XXX of the given name, or -1 if unknown */
+static int isa_parse(const char * name)
+{
+    int i;
+    for(i = 0; i < (int)(sizeof(isa_names) / sizeof(isa_names[0])); i++)
+    {
+        if(!strcmp(name, isa_names[i])) return i;
+    }
+    return -1;
+}
+
 typedef struct _IMGB_LIST
 {
     EVEY_IMGB   * imgb;
@@ -170,93 +294,296 @@ typedef struct _IMGB_LIST
 
 } IMGB_LIST;
 
-static int imgb_read(FILE * fp, EVEY_IMGB * img)
+/* threads of the applications, for the I/O stages */
+#if defined(_WIN64) || defined(_WIN32)
+typedef HANDLE                     APP_THREAD;
+typedef CRITICAL_SECTION           APP_LOCK;
+typedef CONDITION_VARIABLE         APP_COND;
+#define app_lock_init(l)           InitializeCriticalSection(l)
+#define app_lock_deinit(l)         DeleteCriticalSection(l)
+#define app_lock(l)                EnterCriticalSection(l)
+#define app_unlock(l)              LeaveCriticalSection(l)
+#define app_cond_init(c)           InitializeConditionVariable(c)
+#define app_cond_deinit(c)
+#define app_cond_wait(c, l)        SleepConditionVariableCS(c, l, INFINITE)
+#define app_cond_broadcast(c)      WakeAllConditionVariable(c)
+
+typedef struct _APP_THREAD_ARG
 {
-    int f_w, f_h;
-    int y_size, u_size, v_size;
+    void      (* fn)(void * arg);
+    void       * arg;
 
-    f_w = img->w[0];
-    f_h = img->h[0];
+} APP_THREAD_ARG;
 
-    int chroma_format_idc = CFI_FROM_CF(EVEY_CS_GET_FORMAT(img->cs));
-    if(EVEY_CS_GET_BIT_DEPTH(img->cs) == 8)
+static DWORD WINAPI app_thread_entry(LPVOID p)
+{
+    APP_THREAD_ARG a = *(APP_THREAD_ARG *)p;
+    free(p);
+    a.fn(a.arg);
+    return 0;
+}
+
+static int app_thread_create(APP_THREAD * th, void (*fn)(void * arg), void * arg)
+{
+    APP_THREAD_ARG * a = (APP_THREAD_ARG *)malloc(sizeof(APP_THREAD_ARG));
+    if(a == NULL) return -1;
+    a->fn = fn;
+    a->arg = arg;
+    *th = CreateThread(NULL, 0, app_thread_entry, a, 0, NULL);
+    if(*th == NULL)
     {
-        y_size = f_w * f_h;
+        free(a);
+        return -1;
+    }
+    return 0;
+}
 
-        if(fread(img->a[0], 1, y_size, fp) != (unsigned)y_size)
-        {
-            return -1;
-        }
-        
-        if(chroma_format_idc)
-        {
-            u_size = v_size = (f_w >> (GET_CHROMA_W_SHIFT(chroma_format_idc))) * (f_h >> (GET_CHROMA_H_SHIFT(chroma_format_idc)));
-            if(fread(img->a[1], 1, u_size, fp) != (unsigned)u_size)
-            {
-                return -1;
-            }
-            if(fread(img->a[2], 1, v_size, fp) != (unsigned)v_size)
-            {
-                return -1;
-            }
-        }
+static void app_thread_join(APP_THREAD th)
+{
+    WaitForSingleObject(th, INFINITE);
+    CloseHandle(th);
+}
+
+static void * app_malloc_align(size_t size, size_t align)
+{
+    return _aligned_malloc(size, align);
+}
+#define app_mfree_align(p)         _aligned_free(p)
+#else
+#include <pthread.h>
+typedef pthread_t                  APP_THREAD;
+typedef pthread_mutex_t            APP_LOCK;
+typedef pthread_cond_t             APP_COND;
+#define app_lock_init(l)           pthread_mutex_init(l, NULL)
+#define app_lock_deinit(l)         pthread_mutex_destroy(l)
+#define app_lock(l)                pthread_mutex_lock(l)
+#define app_unlock(l)              pthread_mutex_unlock(l)
+#define app_cond_init(c)           pthread_cond_init(c, NULL)
+#define app_cond_deinit(c)         pthread_cond_destroy(c)
+#define app_cond_wait(c, l)        pthread_cond_wait(c, l)
+#define app_cond_broadcast(c)      pthread_cond_broadcast(c)
+
+typedef struct _APP_THREAD_ARG
+{
+    void      (* fn)(void * arg);
+    void       * arg;
+
+} APP_THREAD_ARG;
+
+static void * app_thread_entry(void * p)
+{
+    APP_THREAD_ARG a = *(APP_THREAD_ARG *)p;
+    free(p);
+    a.fn(a.arg);
+    return NULL;
+}
+
+static int app_thread_create(APP_THREAD * th, void (*fn)(void * arg), void * arg)
+{
+    APP_THREAD_ARG * a = (APP_THREAD_ARG *)malloc(sizeof(APP_THREAD_ARG));
+    if(a == NULL) return -1;
+    a->fn = fn;
+    a->arg = arg;
+    if(pthread_create(th, NULL, app_thread_entry, a))
+    {
+        free(a);
+        return -1;
     }
-    else if(EVEY_CS_GET_BIT_DEPTH(img->cs) >= 10)
+    return 0;
+}
+
+static void app_thread_join(APP_THREAD th)
+{
+    pthread_join(th, NULL);
+}
+
+static void * app_malloc_align(size_t size, size_t align)
+{
+    void * p;
+    return posix_memalign(&p, align, size) ? NULL : p;
+}
+#define app_mfree_align(p)         free(p)
+#endif
+
+/* output file kept open for the whole run; data are gathered into large
+   aligned buffers which a background thread writes to the file, so the
+   caller only waits when all the buffers are still queued for writing */
+#define WRITER_BUF_SIZE            (4*1024*1024) /* in byte */
+#define WRITER_BUF_NUM             4
+
+typedef struct _WRITER
+{
+    FILE          * fp;
+    unsigned char * buf[WRITER_BUF_NUM];
+    size_t          len[WRITER_BUF_NUM];
+    /* buffer filled by the caller, always (head + queued) % WRITER_BUF_NUM */
+    int             fill;
+    /* oldest buffer queued for the I/O thread, and number of queued buffers */
+    int             head;
+    int             queued;
+    int             quit;
+    int             err;
+    /* 0: the caller writes the buffers itself (no thread available) */
+    int             threaded;
+    APP_THREAD      thread;
+    APP_LOCK        lock;
+    APP_COND        cond;
+
+} WRITER;
+
+static void writer_run(void * arg)
+{
+    WRITER * wr = (WRITER *)arg;
+    int      idx, err;
+
+    app_lock(&wr->lock);
+    while(1)
     {
-        y_size = f_w * f_h * sizeof(short);
-        u_size = v_size = (f_w >> 1) * (f_h >> 1) * sizeof(short);
-        if(fread(img->a[0], 1, y_size, fp) != (unsigned)y_size)
+        while(wr->queued == 0 && !wr->quit)
         {
-            return -1;
+            app_cond_wait(&wr->cond, &wr->lock);
         }
+        if(wr->queued == 0) break;
+
+        idx = wr->head;
+        app_unlock(&wr->lock);
+
+        err = fwrite(wr->buf[idx], 1, wr->len[idx], wr->fp) != wr->len[idx];
+
+        app_lock(&wr->lock);
+        wr->err |= err;
+        wr->len[idx] = 0;
+        wr->head = (wr->head + 1) % WRITER_BUF_NUM;
+        wr->queued--;
+        app_cond_broadcast(&wr->cond);
+    }
+    app_unlock(&wr->lock);
+}
+
+/* hand the buffer being filled to the I/O thread and move to a free one;
+   returns -1 once a write has failed */
+static int writer_submit(WRITER * wr)
+{
+    int err;
 
-        u_size = v_size = (f_w >> (GET_CHROMA_W_SHIFT(chroma_format_idc))) * (f_h >> (GET_CHROMA_H_SHIFT(chroma_format_idc))) * sizeof(short);
-        if(chroma_format_idc)
+    if(wr->len[wr->fill] == 0) return 0;
+
+    if(!wr->threaded)
+    {
+        if(fwrite(wr->buf[wr->fill], 1, wr->len[wr->fill], wr->fp) != wr->len[wr->fill])
         {
-            if(fread(img->a[1], 1, u_size, fp) != (unsigned)u_size)
-            {
-                return -1;
-            }
-            if(fread(img->a[2], 1, v_size, fp) != (unsigned)v_size)
-            {
-                return -1;
-            }
+            wr->err = 1;
         }
+        wr->len[wr->fill] = 0;
+        return -wr->err;
     }
-    else
+
+    app_lock(&wr->lock);
+    wr->queued++;
+    app_cond_broadcast(&wr->cond);
+    while(wr->queued == WRITER_BUF_NUM)
     {
-        logv0("not supported color space\n");
-        return -1;
+        app_cond_wait(&wr->cond, &wr->lock);
     }
+    wr->fill = (wr->head + wr->queued) % WRITER_BUF_NUM;
+    err = wr->err;
+    app_unlock(&wr->lock);
+    return -err;
+}
+
+static int writer_open(WRITER * wr, const char * fname)
+{
+    int i;
 
+    memset(wr, 0, sizeof(WRITER));
+    wr->fp = fopen(fname, "wb");
+    if(wr->fp == NULL) return -1;
+    /* the data go out in large blocks, stdio buffering is not needed */
+    setvbuf(wr->fp, NULL, _IONBF, 0);
+
+    for(i = 0; i < WRITER_BUF_NUM; i++)
+    {
+        wr->buf[i] = (unsigned char *)app_malloc_align(WRITER_BUF_SIZE, 4096);
+        if(wr->buf[i] == NULL) goto ERR;
+    }
+
+    app_lock_init(&wr->lock);
+    app_cond_init(&wr->cond);
+    wr->threaded = !app_thread_create(&wr->thread, writer_run, wr);
     return 0;
+
+ERR:
+    for(i = 0; i < WRITER_BUF_NUM; i++)
+    {
+        if(wr->buf[i]) app_mfree_align(wr->buf[i]);
+    }
+    fclose(wr->fp);
+    memset(wr, 0, sizeof(WRITER));
+    return -1;
 }
 
-static int imgb_write(char * fname, EVEY_IMGB * imgb)
+static int writer_write(WRITER * wr, const void * data, size_t size)
 {
-    unsigned char * p8;
-    int             i, j, bd;
-    int             cs_w_off, cs_h_off;
-    FILE          * fp;
+    const unsigned char * p = (const unsigned char *)data;
+    size_t                n;
 
-    fp = fopen(fname, "ab");
-    if(fp == NULL)
+    while(size > 0)
     {
-        logv0("cannot open file = %s\n", fname);
-        return -1;
+        n = WRITER_BUF_SIZE - wr->len[wr->fill];
+        if(n > size) n = size;
+        memcpy(wr->buf[wr->fill] + wr->len[wr->fill], p, n);
+        wr->len[wr->fill] += n;
+        p += n;
+        size -= n;
+
+        if(wr->len[wr->fill] == WRITER_BUF_SIZE && writer_submit(wr))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* write out everything, stop the I/O thread and close the file */
+static int writer_close(WRITER * wr)
+{
+    int i, err;
+
+    if(wr->fp == NULL) return 0;
+
+    writer_submit(wr);
+    if(wr->threaded)
+    {
+        app_lock(&wr->lock);
+        wr->quit = 1;
+        app_cond_broadcast(&wr->cond);
+        app_unlock(&wr->lock);
+        app_thread_join(wr->thread);
     }
+    app_cond_deinit(&wr->cond);
+    app_lock_deinit(&wr->lock);
+
+    for(i = 0; i < WRITER_BUF_NUM; i++)
+    {
+        app_mfree_align(wr->buf[i]);
+    }
+    err = wr->err || fclose(wr->fp);
+    memset(wr, 0, sizeof(WRITER));
+    return err ? -1 : 0;
+}
+
+static int imgb_write(WRITER * wr, EVEY_IMGB * imgb)
+{
+    unsigned char * p8;
+    int             i, j, bd;
 
     if(EVEY_CS_GET_BIT_DEPTH(imgb->cs) == 8)
     {
         bd = 1;
-        cs_w_off = 2;
-        cs_h_off = 2;
     }
     else if((EVEY_CS_GET_BIT_DEPTH(imgb->cs) >= 10) && (EVEY_CS_GET_BIT_DEPTH(imgb->cs) <= 14))
     {
         bd = 2;
-        cs_w_off = 2;
-        cs_h_off = 2;
     }
     else 
     {
@@ -269,30 +596,754 @@ static int imgb_write(char * fname, EVEY_IMGB * imgb)
         p8 = (unsigned char *)imgb->a[i] + (imgb->s[i] * imgb->y[i]) + (imgb->x[i] * bd);
         for(j = 0; j < imgb->h[i]; j++)
         {
-            fwrite(p8, imgb->w[i] * bd, 1, fp);
+            if(writer_write(wr, p8, imgb->w[i] * bd)) return -1;
             p8 += imgb->s[i];
         }
     }
+    return 0;
+}
 
-    fclose(fp);
+/* read-only view of a whole regular file, mapped copy-on-write so that
+   tools can rewrite headers in place */
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+typedef struct _MAP_FILE
+{
+    unsigned char * addr;
+    size_t          size;
+#if defined(_WIN32)
+    HANDLE          fh;
+    HANDLE          fmap;
+#endif
+
+} MAP_FILE;
+
+/* returns -1 when the file is not a regular file or cannot be mapped */
+static int map_file_open(MAP_FILE * mf, const char * fname)
+{
+    memset(mf, 0, sizeof(MAP_FILE));
+#if defined(_WIN32)
+    LARGE_INTEGER fsize;
+
+    mf->fh = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(mf->fh == INVALID_HANDLE_VALUE) return -1;
+    if(GetFileType(mf->fh) != FILE_TYPE_DISK || !GetFileSizeEx(mf->fh, &fsize)) goto ERR;
+    mf->size = (size_t)fsize.QuadPart;
+    if(mf->size == 0) return 0;
+
+    mf->fmap = CreateFileMappingA(mf->fh, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if(mf->fmap == NULL) goto ERR;
+    mf->addr = (unsigned char *)MapViewOfFile(mf->fmap, FILE_MAP_COPY, 0, 0, 0);
+    if(mf->addr == NULL) goto ERR;
     return 0;
+
+ERR:
+    if(mf->fmap) CloseHandle(mf->fmap);
+    CloseHandle(mf->fh);
+    memset(mf, 0, sizeof(MAP_FILE));
+    return -1;
+#else
+    struct stat st;
+    void      * addr;
+    int         fd;
+
+    fd = open(fname, O_RDONLY);
+    if(fd < 0) return -1;
+    if(fstat(fd, &st) || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return -1;
+    }
+    mf->size = (size_t)st.st_size;
+    if(mf->size == 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    addr = mmap(NULL, mf->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED)
+    {
+        mf->size = 0;
+        return -1;
+    }
+#if defined(POSIX_MADV_SEQUENTIAL)
+    posix_madvise(addr, mf->size, POSIX_MADV_SEQUENTIAL);
+#endif
+    mf->addr = (unsigned char *)addr;
+    return 0;
+#endif
 }
 
-static int write_data(char * fname, unsigned char * data, int size)
+/* ask the system to read [pos, pos + size) ahead of its use */
+static void map_file_prefetch(MAP_FILE * mf, size_t pos, size_t size)
 {
-    FILE * fp;
+#if !defined(_WIN32) && defined(POSIX_MADV_WILLNEED)
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t beg = pos & ~(page - 1);
+
+    if(pos >= mf->size) return;
+    if(size > mf->size - pos) size = mf->size - pos;
+    posix_madvise(mf->addr + beg, size + (pos - beg), POSIX_MADV_WILLNEED);
+#endif
+}
+
+static void map_file_close(MAP_FILE * mf)
+{
+#if defined(_WIN32)
+    if(mf->addr) UnmapViewOfFile(mf->addr);
+    if(mf->fmap) CloseHandle(mf->fmap);
+    if(mf->fh) CloseHandle(mf->fh);
+#else
+    if(mf->addr) munmap(mf->addr, mf->size);
+#endif
+    memset(mf, 0, sizeof(MAP_FILE));
+}
+
+/* bitstream source: a regular file is mapped and the NAL units are handed
+   out in place; other inputs ("-" for stdin, pipes) are read NAL unit by
+   NAL unit through a large stdio buffer into a growing buffer */
+#define BS_SRC_STREAM_BUF          (4*1024*1024) /* in byte */
+
+typedef struct _BS_SRC
+{
+    MAP_FILE        map;
+    /* read position in the mapped file */
+    size_t          pos;
+    /* stream input, NULL when the file is mapped */
+    FILE          * fp;
+    /* buffer of the last NAL unit read from the stream, and its capacity */
+    unsigned char * buf;
+    size_t          bsize;
+    /* read position in the stream */
+    long long       spos;
+    /* end of the part to read, 0 for the end of the input */
+    long long       end;
+
+} BS_SRC;
+
+static int bs_src_open(BS_SRC * src, const char * fname)
+{
+    memset(src, 0, sizeof(BS_SRC));
+
+    if(strcmp(fname, "-") && !map_file_open(&src->map, fname))
+    {
+        return 0;
+    }
+
+    src->fp = strcmp(fname, "-") ? fopen(fname, "rb") : stdin;
+    if(src->fp == NULL) return -1;
+    setvbuf(src->fp, NULL, _IOFBF, 1024 * 1024);
+
+    src->bsize = BS_SRC_STREAM_BUF;
+    src->buf = (unsigned char *)malloc(src->bsize);
+    if(src->buf == NULL)
+    {
+        if(src->fp != stdin) fclose(src->fp);
+        src->fp = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+/* returns the size of the next NAL unit and its address in *nalu, 0 at the
+   end of the bitstream, or -1 on error; *nalu stays valid until the next
+   call */
+static int bs_src_read_nalu(BS_SRC * src, unsigned char ** nalu)
+{
+    int bs_size = 0;
+
+    if(src->end > 0 && (src->fp == NULL ? (long long)src->pos : src->spos) >= src->end)
+    {
+        logv2("End of range\n");
+        return 0;
+    }
+
+    if(src->fp == NULL)
+    {
+        if(src->pos == src->map.size)
+        {
+            logv2("End of file\n");
+            return 0;
+        }
+        if(src->map.size - src->pos < 4)
+        {
+            logv0("Cannot read bitstream size!\n");
+            return -1;
+        }
+        memcpy(&bs_size, src->map.addr + src->pos, 4);
+        if(bs_size <= 0)
+        {
+            logv0("Invalid bitstream size![%d]\n", bs_size);
+            return -1;
+        }
+        if(src->map.size - src->pos - 4 < (size_t)bs_size)
+        {
+            logv0("Cannot read bitstream!\n");
+            return -1;
+        }
+        *nalu = src->map.addr + src->pos + 4;
+        src->pos += 4 + (size_t)bs_size;
+        return bs_size;
+    }
 
-    fp = fopen(fname, "ab");
-    if(fp == NULL)
+    /* read size first */
+    if(4 != fread(&bs_size, 1, 4, src->fp))
     {
-        logv0("cannot open an writing file=%s\n", fname);
+        if(feof(src->fp))
+        {
+            logv2("End of file\n");
+            return 0;
+        }
+        logv0("Cannot read bitstream size!\n");
         return -1;
     }
-    fwrite(data, 1, size, fp);
+    if(bs_size <= 0)
+    {
+        logv0("Invalid bitstream size![%d]\n", bs_size);
+        return -1;
+    }
+    if((size_t)bs_size > src->bsize)
+    {
+        unsigned char * buf = (unsigned char *)realloc(src->buf, bs_size);
+        if(buf == NULL)
+        {
+            logv0("ERROR: cannot allocate bit buffer, size=%d\n", bs_size);
+            return -1;
+        }
+        src->buf = buf;
+        src->bsize = bs_size;
+    }
+    if(fread(src->buf, 1, bs_size, src->fp) != (size_t)bs_size)
+    {
+        logv0("Cannot read bitstream!\n");
+        return -1;
+    }
+    src->spos += 4 + bs_size;
+    *nalu = src->buf;
+    return bs_size;
+}
+
+/* restrict the reading to the bytes [beg, end) of the bitstream, end 0 for
+   the end of the input; beg must be the offset of a NAL unit size field.
+   returns -1 if the input cannot seek */
+static int bs_src_range(BS_SRC * src, long long beg, long long end)
+{
+    if(src->fp == NULL)
+    {
+        if(beg < 0 || beg > (long long)src->map.size) return -1;
+        src->pos = (size_t)beg;
+    }
+    else if(beg != src->spos)
+    {
+        if(src->fp == stdin) return -1;
+#if defined(_WIN32)
+        if(_fseeki64(src->fp, beg, SEEK_SET)) return -1;
+#else
+        if(fseek(src->fp, (long)beg, SEEK_SET)) return -1;
+#endif
+        src->spos = beg;
+    }
+    src->end = end;
+    return 0;
+}
+
+static void bs_src_close(BS_SRC * src)
+{
+    if(src->fp)
+    {
+        if(src->fp != stdin) fclose(src->fp);
+        free(src->buf);
+    }
+    map_file_close(&src->map);
+    memset(src, 0, sizeof(BS_SRC));
+}
+
+/* bitstream index: sidecar file with a record of each NAL unit of a
+   bitstream, so that tools can seek in it and split it without parsing it.
+   the file starts with BS_INDEX_MAGIC and the version, and is followed by
+   records of BS_INDEX_REC_SIZE bytes in little endian:
+   offset(8) size(4) poc(4) frame(4) nalu_type(1) stype(1) tid(1) idr(1) */
+#define BS_INDEX_MAGIC             "EVIX"
+#define BS_INDEX_VERSION           1
+#define BS_INDEX_REC_SIZE          24
+
+typedef struct _BS_INDEX_REC
+{
+    /* offset of the size field of the NAL unit in the bitstream */
+    long long       offset;
+    /* size of the NAL unit, without its size field */
+    int             size;
+    /* picture order count of the picture the NAL unit belongs to */
+    int             poc;
+    /* number of the picture in output order from the start of the
+       bitstream; unlike the POC, it is not reset at IDR pictures */
+    int             frame;
+    /* EVEY_XXX_NUT */
+    unsigned char   nalu_type;
+    /* EVEY_ST_XXX of the picture */
+    unsigned char   stype;
+    unsigned char   tid;
+    /* 1 if the NAL unit belongs to an IDR picture, parameter sets included */
+    unsigned char   idr;
+
+} BS_INDEX_REC;
+
+typedef struct _BS_INDEX
+{
+    BS_INDEX_REC  * rec;
+    int             num;
+
+} BS_INDEX;
+
+static void bs_index_put_le(unsigned char * p, long long v, int bytes)
+{
+    int i;
+
+    for(i = 0; i < bytes; i++)
+    {
+        p[i] = (unsigned char)(v >> (i * 8));
+    }
+}
+
+static long long bs_index_get_le(const unsigned char * p, int bytes)
+{
+    unsigned long long v = 0;
+    int                i;
+
+    for(i = bytes - 1; i >= 0; i--)
+    {
+        v = (v << 8) | p[i];
+    }
+    /* sign extension of the 4 byte fields */
+    if(bytes == 4) return (long long)(int)(unsigned int)v;
+    return (long long)v;
+}
+
+static FILE * bs_index_create(const char * fname)
+{
+    unsigned char hdr[8];
+    FILE        * fp;
+
+    fp = fopen(fname, "wb");
+    if(fp == NULL) return NULL;
+    memcpy(hdr, BS_INDEX_MAGIC, 4);
+    bs_index_put_le(hdr + 4, BS_INDEX_VERSION, 4);
+    if(fwrite(hdr, 1, 8, fp) != 8)
+    {
+        fclose(fp);
+        return NULL;
+    }
+    return fp;
+}
+
+/* add the records of the NAL units of an encoded picture, with their size
+   fields, written at offset in the bitstream */
+static int bs_index_write(FILE * fp, const unsigned char * bs, int size, long long offset,
+                          int poc, int frame, int stype)
+{
+    unsigned char rec[BS_INDEX_REC_SIZE];
+    int           pos, nalu_size, nalu_type, idr;
+
+    /* the parameter sets come with IDR pictures */
+    idr = 0;
+    for(pos = 0; pos + 6 <= size; pos += 4 + nalu_size)
+    {
+        memcpy(&nalu_size, bs + pos, 4);
+        if(nalu_size < 2 || nalu_size > size - pos - 4) return -1;
+        if((((bs[pos + 4] >> 1) & 0x3f) - 1) == EVEY_IDR_NUT) idr = 1;
+    }
+
+    for(pos = 0; pos + 6 <= size; pos += 4 + nalu_size)
+    {
+        memcpy(&nalu_size, bs + pos, 4);
+        nalu_type = ((bs[pos + 4] >> 1) & 0x3f) - 1;
+
+        bs_index_put_le(rec, offset + pos, 8);
+        bs_index_put_le(rec + 8, nalu_size, 4);
+        bs_index_put_le(rec + 12, poc, 4);
+        bs_index_put_le(rec + 16, frame, 4);
+        rec[20] = (unsigned char)nalu_type;
+        rec[21] = (unsigned char)stype;
+        rec[22] = (unsigned char)(((bs[pos + 4] & 1) << 2) | (bs[pos + 5] >> 6));
+        rec[23] = (unsigned char)idr;
+        if(fwrite(rec, 1, BS_INDEX_REC_SIZE, fp) != BS_INDEX_REC_SIZE) return -1;
+    }
+    return 0;
+}
+
+static void bs_index_free(BS_INDEX * idx)
+{
+    free(idx->rec);
+    memset(idx, 0, sizeof(BS_INDEX));
+}
+
+static int bs_index_load(BS_INDEX * idx, const char * fname)
+{
+    unsigned char buf[BS_INDEX_REC_SIZE];
+    FILE        * fp;
+    long          fsize;
+    int           i;
+
+    memset(idx, 0, sizeof(BS_INDEX));
+    fp = fopen(fname, "rb");
+    if(fp == NULL) return -1;
+
+    if(fread(buf, 1, 8, fp) != 8 || memcmp(buf, BS_INDEX_MAGIC, 4) ||
+       bs_index_get_le(buf + 4, 4) != BS_INDEX_VERSION || fseek(fp, 0, SEEK_END))
+    {
+        goto ERR;
+    }
+    fsize = ftell(fp);
+    if(fsize < 8 || (fsize - 8) % BS_INDEX_REC_SIZE || fseek(fp, 8, SEEK_SET)) goto ERR;
+
+    idx->num = (int)((fsize - 8) / BS_INDEX_REC_SIZE);
+    idx->rec = (BS_INDEX_REC *)malloc(sizeof(BS_INDEX_REC) * (idx->num + 1));
+    if(idx->rec == NULL) goto ERR;
+
+    for(i = 0; i < idx->num; i++)
+    {
+        if(fread(buf, 1, BS_INDEX_REC_SIZE, fp) != BS_INDEX_REC_SIZE) goto ERR;
+        idx->rec[i].offset = bs_index_get_le(buf, 8);
+        idx->rec[i].size = (int)bs_index_get_le(buf + 8, 4);
+        idx->rec[i].poc = (int)bs_index_get_le(buf + 12, 4);
+        idx->rec[i].frame = (int)bs_index_get_le(buf + 16, 4);
+        idx->rec[i].nalu_type = buf[20];
+        idx->rec[i].stype = buf[21];
+        idx->rec[i].tid = buf[22];
+        idx->rec[i].idr = buf[23];
+    }
+    fclose(fp);
+    return 0;
+
+ERR:
     fclose(fp);
+    bs_index_free(idx);
+    return -1;
+}
+
+/* whether record i starts an IDR picture, with its parameter sets */
+static int bs_index_is_idr_start(BS_INDEX * idx, int i)
+{
+    return idx->rec[i].idr && (i == 0 || !idx->rec[i - 1].idr || idx->rec[i - 1].frame != idx->rec[i].frame);
+}
+
+/* record starting the segment to decode for the given frame in output
+   order: the last IDR picture whose segment shows a picture at or before
+   the frame. *first gets the first frame in output order of the segment,
+   whose pictures are not in output order when it has leading pictures.
+   returns -1 if the frame is not in the bitstream */
+static int bs_index_seek_idr(BS_INDEX * idx, int frame, int * first)
+{
+    int i, beg = -1, found = -1, min = 0, max = -1;
+
+    for(i = 0; i <= idx->num; i++)
+    {
+        if(i == idx->num || bs_index_is_idr_start(idx, i))
+        {
+            if(beg >= 0 && min <= frame)
+            {
+                found = beg;
+                *first = min;
+            }
+            if(i == idx->num) break;
+            beg = i;
+            min = idx->rec[i].frame;
+        }
+        if(idx->rec[i].frame < min) min = idx->rec[i].frame;
+        if(idx->rec[i].frame > max) max = idx->rec[i].frame;
+    }
+    return frame >= 0 && frame <= max ? found : -1;
+}
+
+/* split the bitstream into segments starting at IDR pictures, which can be
+   decoded independently when the GOPs are closed. seg_beg[k] gets the first
+   record of segment k, for k up to max_seg; returns the number of segments.
+   a segment ends where the next one starts, the last at the end of the
+   bitstream */
+static int bs_index_segments(BS_INDEX * idx, int * seg_beg, int max_seg)
+{
+    int i, num = 0;
+
+    for(i = 0; i < idx->num; i++)
+    {
+        if(bs_index_is_idr_start(idx, i))
+        {
+            if(num < max_seg) seg_beg[num] = i;
+            num++;
+        }
+    }
+    return num;
+}
+
+/* same split found from the NAL unit headers, for a bitstream without
+   index: a segment starts at the SPS sent with an IDR picture, the first
+   one at the start of the bitstream. *seg_off gets an allocated array of
+   the offsets of the segments; returns their number, or -1 on error. the
+   source is rewound, so it must be able to seek */
+static int bs_src_segments(BS_SRC * src, long long ** seg_off)
+{
+    unsigned char * nalu;
+    long long     * off = NULL, * tmp;
+    long long       pos, sps = -1;
+    int             size, type, num = 0, max = 0;
+
+    *seg_off = NULL;
+    if(bs_src_range(src, 0, 0)) return -1;
+    while(1)
+    {
+        pos = src->fp == NULL ? (long long)src->pos : src->spos;
+        size = bs_src_read_nalu(src, &nalu);
+        if(size <= 0) break;
+
+        type = ((nalu[0] >> 1) & 0x3f) - 1;
+        if(type == EVEY_SPS_NUT)
+        {
+            sps = pos;
+        }
+        else if(type == EVEY_NONIDR_NUT)
+        {
+            sps = -1;
+        }
+        else if(type == EVEY_IDR_NUT && (sps >= 0 || num == 0))
+        {
+            if(num == max)
+            {
+                max = max ? max * 2 : 64;
+                tmp = (long long *)realloc(off, sizeof(long long) * max);
+                if(tmp == NULL) goto ERR;
+                off = tmp;
+            }
+            off[num] = num == 0 ? 0 : sps;
+            num++;
+            sps = -1;
+        }
+    }
+    if(size < 0 || bs_src_range(src, 0, 0)) goto ERR;
+    *seg_off = off;
+    return num;
+
+ERR:
+    free(off);
+    return -1;
+}
+
+/* source of original frames: a regular file is mapped and read ahead by
+   the system; other inputs ("-" for stdin, pipes) are read by a thread
+   into a ring of frames ahead of the encoder */
+#define YUV_SRC_AHEAD              4 /* in frame */
+
+typedef struct _YUV_SRC
+{
+    MAP_FILE        map;
+    /* read position in the mapped file */
+    size_t          pos;
+    /* sizes in byte of the planes of a frame, and of the frame */
+    int             plane_size[3];
+    size_t          frame_size;
+    /* stream input, NULL when the file is mapped */
+    FILE          * fp;
+    unsigned char * ring[YUV_SRC_AHEAD];
+    /* oldest read frame, and number of frames read ahead */
+    int             head;
+    int             cnt;
+    int             eof;
+    int             quit;
+    APP_THREAD      thread;
+    APP_LOCK        lock;
+    APP_COND        cond;
+
+} YUV_SRC;
+
+static void yuv_src_run(void * arg)
+{
+    YUV_SRC * src = (YUV_SRC *)arg;
+    int       idx;
+    size_t    n;
+
+    app_lock(&src->lock);
+    while(1)
+    {
+        while(src->cnt == YUV_SRC_AHEAD && !src->quit)
+        {
+            app_cond_wait(&src->cond, &src->lock);
+        }
+        if(src->quit) break;
+
+        idx = (src->head + src->cnt) % YUV_SRC_AHEAD;
+        app_unlock(&src->lock);
+
+        n = fread(src->ring[idx], 1, src->frame_size, src->fp);
+
+        app_lock(&src->lock);
+        if(n != src->frame_size)
+        {
+            src->eof = 1;
+            app_cond_broadcast(&src->cond);
+            break;
+        }
+        src->cnt++;
+        app_cond_broadcast(&src->cond);
+    }
+    app_unlock(&src->lock);
+}
+
+/* img gives the size and the format of the frames */
+static int yuv_src_open(YUV_SRC * src, const char * fname, EVEY_IMGB * img)
+{
+    int i, bd, cfi;
+
+    memset(src, 0, sizeof(YUV_SRC));
+
+    cfi = CFI_FROM_CF(EVEY_CS_GET_FORMAT(img->cs));
+    if(EVEY_CS_GET_BIT_DEPTH(img->cs) == 8)
+    {
+        bd = 1;
+    }
+    else if(EVEY_CS_GET_BIT_DEPTH(img->cs) >= 10)
+    {
+        bd = 2;
+    }
+    else
+    {
+        logv0("not supported color space\n");
+        return -1;
+    }
+    src->plane_size[0] = img->w[0] * img->h[0] * bd;
+    if(cfi)
+    {
+        src->plane_size[1] = src->plane_size[2] =
+            (img->w[0] >> (GET_CHROMA_W_SHIFT(cfi))) * (img->h[0] >> (GET_CHROMA_H_SHIFT(cfi))) * bd;
+    }
+    src->frame_size = (size_t)src->plane_size[0] + src->plane_size[1] + src->plane_size[2];
+
+    if(strcmp(fname, "-") && !map_file_open(&src->map, fname))
+    {
+        map_file_prefetch(&src->map, 0, src->frame_size * YUV_SRC_AHEAD);
+        return 0;
+    }
+
+    src->fp = strcmp(fname, "-") ? fopen(fname, "rb") : stdin;
+    if(src->fp == NULL) return -1;
+    setvbuf(src->fp, NULL, _IONBF, 0);
+
+    for(i = 0; i < YUV_SRC_AHEAD; i++)
+    {
+        src->ring[i] = (unsigned char *)app_malloc_align(src->frame_size, 4096);
+        if(src->ring[i] == NULL) goto ERR;
+    }
+    app_lock_init(&src->lock);
+    app_cond_init(&src->cond);
+    if(app_thread_create(&src->thread, yuv_src_run, src))
+    {
+        app_cond_deinit(&src->cond);
+        app_lock_deinit(&src->lock);
+        goto ERR;
+    }
+    return 0;
+
+ERR:
+    for(i = 0; i < YUV_SRC_AHEAD; i++)
+    {
+        if(src->ring[i]) app_mfree_align(src->ring[i]);
+    }
+    if(src->fp != stdin) fclose(src->fp);
+    memset(src, 0, sizeof(YUV_SRC));
+    return -1;
+}
+
+/* takes the next frame: copies it into img when img is not NULL; returns -1
+   at the end of the input */
+static int yuv_src_read(YUV_SRC * src, EVEY_IMGB * img)
+{
+    unsigned char * p;
+    int             i, idx, cnt;
+
+    if(src->fp == NULL)
+    {
+        if(src->map.size - src->pos < src->frame_size) return -1;
+        p = src->map.addr + src->pos;
+        src->pos += src->frame_size;
+        map_file_prefetch(&src->map, src->pos + src->frame_size * (YUV_SRC_AHEAD - 1), src->frame_size);
+    }
+    else
+    {
+        app_lock(&src->lock);
+        while(src->cnt == 0 && !src->eof)
+        {
+            app_cond_wait(&src->cond, &src->lock);
+        }
+        idx = src->head;
+        cnt = src->cnt;
+        app_unlock(&src->lock);
+        if(cnt == 0) return -1;
+        p = src->ring[idx];
+    }
+
+    for(i = 0; img != NULL && i < 3; i++)
+    {
+        memcpy(img->a[i], p, src->plane_size[i]);
+        p += src->plane_size[i];
+    }
+
+    if(src->fp)
+    {
+        app_lock(&src->lock);
+        src->head = (src->head + 1) % YUV_SRC_AHEAD;
+        src->cnt--;
+        app_cond_broadcast(&src->cond);
+        app_unlock(&src->lock);
+    }
     return 0;
 }
 
+/* drops the next frames, seeking over them when the input allows it */
+static int yuv_src_skip(YUV_SRC * src, int frames)
+{
+    if(src->fp == NULL)
+    {
+        if((src->map.size - src->pos) / src->frame_size < (size_t)frames) return -1;
+        src->pos += src->frame_size * frames;
+        map_file_prefetch(&src->map, src->pos, src->frame_size * YUV_SRC_AHEAD);
+        return 0;
+    }
+    while(frames-- > 0)
+    {
+        if(yuv_src_read(src, NULL)) return -1;
+    }
+    return 0;
+}
+
+static void yuv_src_close(YUV_SRC * src)
+{
+    int i;
+
+    if(src->fp)
+    {
+        app_lock(&src->lock);
+        src->quit = 1;
+        app_cond_broadcast(&src->cond);
+        app_unlock(&src->lock);
+        app_thread_join(src->thread);
+        app_cond_deinit(&src->cond);
+        app_lock_deinit(&src->lock);
+
+        for(i = 0; i < YUV_SRC_AHEAD; i++)
+        {
+            app_mfree_align(src->ring[i]);
+        }
+        if(src->fp != stdin) fclose(src->fp);
+    }
+    map_file_close(&src->map);
+    memset(src, 0, sizeof(YUV_SRC));
+}
+
 static void imgb_cpy_plane(EVEY_IMGB * dst, EVEY_IMGB * src)
 {
     int i, j;
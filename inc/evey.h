@@ -36,6 +36,8 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
 /*****************************************************************************
  * return values and error code
  *****************************************************************************/
@@ -126,18 +128,45 @@ extern "C"
     ((chroma_format_idc == 0) ? 1 : \
      (chroma_format_idc == 1) ? 1 : 0)
 
+/*****************************************************************************
+ * instruction set of the kernel table
+ * - AUTO selects the highest level supported by both the CPU and the build;
+ *   an explicit level is lowered to that when it is not available.
+ *****************************************************************************/
+#define EVEY_ISA_AUTO                    (0)
+#define EVEY_ISA_C                       (1)
+#define EVEY_ISA_SSE4                    (2)
+#define EVEY_ISA_AVX2                    (3)
+#define EVEY_ISA_AVX512                  (4)
+
 /*****************************************************************************
  * config types for decoder
  *****************************************************************************/
 #define EVEYD_CFG_SET_USE_PIC_SIGNATURE  (301)
 #define EVEYD_CFG_SET_USE_OPL_OUTPUT     (302)
+#define EVEYD_CFG_GET_ISA                (600)
+#define EVEYD_CFG_GET_STATS              (601)
 
 /*****************************************************************************
  * config types for encoder
  *****************************************************************************/
+/* complexity level of EVEYE_CFG_SET_COMPLEXITY
+   - 0: RDO counts the rate by running the arithmetic coder (default)
+   - 1: RDO estimates the fractional rate from the context states */
 #define EVEYE_CFG_SET_COMPLEXITY         (100)
 #define EVEYE_CFG_SET_SPEED              (101)
 #define EVEYE_CFG_SET_FORCE_OUT          (102)
+/* when set, eveye_push() encodes from the pushed image buffer itself
+   instead of a copy, if it has the size, the chroma format and 16-bit
+   samples of the encoder: the buffer is referenced through addref() and
+   release() when they exist, its samples may be converted to the codec
+   bit depth in place (with its cs updated), and it must stay unchanged
+   until the encoder outputs the picture, or returns its quality metrics
+   when they are enabled */
+#define EVEYE_CFG_SET_INPUT_REF          (103)
+/* install the NAL sink of EVEYE_NAL_SINK, or remove it with a NULL
+   fn_sink; buf points to the EVEYE_NAL_SINK */
+#define EVEYE_CFG_SET_NAL_SINK           (104)
 #define EVEYE_CFG_SET_FINTRA             (200)
 #define EVEYE_CFG_SET_QP                 (201)
 #define EVEYE_CFG_SET_BPS                (202)
@@ -162,6 +191,9 @@ extern "C"
 #define EVEYE_CFG_GET_USE_DEBLOCK        (610)
 #define EVEYE_CFG_GET_CLOSED_GOP         (611)
 #define EVEYE_CFG_GET_HIERARCHICAL_GOP   (612)
+#define EVEYE_CFG_GET_ISA                (613)
+#define EVEYE_CFG_GET_STATS              (614)
+#define EVEYE_CFG_GET_QM                 (615)
 #define EVEYE_CFG_GET_WIDTH              (701)
 #define EVEYE_CFG_GET_HEIGHT             (702)
 #define EVEYE_CFG_GET_RECON              (703)
@@ -308,13 +340,28 @@ typedef struct _EVEY_BITB
  *****************************************************************************/
 typedef struct _EVEYD_CDSC
 {
-    int            __na; /* nothing */
+    /* instruction set of the kernel table (EVEY_ISA_XXX), lowered to the
+       highest level supported by the CPU and with kernels of its own; the
+       selected level is given by the GET_ISA config.
+       the table is shared by all instances of the process */
+    int            isa;
+    /* threads reconstructing the CTU rows of a slice in wavefront order
+       while the calling thread parses it (0: parse and reconstruct on the
+       calling thread) */
+    int            recon_threads;
 
 } EVEYD_CDSC;
 
 /*****************************************************************************
  * status after decoder operation
  *****************************************************************************/
+/* decoding stages timed in EVEYD_STAT.stage_ns[] */
+#define EVEYD_STAGE_ECO                    0 /* entropy decoding (parsing) */
+#define EVEYD_STAGE_RECON                  1 /* prediction and reconstruction */
+#define EVEYD_STAGE_DBK                    2 /* deblocking filter */
+#define EVEYD_STAGE_PICMAN                 3 /* picture management */
+#define EVEYD_STAGE_NUM                    4
+
 typedef struct _EVEYD_STAT
 {
     /* byte size of decoded bitstream (read size of bitstream) */
@@ -335,8 +382,33 @@ typedef struct _EVEYD_STAT
     unsigned char  refpic_num[2];
     /* list of reference pictures */
     int            refpic[2][16];
+    /* wall time in nanoseconds spent in each stage (EVEYD_STAGE_XXX) */
+    long long      stage_ns[EVEYD_STAGE_NUM];
 } EVEYD_STAT;
 
+/* statistics counters accumulated since the decoder was created
+   (EVEYD_CFG_GET_STATS) */
+#define EVEYD_STATS_CU_DEPTH_NUM           9 /* coding tree depth, 2 per quad split */
+#define EVEYD_STATS_IPD_NUM                5 /* intra prediction modes */
+
+typedef struct _EVEYD_STATS
+{
+    /* number of decoded frames */
+    long long      frames;
+    /* decoded CUs at each coding tree depth */
+    long long      cu_cnt[EVEYD_STATS_CU_DEPTH_NUM];
+    /* decoded intra CUs for each luma intra prediction mode */
+    long long      intra_cu_cnt[EVEYD_STATS_IPD_NUM];
+    /* decoded inter CUs, skip CUs included */
+    long long      inter_cu_cnt;
+    /* decoded skip CUs */
+    long long      skip_cu_cnt;
+    /* deblocked edge segments of 4 luma samples */
+    long long      dbk_edge_cnt;
+    /* wall time in nanoseconds spent in each stage (EVEYD_STAGE_XXX) */
+    long long      stage_ns[EVEYD_STAGE_NUM];
+} EVEYD_STATS;
+
 typedef struct _EVEYD_OPL
 {
     int            poc;
@@ -421,12 +493,61 @@ typedef struct _EVEYE_CDSC
     /* RDOQ */
     int            use_rdoq;
     int            nn_base_port;
+    /* instruction set of the kernel table (EVEY_ISA_XXX), lowered to the
+       highest level supported by the CPU and with kernels of its own; the
+       selected level is given by the GET_ISA config.
+       the table is shared by all instances of the process */
+    int            isa;
+    /* run the entropy coding of CTUs on a second thread, pipelined with
+       mode decision (0: off, 1: on). not used when cu_qp_delta is on */
+    int            eco_thread;
+    /* quality metrics computed for each picture by a helper thread
+       (EVEYE_QM_XXX flags, 0: none) */
+    int            quality_metric;
+    /* CTU rows of each slice (0: one slice per picture). each slice is
+       a tile and is handed to the NAL sink as soon as it is coded */
+    int            slice_ctu_rows;
 
 } EVEYE_CDSC;
 
 /*****************************************************************************
  * status after encoder operation
  *****************************************************************************/
+/* quality metrics of EVEYE_CDSC.quality_metric, measured between the
+   reconstructed and the original picture at the codec bit depth */
+#define EVEYE_QM_PSNR                      (1 << 0)
+#define EVEYE_QM_SSIM                      (1 << 1)
+#define EVEYE_QM_MS_SSIM                   (1 << 2) /* luma only */
+
+typedef struct _EVEYE_QM
+{
+    /* metrics set (EVEYE_QM_XXX), 0 when none are returned */
+    int            metric;
+    /* picture number (EVEYE_STAT.fnum) and POC of the measured picture */
+    unsigned long  fnum;
+    int            poc;
+    /* per plane, in dB; 100 for identical planes */
+    double         psnr[3];
+    /* mean SSIM of 8x8 windows at a step of 4, per plane */
+    double         ssim[3];
+    /* SSIM over five scales, from the same windows */
+    double         ms_ssim;
+
+} EVEYE_QM;
+
+/* encoding stages timed in EVEYE_STAT.stage_ns[].
+   intra, inter and ME are parts of mode decision,
+   ME is a part of inter and NN wait is a part of intra */
+#define EVEYE_STAGE_MODE                   0 /* mode decision */
+#define EVEYE_STAGE_INTRA                  1 /* intra prediction RDO */
+#define EVEYE_STAGE_INTER                  2 /* inter prediction RDO */
+#define EVEYE_STAGE_ME                     3 /* motion estimation */
+#define EVEYE_STAGE_NN                     4 /* waiting for the NN predictor server */
+#define EVEYE_STAGE_ECO                    5 /* entropy coding */
+#define EVEYE_STAGE_DBK                    6 /* deblocking filter */
+#define EVEYE_STAGE_PICMAN                 7 /* picture management */
+#define EVEYE_STAGE_NUM                    8
+
 typedef struct _EVEYE_STAT
 {
     /* encoded bitstream byte size */
@@ -449,9 +570,101 @@ typedef struct _EVEYE_STAT
     int            refpic_num[2];
     /* list of reference pictures */
     int            refpic[2][16];
+    /* wall time in nanoseconds spent in each stage (EVEYE_STAGE_XXX) */
+    long long      stage_ns[EVEYE_STAGE_NUM];
+    /* quality metrics of the picture encoded by the previous call, as they
+       are computed while this picture is encoded. those of the last
+       picture are taken with EVEYE_CFG_GET_QM */
+    EVEYE_QM       qm;
 
 } EVEYE_STAT;
 
+/* statistics counters accumulated since the encoder was created
+   (EVEYE_CFG_GET_STATS) */
+#define EVEYE_STATS_CU_DEPTH_NUM           9 /* coding tree depth, 2 per quad split */
+#define EVEYE_STATS_IPD_NUM                5 /* intra prediction modes */
+
+typedef struct _EVEYE_STATS
+{
+    /* number of encoded frames */
+    long long      frames;
+    /* CUs evaluated by mode decision at each coding tree depth */
+    long long      cu_cnt[EVEYE_STATS_CU_DEPTH_NUM];
+    /* full RDO evaluations of each luma intra prediction mode */
+    long long      intra_rdo_cnt[EVEYE_STATS_IPD_NUM];
+    /* motion searches (one per CU, list and reference) and
+       search points evaluated by them */
+    long long      me_cnt;
+    long long      me_pts;
+    /* SBAC rate estimations and sum of the estimated bits */
+    long long      sbac_est_cnt;
+    long long      sbac_est_bits;
+    /* deblocked edge segments of 4 luma samples */
+    long long      dbk_edge_cnt;
+    /* wall time in nanoseconds spent in each stage (EVEYE_STAGE_XXX) */
+    long long      stage_ns[EVEYE_STAGE_NUM];
+
+} EVEYE_STATS;
+
+/*****************************************************************************
+ * NAL unit output of encoder
+ *****************************************************************************/
+/* flags of a chunk given to the NAL sink */
+#define EVEYE_NAL_BEGIN                    (1 << 0) /* first chunk of a NAL unit */
+#define EVEYE_NAL_END                      (1 << 1) /* last chunk of a NAL unit */
+
+/* fn_sink is called during eveye_encode() with the NAL units of the picture
+   as they are completed, in bitstream order. data points into the
+   bitstream buffer given to eveye_encode() and excludes the 4-byte NAL
+   unit size preceding each NAL unit there; nalu_type is the EVEY_XXX_NUT
+   of the NAL unit. with row set, the slice data is given in chunks as its
+   CTU rows are entropy coded, from the entropy coding thread when it is
+   used; calls never overlap. a negative return value fails eveye_encode() */
+typedef struct _EVEYE_NAL_SINK
+{
+    int            (* fn_sink)(void * opaque, const unsigned char * data, int size,
+                               int nalu_type, int flag);
+    void         * opaque;
+    int            row;
+} EVEYE_NAL_SINK;
+
+/*****************************************************************************
+ * memory allocator
+ *****************************************************************************/
+/* allocator used for all memory of the library. align is a power of two.
+   all fields NULL selects the C library heap */
+typedef struct _EVEY_MEM_FN
+{
+    void         * (* fn_alloc)(void * opaque, size_t size, size_t align);
+    void           (* fn_free)(void * opaque, void * ptr);
+    void         * opaque;
+} EVEY_MEM_FN;
+
+/* memory counters accumulated since the process started */
+typedef struct _EVEY_MEM_STATS
+{
+    /* successful allocations, and bytes requested by them */
+    long long      alloc_cnt;
+    long long      alloc_bytes;
+    /* blocks released; planes kept in the pool are not released */
+    long long      free_cnt;
+    /* picture planes taken from the pool, and allocated for a pool miss */
+    long long      pool_hit;
+    long long      pool_miss;
+    /* planes kept in the pool for reuse, and their size in bytes */
+    long long      pool_cnt;
+    long long      pool_bytes;
+} EVEY_MEM_STATS;
+
+/* install the allocator; must be called while no encoder or decoder
+   instance exists. pooled picture planes are released first */
+int evey_mem_set_fn(EVEY_MEM_FN * fn);
+void evey_mem_get_stats(EVEY_MEM_STATS * stats);
+/* release the picture planes kept in the pool. the pool is shared by the
+   instances of the process and outlives them: up to 64 planes and 1 GiB
+   stay allocated after the last instance is deleted until this is called */
+void evey_mem_pool_trim(void);
+
 /*****************************************************************************
  * API for decoder
  *****************************************************************************/
@@ -40,11 +40,13 @@
 #define OPT_SIMD_MC_C                      1
 #define OPT_SIMD_SAD                       1
 #define OPT_SIMD_HAD_SAD                   1
+#define OPT_SIMD_QUANT                     1
 #else
 #define OPT_SIMD_MC_L                      0
 #define OPT_SIMD_MC_C                      0 
 #define OPT_SIMD_SAD                       0
 #define OPT_SIMD_HAD_SAD                   0
+#define OPT_SIMD_QUANT                     0
 #endif
 
 #define MAX_NUM_PPS                        64
@@ -183,6 +185,32 @@ typedef enum _EVEY_MV_COMPONENT
 /* pixel position to SCB position */
 #define PEL2SCU(pel)                       ((pel) >> MIN_CU_LOG2)
 
+/* storage order of the maps in SCU unit (map_scu, map_ipm, map_pred_mode,
+   map_mv, map_refi and the motion maps of pictures)
+   0: raster over the whole picture
+   1: CTU by CTU, raster inside each CTU, so that a CU and its neighbours
+      stay within a few cache lines on wide pictures
+   the maps are indexed through SCU_IDX() only, and stepped by SCU_STRIDE()
+   from one SCU row to the next inside a CTU */
+#ifndef MAP_CTU_TILED
+#define MAP_CTU_TILED                      0
+#endif
+
+#define CTU_SCU_LOG2                       (MAX_CU_LOG2 - MIN_CU_LOG2)
+#define CTU_SCU_MASK                       ((1 << CTU_SCU_LOG2) - 1)
+#if MAP_CTU_TILED
+#define SCU_IDX(x_scu, y_scu, w_scu) \
+    (((((y_scu) >> CTU_SCU_LOG2) * (((w_scu) + CTU_SCU_MASK) >> CTU_SCU_LOG2) + ((x_scu) >> CTU_SCU_LOG2)) \
+      << (CTU_SCU_LOG2 << 1)) + (((y_scu) & CTU_SCU_MASK) << CTU_SCU_LOG2) + ((x_scu) & CTU_SCU_MASK))
+#define SCU_STRIDE(w_scu)                  (1 << CTU_SCU_LOG2)
+#define SCU_MAP_SIZE(w_scu, h_scu) \
+    ((((w_scu) + CTU_SCU_MASK) & ~CTU_SCU_MASK) * (((h_scu) + CTU_SCU_MASK) & ~CTU_SCU_MASK))
+#else
+#define SCU_IDX(x_scu, y_scu, w_scu)       ((x_scu) + (y_scu) * (w_scu))
+#define SCU_STRIDE(w_scu)                  (w_scu)
+#define SCU_MAP_SIZE(w_scu, h_scu)         ((w_scu) * (h_scu))
+#endif
+
 /* padding size of reference pictures */
 #define PIC_PAD_SIZE_L                     (128 + 16)                /* TBD: need to check whether padding size is appropriate */
 #define PIC_PAD_SIZE_C                     (PIC_PAD_SIZE_L >> 1)
@@ -193,8 +221,9 @@ typedef enum _EVEY_MV_COMPONENT
 /* maximum picture buffer size */
 #define MAX_PB_SIZE                        (MAX_NUM_REF_PICS + 5) /* TBD: Should be checked */
 
-/* maximum tiles in row or col */
-#define MAX_NUM_TILES_ROW                  1
+/* maximum tile rows and columns; tiles span the picture width and a slice
+   holds one tile, so a tile row may be as short as a CTU row */
+#define MAX_NUM_TILES_ROW                  128
 #define MAX_NUM_TILES_COL                  1
 
 /* Neighboring block availability flag bits */
@@ -686,8 +715,9 @@ typedef struct _EVEY_PPS
     int              num_tile_columns_minus1;
     int              num_tile_rows_minus1;
     int              uniform_tile_spacing_flag;
-    int              tile_column_width_minus1[MAX_NUM_TILES_ROW];
-    int              tile_row_height_minus1[MAX_NUM_TILES_COL];
+    int              tile_column_width_minus1[MAX_NUM_TILES_COL];
+    int              tile_row_height_minus1[MAX_NUM_TILES_ROW];
+    int              loop_filter_across_tiles_enabled_flag;
     int              tile_offset_lens_minus1;
     int              tile_id_len_minus1;
     int              explicit_tile_id_flag;
@@ -706,6 +736,7 @@ typedef struct _EVEY_PPS
 typedef struct _EVEY_SH
 {
     int              slice_pic_parameter_set_id;
+    int              single_tile_in_slice_flag;
     int              first_tile_id;
     int              slice_type;
     int              no_output_of_prior_pics_flag;
@@ -858,7 +889,8 @@ typedef struct _EVEY_CTX
     u16              w_scu;
     /* picture height in SCU unit */
     u16              h_scu;
-    /* picture size in SCU unit (= w_scu * h_scu) */
+    /* number of entries of the maps in SCU unit (= w_scu * h_scu, padded
+       to whole CTUs with MAP_CTU_TILED) */
     u32              f_scu;
     /* the picture order count value */
     EVEY_POC         poc;
@@ -891,6 +923,10 @@ typedef struct _EVEY_CTX
     s8            (* map_split)[NUM_CU_DEPTH][NUM_BLOCK_SHAPE][MAX_CU_CNT_IN_CTU];
     /* map for CU mode */
     u8             * map_pred_mode;
+    /* buffers living as long as the sequence, released all together */
+    EVEY_ARENA       arena;
+    /* number of deblocked edge segments of 4 luma samples */
+    u64              dbk_edge_cnt;
 
 } EVEY_CTX;
 
@@ -902,5 +938,6 @@ typedef struct _EVEY_CTX
 #include "evey_inter.h"
 #include "evey_itdq.h"
 #include "evey_picman.h"
+#include "evey_dispatch.h"
 
 #endif /* _EVEY_DEF_H_ */
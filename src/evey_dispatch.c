@@ -0,0 +1,202 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "evey_def.h"
+
+#if X86_SSE
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+EVEY_KFN evey_kfn =
+{
+    /* mc_l */
+    {
+        {evey_mc_l_00, evey_mc_l_0n},
+        {evey_mc_l_n0, evey_mc_l_nn}
+    },
+    /* mc_c */
+    {
+        {evey_mc_c_00, evey_mc_c_0n},
+        {evey_mc_c_n0, evey_mc_c_nn}
+    },
+    /* average_no_clip */
+    evey_average_16b_no_clip
+};
+
+#if X86_SSE
+static void cpuid(int leaf, int sub, u32 reg[4])
+{
+#if defined(_MSC_VER)
+    __cpuidex((int *)reg, leaf, sub);
+#else
+    __cpuid_count(leaf, sub, reg[0], reg[1], reg[2], reg[3]);
+#endif
+}
+
+/* register state enabled by the OS */
+static u64 xgetbv0(void)
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    u32 eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((u64)edx << 32) | eax;
+#endif
+}
+
+static int cpu_detect(void)
+{
+    u32 reg[4];
+    u32 max_leaf;
+    u64 xcr0 = 0;
+    int feat = 0;
+
+    cpuid(0, 0, reg);
+    max_leaf = reg[0];
+    if(max_leaf < 1) return 0;
+
+    cpuid(1, 0, reg);
+    if(reg[3] & (1 << 26)) feat |= EVEY_CPU_SSE2;
+    if(reg[2] & (1 <<  9)) feat |= EVEY_CPU_SSSE3;
+    if(reg[2] & (1 << 19)) feat |= EVEY_CPU_SSE41;
+    if(reg[2] & (1 << 20)) feat |= EVEY_CPU_SSE42;
+
+    /* AVX needs the OS to save YMM state as well */
+    if((reg[2] & (1 << 27)) && (reg[2] & (1 << 28)))
+    {
+        xcr0 = xgetbv0();
+        if((xcr0 & 0x6) == 0x6) feat |= EVEY_CPU_AVX;
+    }
+    if((feat & EVEY_CPU_AVX) && max_leaf >= 7)
+    {
+        cpuid(7, 0, reg);
+        if(reg[1] & (1 << 5)) feat |= EVEY_CPU_AVX2;
+        /* F(16), DQ(17), BW(30), VL(31) and opmask/ZMM state */
+        if((reg[1] & 0xC0030000) == 0xC0030000 && (xcr0 & 0xE6) == 0xE6)
+        {
+            feat |= EVEY_CPU_AVX512;
+        }
+    }
+    return feat;
+}
+#endif
+
+int evey_cpu_features(void)
+{
+    static int feat = -1;
+
+    /* a racing first call only stores the same value twice */
+    if(feat < 0)
+    {
+#if X86_SSE
+        feat = cpu_detect();
+#else
+        feat = 0;
+#endif
+    }
+    return feat;
+}
+
+int evey_isa_max(void)
+{
+    int feat = evey_cpu_features();
+    int isa = EVEY_ISA_C;
+
+    if((feat & EVEY_CPU_SSE41) && (feat & EVEY_CPU_SSE42))
+    {
+        isa = EVEY_ISA_SSE4;
+        if(feat & EVEY_CPU_AVX2)
+        {
+            isa = (feat & EVEY_CPU_AVX512) ? EVEY_ISA_AVX512 : EVEY_ISA_AVX2;
+        }
+    }
+    return EVEY_MIN(isa, EVEY_ISA_KFN_MAX);
+}
+
+const char * evey_isa_name(int isa)
+{
+    switch(isa)
+    {
+        case EVEY_ISA_AUTO:   return "auto";
+        case EVEY_ISA_C:      return "c";
+        case EVEY_ISA_SSE4:   return "sse4";
+        case EVEY_ISA_AVX2:   return "avx2";
+        case EVEY_ISA_AVX512: return "avx512";
+        default:              return "unknown";
+    }
+}
+
+void evey_kfn_init_c(EVEY_KFN * kfn)
+{
+    kfn->mc_l[0][0] = evey_mc_l_00;
+    kfn->mc_l[0][1] = evey_mc_l_0n;
+    kfn->mc_l[1][0] = evey_mc_l_n0;
+    kfn->mc_l[1][1] = evey_mc_l_nn;
+    kfn->mc_c[0][0] = evey_mc_c_00;
+    kfn->mc_c[0][1] = evey_mc_c_0n;
+    kfn->mc_c[1][0] = evey_mc_c_n0;
+    kfn->mc_c[1][1] = evey_mc_c_nn;
+    kfn->average_no_clip = evey_average_16b_no_clip;
+}
+
+int evey_kfn_init(int isa)
+{
+    EVEY_KFN kfn;
+    int      isa_max;
+
+    /* the table is shared by all the instances: it is only rewritten when
+       another instruction set is asked for */
+    evey_global_lock();
+    isa_max = evey_isa_max();
+    if(isa <= EVEY_ISA_AUTO || isa > isa_max)
+    {
+        isa = isa_max;
+    }
+
+    evey_kfn_init_c(&kfn);
+#if X86_SSE
+    if(isa >= EVEY_ISA_SSE4)
+    {
+        evey_kfn_init_sse(&kfn);
+    }
+#endif
+
+    if(memcmp(&evey_kfn, &kfn, sizeof(EVEY_KFN)))
+    {
+        evey_kfn = kfn;
+    }
+    evey_global_unlock();
+    return isa;
+}
@@ -0,0 +1,96 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _EVEY_DISPATCH_H_
+#define _EVEY_DISPATCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*****************************************************************************
+ * cpu features
+ *****************************************************************************/
+#define EVEY_CPU_SSE2                 (1 << 0)
+#define EVEY_CPU_SSSE3                (1 << 1)
+#define EVEY_CPU_SSE41                (1 << 2)
+#define EVEY_CPU_SSE42                (1 << 3)
+#define EVEY_CPU_AVX                  (1 << 4)
+#define EVEY_CPU_AVX2                 (1 << 5)
+/* AVX-512 F, BW, DQ and VL together */
+#define EVEY_CPU_AVX512               (1 << 6)
+
+/* features of the running CPU (EVEY_CPU_XXX), detected once */
+int evey_cpu_features(void);
+
+/*****************************************************************************
+ * kernel table
+ *
+ * Every SIMD-capable kernel is called through a table filled once by
+ * evey_kfn_init(). The C kernels are registered first, then each ISA level
+ * up to the selected one overrides the entries it implements, so a level
+ * without a kernel of its own falls back to the next lower one.
+ * Each ISA level lives in its own translation unit, which is the only one
+ * built with that level's code generation flags.
+ *****************************************************************************/
+typedef struct _EVEY_KFN
+{
+    /* motion compensation, index: [dx != 0][dy != 0] */
+    EVEY_MC_L          mc_l[2][2];
+    EVEY_MC_C          mc_c[2][2];
+    /* average of bi-prediction */
+    EVEY_FN_AVG        average_no_clip;
+
+} EVEY_KFN;
+
+extern EVEY_KFN evey_kfn;
+
+/* select ISA level (EVEY_ISA_XXX) and fill evey_kfn; returns the selected
+   level, which is lowered to what the CPU and the build support */
+int evey_kfn_init(int isa);
+/* highest ISA level with kernels of its own; the levels above it would
+   only run its entries, so they are not selected */
+#define EVEY_ISA_KFN_MAX                EVEY_ISA_SSE4
+
+/* highest ISA level supported by both the CPU and the build */
+int evey_isa_max(void);
+const char * evey_isa_name(int isa);
+
+void evey_kfn_init_c(EVEY_KFN * kfn);
+#if X86_SSE
+void evey_kfn_init_sse(EVEY_KFN * kfn);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _EVEY_DISPATCH_H_ */
@@ -37,18 +37,41 @@ extern "C"
 {
 #endif
 
+#define MAC_SFT_N0             (6)
+#define MAC_ADD_N0             (1 << (MAC_SFT_N0 - 1))
+
+#define MAC_SFT_0N             MAC_SFT_N0
+#define MAC_ADD_0N             MAC_ADD_N0
+
+/* padding for store intermediate values, which should be larger than
+1+ half of filter tap */
+#define MC_IBUF_PAD_C          8
+#define MC_IBUF_PAD_L          8
+
+extern const s16 evey_tbl_mc_l_coeff[16][8];
+extern const s16 evey_tbl_mc_c_coeff[32][4];
+
 typedef void(*EVEY_MC_L) (pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
 typedef void(*EVEY_MC_C) (pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+typedef void(*EVEY_FN_AVG)(pel * src0, pel * src1, pel * dst, int s_src0, int s_src1, int s_dst, int w, int h, int bit_depth);
 
-extern EVEY_MC_L evey_tbl_mc_l[2][2];
-extern EVEY_MC_C evey_tbl_mc_c[2][2];
+/* C kernels, registered by evey_kfn_init_c() */
+void evey_mc_l_00(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_mc_l_n0(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_mc_l_0n(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_mc_l_nn(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_mc_c_00(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_mc_c_n0(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_mc_c_0n(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_mc_c_nn(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth);
+void evey_average_16b_no_clip(pel * src0, pel * src1, pel * dst, int s_src0, int s_src1, int s_dst, int w, int h, int bit_depth);
 
 #define evey_mc_l(ori_mv_x, ori_mv_y, ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth) \
-        (evey_tbl_mc_l[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2) | ((ori_mv_x)>>3)) & 0x1]) \
+        (evey_kfn.mc_l[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2) | ((ori_mv_x)>>3)) & 0x1]) \
                       [((ori_mv_y) | ((ori_mv_y)>>1) | ((ori_mv_y)>>2) | ((ori_mv_y)>>3)) & 0x1] \
                       (ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth)
 #define evey_mc_c(ori_mv_x, ori_mv_y, ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth) \
-        (evey_tbl_mc_c[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2)| ((ori_mv_x)>>3) | ((ori_mv_x)>>4)) & 0x1] \
+        (evey_kfn.mc_c[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2)| ((ori_mv_x)>>3) | ((ori_mv_x)>>4)) & 0x1] \
                       [((ori_mv_y) | ((ori_mv_y)>>1) | ((ori_mv_y)>>2) | ((ori_mv_y)>>3) | ((ori_mv_y)>>4)) & 0x1]) \
                       (ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth)
 
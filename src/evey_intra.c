@@ -137,7 +137,7 @@ void evey_get_nbr(void * ctx, void * core, pel * src, int s_src, EVEY_COMPONENT
 
     /* fill above-left sample */
     tmp = src - s_src - 1;
-    if(IS_AVAIL(c_core->avail_cu, AVAIL_UP_LE) && (!cip || MCU_GET_IF(c_ctx->map_scu[c_core->scup - c_ctx->w_scu - 1])))
+    if(IS_AVAIL(c_core->avail_cu, AVAIL_UP_LE) && (!cip || MCU_GET_IF(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu - 1, c_ctx->w_scu)])))
     {
         left[-1] = up[-1] = *tmp;
     }
@@ -151,7 +151,7 @@ void evey_get_nbr(void * ctx, void * core, pel * src, int s_src, EVEY_COMPONENT
     for(i = 0; i < (scuw + scuh); i++)
     {
         int is_avail = (c_core->y_scu > 0) && (c_core->x_scu + i < c_ctx->w_scu);
-        if(is_avail && MCU_GET_COD(c_ctx->map_scu[c_core->scup - c_ctx->w_scu + i]) && (!cip || MCU_GET_IF(c_ctx->map_scu[c_core->scup - c_ctx->w_scu + i])))
+        if(is_avail && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu + i, c_core->y_scu - 1, c_ctx->w_scu)]) && (!cip || MCU_GET_IF(c_ctx->map_scu[SCU_IDX(c_core->x_scu + i, c_core->y_scu - 1, c_ctx->w_scu)])))
         {
             evey_mcpy(up, tmp, unit_size * sizeof(pel));
         }
@@ -168,7 +168,7 @@ void evey_get_nbr(void * ctx, void * core, pel * src, int s_src, EVEY_COMPONENT
     for(i = 0; i < (scuh + scuw); ++i)
     {
         int is_avail = (c_core->x_scu > 0) && (c_core->y_scu + i < c_ctx->h_scu);
-        if(is_avail && MCU_GET_COD(c_ctx->map_scu[c_core->scup - 1 + i * c_ctx->w_scu]) && (!cip || MCU_GET_IF(c_ctx->map_scu[c_core->scup - 1 + i * c_ctx->w_scu])))
+        if(is_avail && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu + i, c_ctx->w_scu)]) && (!cip || MCU_GET_IF(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu + i, c_ctx->w_scu)])))
         {
             for(j = 0; j < unit_size; ++j)
             {
@@ -218,13 +218,13 @@ void evey_get_mpm(void * ctx, void * core)
     u8          ipm_l = IPD_DC;
     u8          ipm_u = IPD_DC;
 
-    if(c_core->x_scu > 0 && MCU_GET_IF(c_ctx->map_scu[c_core->scup - 1]) && MCU_GET_COD(c_ctx->map_scu[c_core->scup - 1]))
+    if(c_core->x_scu > 0 && MCU_GET_IF(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)]) && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)]))
     {
-        ipm_l = c_ctx->map_ipm[c_core->scup - 1] + 1;
+        ipm_l = c_ctx->map_ipm[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)] + 1;
     }
-    if(c_core->y_scu > 0 && MCU_GET_IF(c_ctx->map_scu[c_core->scup - c_ctx->w_scu]) && MCU_GET_COD(c_ctx->map_scu[c_core->scup - c_ctx->w_scu]))
+    if(c_core->y_scu > 0 && MCU_GET_IF(c_ctx->map_scu[SCU_IDX(c_core->x_scu, c_core->y_scu - 1, c_ctx->w_scu)]) && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu, c_core->y_scu - 1, c_ctx->w_scu)]))
     {
-        ipm_u = c_ctx->map_ipm[c_core->scup - c_ctx->w_scu] + 1;
+        ipm_u = c_ctx->map_ipm[SCU_IDX(c_core->x_scu, c_core->y_scu - 1, c_ctx->w_scu)] + 1;
     }
     c_core->mpm_b_list = (u8*)&evey_tbl_mpm[ipm_l][ipm_u];
 }
@@ -254,7 +254,7 @@ static void deblock_scu_ver_chroma(pel * buf, int qp, int stride, const u8 * tbl
     }
 }
 
-static void deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
+static int deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
                            , int w_scu, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
     pel       * y, *u, *v;
@@ -263,9 +263,11 @@ static void deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
     int         w = cuw >> MIN_CU_LOG2;
     int         h = cuh >> MIN_CU_LOG2;
     u32       * map_scu_tmp;
-    int         j;
+    int         j, up, edge_cnt = 0;
 
-    t = (x_pel >> MIN_CU_LOG2) + (y_pel >> MIN_CU_LOG2) * w_scu;
+    t = SCU_IDX(x_pel >> MIN_CU_LOG2, y_pel >> MIN_CU_LOG2, w_scu);
+    /* offset of the SCU row above the CU */
+    up = y_pel > 0 ? SCU_IDX(x_pel >> MIN_CU_LOG2, (y_pel >> MIN_CU_LOG2) - 1, w_scu) - t : 0;
     map_scu += t;
     map_refi += t;
     map_mv += t;
@@ -280,9 +282,10 @@ static void deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
     /* horizontal filtering */
     if(y_pel > 0)
     {
+        edge_cnt += w;
         for(i = 0; i < (cuw >> MIN_CU_LOG2); i++)
         {
-            tbl_qp_to_st = get_tbl_qp_to_st(map_scu[i], map_scu[i - w_scu], map_refi[i], map_refi[i - w_scu], map_mv[i], map_mv[i - w_scu]);
+            tbl_qp_to_st = get_tbl_qp_to_st(map_scu[i], map_scu[i + up], map_refi[i], map_refi[i + up], map_mv[i], map_mv[i + up]);
 
             qp = MCU_GET_QP(map_scu[i]);
             t = (i << MIN_CU_LOG2);
@@ -307,11 +310,12 @@ static void deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
         {
             MCU_SET_COD(map_scu[j]);
         }
-        map_scu += w_scu;
+        map_scu += SCU_STRIDE(w_scu);
     }
+    return edge_cnt;
 }
 
-static void deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
+static int deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
                            , int w_scu, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
     pel       * y, *u, *v;
@@ -319,12 +323,15 @@ static void deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
     int         i, t, qp, s_l, s_c;
     int         w = cuw >> MIN_CU_LOG2;
     int         h = cuh >> MIN_CU_LOG2;
-    int         j;
+    int         j, le, ri, edge_cnt = 0;
     u32       * map_scu_tmp;
     s8       (* map_refi_tmp)[LIST_NUM];
     s16      (* map_mv_tmp)[LIST_NUM][MV_D];
 
-    t = (x_pel >> MIN_CU_LOG2) + (y_pel >> MIN_CU_LOG2) * w_scu;
+    t = SCU_IDX(x_pel >> MIN_CU_LOG2, y_pel >> MIN_CU_LOG2, w_scu);
+    /* offsets of the SCU columns left and right of the CU */
+    le = x_pel > 0 ? SCU_IDX((x_pel >> MIN_CU_LOG2) - 1, y_pel >> MIN_CU_LOG2, w_scu) - t : 0;
+    ri = SCU_IDX((x_pel >> MIN_CU_LOG2) + w, y_pel >> MIN_CU_LOG2, w_scu) - t;
     map_scu += t;
     map_refi += t;
     map_mv += t;
@@ -341,12 +348,13 @@ static void deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
     map_mv_tmp = map_mv;
 
     /* vertical filtering */
-    if(x_pel > 0 && MCU_GET_COD(map_scu[-1]))
+    if(x_pel > 0 && MCU_GET_COD(map_scu[le]))
     {
+        edge_cnt += h;
         for(i = 0; i < (cuh >> MIN_CU_LOG2); i++)
         {
-            tbl_qp_to_st = get_tbl_qp_to_st(map_scu[0], map_scu[-1], \
-                                            map_refi[0], map_refi[-1], map_mv[0], map_mv[-1]);
+            tbl_qp_to_st = get_tbl_qp_to_st(map_scu[0], map_scu[le], \
+                                            map_refi[0], map_refi[le], map_mv[0], map_mv[le]);
             qp = MCU_GET_QP(map_scu[0]);
 
             deblock_scu_ver(y, qp, s_l, tbl_qp_to_st, bit_depth_luma - 8, chroma_format_idc);
@@ -363,16 +371,16 @@ static void deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
             u += (s_c << (MIN_CU_LOG2 - (GET_CHROMA_W_SHIFT(chroma_format_idc))));
             v += (s_c << (MIN_CU_LOG2 - (GET_CHROMA_W_SHIFT(chroma_format_idc))));
 
-            map_scu += w_scu;
-            map_refi += w_scu;
-            map_mv += w_scu;
+            map_scu += SCU_STRIDE(w_scu);
+            map_refi += SCU_STRIDE(w_scu);
+            map_mv += SCU_STRIDE(w_scu);
         }
     }
 
     map_scu = map_scu_tmp;
     map_refi = map_refi_tmp;
     map_mv = map_mv_tmp;
-    if(x_pel + cuw < pic->w_l && MCU_GET_COD(map_scu[w]))
+    if(x_pel + cuw < pic->w_l && MCU_GET_COD(map_scu[ri]))
     {
         y = pic->y + x_pel + y_pel * s_l;
         u = pic->u + t;
@@ -382,10 +390,11 @@ static void deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
         u += (cuw >> (GET_CHROMA_W_SHIFT(chroma_format_idc)));
         v += (cuw >> (GET_CHROMA_W_SHIFT(chroma_format_idc)));
 
+        edge_cnt += h;
         for(i = 0; i < (cuh >> MIN_CU_LOG2); i++)
         {
-            tbl_qp_to_st = get_tbl_qp_to_st(map_scu[w], map_scu[w - 1], map_refi[w], map_refi[w - 1], map_mv[w], map_mv[w - 1]);
-            qp = MCU_GET_QP(map_scu[w]);
+            tbl_qp_to_st = get_tbl_qp_to_st(map_scu[ri], map_scu[w - 1], map_refi[ri], map_refi[w - 1], map_mv[ri], map_mv[w - 1]);
+            qp = MCU_GET_QP(map_scu[ri]);
             
             deblock_scu_ver(y, qp, s_l, tbl_qp_to_st, bit_depth_luma - 8, chroma_format_idc);
 
@@ -401,9 +410,9 @@ static void deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
             u += (s_c << (MIN_CU_LOG2 - (GET_CHROMA_W_SHIFT(chroma_format_idc))));
             v += (s_c << (MIN_CU_LOG2 - (GET_CHROMA_W_SHIFT(chroma_format_idc))));
 
-            map_scu += w_scu;
-            map_refi += w_scu;
-            map_mv += w_scu;
+            map_scu += SCU_STRIDE(w_scu);
+            map_refi += SCU_STRIDE(w_scu);
+            map_mv += SCU_STRIDE(w_scu);
         }
     }
 
@@ -414,20 +423,21 @@ static void deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cu
         {
             MCU_SET_COD(map_scu[j]);
         }
-        map_scu += w_scu;
+        map_scu += SCU_STRIDE(w_scu);
     }
+    return edge_cnt;
 }
 
-void evey_deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
+int evey_deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
                          , int w_scu, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
-    deblock_cu_hor(pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
+    return deblock_cu_hor(pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
 }
 
-void evey_deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
+int evey_deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
                          , int w_scu, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
-    deblock_cu_ver(pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
+    return deblock_cu_ver(pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
 }
 
 static void deblock_tree(EVEY_CTX * ctx, EVEY_PIC * pic, int x, int y, int cuw, int cuh, int cud, int cup, int is_hor_edge)
@@ -460,18 +470,31 @@ static void deblock_tree(EVEY_CTX * ctx, EVEY_PIC * pic, int x, int y, int cuw,
     {
         if(is_hor_edge)
         {
-            evey_deblock_cu_hor(pic, x, y, cuw, cuh, ctx->map_scu, ctx->map_refi, ctx->map_mv, ctx->w_scu
+            ctx->dbk_edge_cnt += evey_deblock_cu_hor(pic, x, y, cuw, cuh, ctx->map_scu, ctx->map_refi, ctx->map_mv, ctx->w_scu
                                 , ctx->sps.bit_depth_luma_minus8 + 8, ctx->sps.bit_depth_chroma_minus8 + 8, ctx->sps.chroma_format_idc);
 
         }
         else
         {
-            evey_deblock_cu_ver(pic, x, y, cuw, cuh, ctx->map_scu, ctx->map_refi, ctx->map_mv, ctx->w_scu
+            ctx->dbk_edge_cnt += evey_deblock_cu_ver(pic, x, y, cuw, cuh, ctx->map_scu, ctx->map_refi, ctx->map_mv, ctx->w_scu
                                 , ctx->sps.bit_depth_luma_minus8 + 8, ctx->sps.bit_depth_chroma_minus8 + 8, ctx->sps.chroma_format_idc);
         }
     }
 }
 
+static void clr_cod_rows(EVEY_CTX * c, int y_scu, int h_scu)
+{
+    int i, j;
+
+    for(j = y_scu; j < y_scu + h_scu; j++)
+    {
+        for(i = 0; i < c->w_scu; i++)
+        {
+            MCU_CLR_COD(c->map_scu[SCU_IDX(i, j, c->w_scu)]);
+        }
+    }
+}
+
 int evey_deblock(void * ctx)
 {
     EVEY_CTX * c = (EVEY_CTX*)ctx;
@@ -480,13 +503,7 @@ int evey_deblock(void * ctx)
     c->pic->pic_qp_u_offset = c->sh.qp_u_offset;
     c->pic->pic_qp_v_offset = c->sh.qp_v_offset;
 
-    for(j = 0; j < c->h_scu; j++)
-    {
-        for(i = 0; i < c->w_scu; i++)
-        {
-            MCU_CLR_COD(c->map_scu[i + j * c->w_scu]);
-        }
-    }
+    clr_cod_rows(c, 0, c->h_scu);
 
     /* horizontal filtering */
     for(j = 0; j < c->h_ctu; j++)
@@ -497,13 +514,7 @@ int evey_deblock(void * ctx)
         }
     }
 
-    for(j = 0; j < c->h_scu; j++)
-    {
-        for(i = 0; i < c->w_scu; i++)
-        {
-            MCU_CLR_COD(c->map_scu[i + j * c->w_scu]);
-        }
-    }
+    clr_cod_rows(c, 0, c->h_scu);
 
     /* vertical filtering */
     for(j = 0; j < c->h_ctu; j++)
@@ -516,3 +527,33 @@ int evey_deblock(void * ctx)
 
     return EVEY_OK;
 }
+
+/* deblock one CTU row; the same as evey_deblock() for the row once the rows
+   above it are deblocked. the vertical edges of a row only touch the row, and
+   the horizontal edges of the rows above do not reach it, so the row can be
+   filtered as soon as the row below it is reconstructed */
+int evey_deblock_ctu_row(void * ctx, int y_ctu)
+{
+    EVEY_CTX * c = (EVEY_CTX*)ctx;
+    int        i, y_scu, h_scu;
+
+    c->pic->pic_qp_u_offset = c->sh.qp_u_offset;
+    c->pic->pic_qp_v_offset = c->sh.qp_v_offset;
+
+    y_scu = y_ctu << (c->log2_ctu_size - MIN_CU_LOG2);
+    h_scu = EVEY_MIN(1 << (c->log2_ctu_size - MIN_CU_LOG2), c->h_scu - y_scu);
+
+    clr_cod_rows(c, y_scu, h_scu);
+    for(i = 0; i < c->w_ctu; i++)
+    {
+        deblock_tree(ctx, c->pic, (i << c->log2_ctu_size), (y_ctu << c->log2_ctu_size), c->ctu_size, c->ctu_size, 0, 0, 0);
+    }
+
+    clr_cod_rows(c, y_scu, h_scu);
+    for(i = 0; i < c->w_ctu; i++)
+    {
+        deblock_tree(ctx, c->pic, (i << c->log2_ctu_size), (y_ctu << c->log2_ctu_size), c->ctu_size, c->ctu_size, 0, 0, 1);
+    }
+
+    return EVEY_OK;
+}
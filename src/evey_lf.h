@@ -38,13 +38,14 @@ extern "C"
 
 #include "evey_def.h"
  
-void evey_deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
+int evey_deblock_cu_hor(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
                          , int w_scu, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc);
 
-void evey_deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
+int evey_deblock_cu_ver(EVEY_PIC * pic, int x_pel, int y_pel, int cuw, int cuh, u32 * map_scu, s8 (* map_refi)[LIST_NUM], s16 (* map_mv)[LIST_NUM][MV_D]
                          , int w_scu, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc);
 
 int evey_deblock(void * ctx);
+int evey_deblock_ctu_row(void * ctx, int y_ctu);
 
 #ifdef __cplusplus
 }
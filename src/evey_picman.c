@@ -415,6 +415,12 @@ int evey_picman_refp_init(void * ctx)
     return EVEY_OK;
 }
 
+int evey_picman_has_empty_pic(EVEY_PM * pm)
+{
+    return picman_get_empty_pic_from_list(pm) >= 0 ||
+           picman_get_num_allocated_pics(pm) < pm->max_pb_size;
+}
+
 EVEY_PIC * evey_picman_get_empty_pic(EVEY_PM * pm, int * err)
 {
     int        ret;
@@ -34,6 +34,9 @@
 
  /*Declaration for ref pic marking and ref pic list construction functions */
 int evey_picman_refp_init(void * ctx);
+/* whether evey_picman_get_empty_pic() can return a picture without
+   waiting for a picture buffer to be released */
+int evey_picman_has_empty_pic(EVEY_PM * pm);
 EVEY_PIC * evey_picman_get_empty_pic(EVEY_PM * pm, int * err);
 int evey_picman_put_pic(void * ctx, EVEY_PIC * pic, int need_for_output);
 EVEY_PIC * evey_picman_out_pic(EVEY_PM * pm, int * err);
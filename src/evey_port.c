@@ -28,8 +28,44 @@
    POSSIBILITY OF SUCH DAMAGE.
 */
 
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L /* clock_gettime(), nanosleep(), pthread */
+#endif
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE /* madvise() */
+#endif
+
+#include "evey.h"
 #include "evey_port.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+s64 evey_time_ns(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER        cnt;
+
+    if(freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&cnt);
+    return (s64)((double)cnt.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (s64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
 
 void evey_trace0(char * filename, int line, const char * fmt, ...)
 {
@@ -59,3 +95,398 @@ void evey_trace_line(char * pre)
     str[chars] = '\0';
     printf("%s\n", str);
 }
+
+typedef struct _EVEY_THREAD_CTX
+{
+#ifdef _WIN32
+    HANDLE       handle;
+#else
+    pthread_t    handle;
+#endif
+    int       (* fn)(void * arg);
+    void       * arg;
+    int          ret;
+} EVEY_THREAD_CTX;
+
+#ifdef _WIN32
+static DWORD WINAPI thread_entry(LPVOID param)
+{
+    EVEY_THREAD_CTX * th = (EVEY_THREAD_CTX *)param;
+
+    th->ret = th->fn(th->arg);
+    return 0;
+}
+#else
+static void * thread_entry(void * param)
+{
+    EVEY_THREAD_CTX * th = (EVEY_THREAD_CTX *)param;
+
+    th->ret = th->fn(th->arg);
+    return NULL;
+}
+#endif
+
+EVEY_THREAD evey_thread_create(int (*fn)(void * arg), void * arg)
+{
+    EVEY_THREAD_CTX * th;
+
+    th = (EVEY_THREAD_CTX *)evey_malloc(sizeof(EVEY_THREAD_CTX));
+    evey_assert_rv(th != NULL, NULL);
+
+    th->fn = fn;
+    th->arg = arg;
+    th->ret = 0;
+#ifdef _WIN32
+    th->handle = CreateThread(NULL, 0, thread_entry, th, 0, NULL);
+    if(th->handle == NULL)
+#else
+    if(pthread_create(&th->handle, NULL, thread_entry, th) != 0)
+#endif
+    {
+        evey_mfree(th);
+        return NULL;
+    }
+    return (EVEY_THREAD)th;
+}
+
+int evey_thread_join(EVEY_THREAD thread)
+{
+    EVEY_THREAD_CTX * th = (EVEY_THREAD_CTX *)thread;
+    int               ret;
+
+#ifdef _WIN32
+    WaitForSingleObject(th->handle, INFINITE);
+    CloseHandle(th->handle);
+#else
+    pthread_join(th->handle, NULL);
+#endif
+    ret = th->ret;
+    evey_mfree(th);
+    return ret;
+}
+
+void evey_thread_wait(int spin)
+{
+#ifdef _WIN32
+    Sleep(spin < 64 ? 0 : 1);
+#else
+    if(spin < 64)
+    {
+        sched_yield();
+    }
+    else
+    {
+        struct timespec ts = {0, 20000};
+        nanosleep(&ts, NULL);
+    }
+#endif
+}
+
+int evey_atomic_load(volatile int * p)
+{
+#ifdef _WIN32
+    return InterlockedCompareExchange((volatile LONG *)p, 0, 0);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void evey_atomic_store(volatile int * p, int v)
+{
+#ifdef _WIN32
+    InterlockedExchange((volatile LONG *)p, v);
+#else
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+#endif
+}
+
+#ifdef _WIN32
+static SRWLOCK         global_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+void evey_global_lock(void)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&global_lock);
+#else
+    pthread_mutex_lock(&global_lock);
+#endif
+}
+
+void evey_global_unlock(void)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&global_lock);
+#else
+    pthread_mutex_unlock(&global_lock);
+#endif
+}
+
+/*****************************************************************************
+ * memory allocator
+ *****************************************************************************/
+#define MEM_PAGE_SIZE                   ((size_t)4096)
+#define MEM_HUGE_PAGE_SIZE              ((size_t)2 << 20)
+/* planes kept by the pool at most */
+#define MEM_POOL_MAX_CNT                64
+#define MEM_POOL_MAX_BYTES              ((size_t)1 << 30)
+
+typedef struct _MEM_POOL_ITEM
+{
+    void                  * ptr;
+    size_t                  size;
+} MEM_POOL_ITEM;
+
+static EVEY_MEM_FN    mem_fn;
+static EVEY_MEM_STATS mem_stats;
+static MEM_POOL_ITEM  mem_pool[MEM_POOL_MAX_CNT];
+#ifdef _WIN32
+static SRWLOCK        mem_lock = SRWLOCK_INIT;
+#define MEM_LOCK()                      AcquireSRWLockExclusive(&mem_lock)
+#define MEM_UNLOCK()                    ReleaseSRWLockExclusive(&mem_lock)
+#else
+static pthread_mutex_t mem_lock = PTHREAD_MUTEX_INITIALIZER;
+#define MEM_LOCK()                      pthread_mutex_lock(&mem_lock)
+#define MEM_UNLOCK()                    pthread_mutex_unlock(&mem_lock)
+#endif
+
+static void mem_cnt_add(volatile long long * cnt, long long v)
+{
+#ifdef _WIN32
+    InterlockedExchangeAdd64((volatile LONG64 *)cnt, v);
+#else
+    __atomic_fetch_add(cnt, v, __ATOMIC_RELAXED);
+#endif
+}
+
+void * evey_mem_alloc(size_t size, size_t align)
+{
+    void * ptr;
+
+    if(mem_fn.fn_alloc)
+    {
+        ptr = mem_fn.fn_alloc(mem_fn.opaque, size, align);
+    }
+    else
+    {
+        if(align < sizeof(void *))
+        {
+            align = sizeof(void *);
+        }
+#ifdef _WIN32
+        ptr = _aligned_malloc(size, align);
+#else
+        if(posix_memalign(&ptr, align, size) != 0)
+        {
+            ptr = NULL;
+        }
+#endif
+    }
+
+    /* only the blocks to be freed are counted */
+    if(ptr)
+    {
+        mem_cnt_add(&mem_stats.alloc_cnt, 1);
+        mem_cnt_add(&mem_stats.alloc_bytes, (long long)size);
+    }
+    return ptr;
+}
+
+void evey_mem_free(void * ptr)
+{
+    if(ptr == NULL)
+    {
+        return;
+    }
+    mem_cnt_add(&mem_stats.free_cnt, 1);
+
+    if(mem_fn.fn_free)
+    {
+        mem_fn.fn_free(mem_fn.opaque, ptr);
+        return;
+    }
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void * evey_mem_alloc_plane(size_t size)
+{
+    void * ptr = NULL;
+    int    i;
+
+    /* size class: whole pages */
+    size = (size + MEM_PAGE_SIZE - 1) & ~(MEM_PAGE_SIZE - 1);
+
+    MEM_LOCK();
+    for(i = (int)mem_stats.pool_cnt - 1; i >= 0; i--)
+    {
+        if(mem_pool[i].size == size)
+        {
+            ptr = mem_pool[i].ptr;
+            mem_pool[i] = mem_pool[--mem_stats.pool_cnt];
+            mem_stats.pool_bytes -= size;
+            break;
+        }
+    }
+    MEM_UNLOCK();
+
+    if(ptr)
+    {
+        mem_cnt_add(&mem_stats.pool_hit, 1);
+        return ptr;
+    }
+    mem_cnt_add(&mem_stats.pool_miss, 1);
+
+    if(size >= MEM_HUGE_PAGE_SIZE)
+    {
+        ptr = evey_mem_alloc(size, MEM_HUGE_PAGE_SIZE);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if(ptr)
+        {
+            madvise(ptr, size & ~(MEM_HUGE_PAGE_SIZE - 1), MADV_HUGEPAGE);
+        }
+#endif
+    }
+    else
+    {
+        ptr = evey_mem_alloc(size, 64);
+    }
+    return ptr;
+}
+
+void evey_mem_free_plane(void * ptr, size_t size)
+{
+    if(ptr == NULL)
+    {
+        return;
+    }
+    size = (size + MEM_PAGE_SIZE - 1) & ~(MEM_PAGE_SIZE - 1);
+
+    MEM_LOCK();
+    if(mem_stats.pool_cnt < MEM_POOL_MAX_CNT &&
+       mem_stats.pool_bytes + size <= MEM_POOL_MAX_BYTES)
+    {
+        mem_pool[mem_stats.pool_cnt].ptr = ptr;
+        mem_pool[mem_stats.pool_cnt].size = size;
+        mem_stats.pool_cnt++;
+        mem_stats.pool_bytes += size;
+        ptr = NULL;
+    }
+    MEM_UNLOCK();
+
+    if(ptr)
+    {
+        evey_mem_free(ptr);
+    }
+}
+
+void evey_mem_pool_trim(void)
+{
+    MEM_POOL_ITEM pool[MEM_POOL_MAX_CNT];
+    int           i, cnt;
+
+    MEM_LOCK();
+    cnt = (int)mem_stats.pool_cnt;
+    evey_mcpy(pool, mem_pool, sizeof(MEM_POOL_ITEM) * cnt);
+    mem_stats.pool_cnt = 0;
+    mem_stats.pool_bytes = 0;
+    MEM_UNLOCK();
+
+    for(i = 0; i < cnt; i++)
+    {
+        evey_mem_free(pool[i].ptr);
+    }
+}
+
+int evey_mem_set_fn(EVEY_MEM_FN * fn)
+{
+    /* the pooled planes come from the previous allocator as well */
+    evey_mem_pool_trim();
+
+    /* blocks of the previous allocator must not be alive */
+    evey_assert_rv(mem_stats.alloc_cnt == mem_stats.free_cnt, EVEY_ERR_UNEXPECTED);
+    evey_assert_rv(fn == NULL || (fn->fn_alloc == NULL) == (fn->fn_free == NULL),
+                   EVEY_ERR_INVALID_ARGUMENT);
+
+    if(fn)
+    {
+        mem_fn = *fn;
+    }
+    else
+    {
+        evey_mset(&mem_fn, 0, sizeof(EVEY_MEM_FN));
+    }
+    return EVEY_OK;
+}
+
+void evey_mem_get_stats(EVEY_MEM_STATS * stats)
+{
+    MEM_LOCK();
+    *stats = mem_stats;
+    MEM_UNLOCK();
+}
+
+/*****************************************************************************
+ * arena
+ *****************************************************************************/
+/* chunks are at least this large; bigger blocks get a chunk of their own */
+#define ARENA_CHUNK_SIZE                ((size_t)1 << 20)
+#define ARENA_ALIGN(size)               (((size) + 63) & ~(size_t)63)
+
+struct _EVEY_ARENA_CHUNK
+{
+    EVEY_ARENA_CHUNK      * next;
+    size_t                  size;
+    size_t                  used;
+};
+
+void * evey_arena_alloc(EVEY_ARENA * arena, size_t size)
+{
+    EVEY_ARENA_CHUNK * chunk = arena->chunk;
+    size_t             head = ARENA_ALIGN(sizeof(EVEY_ARENA_CHUNK));
+    size_t             chunk_size;
+    void             * ptr;
+
+    size = ARENA_ALIGN(size);
+
+    if(chunk == NULL || chunk->used + size > chunk->size)
+    {
+        if(size > (ARENA_CHUNK_SIZE >> 2) && chunk != NULL)
+        {
+            /* keep the space left in the current chunk for small blocks */
+            chunk = (EVEY_ARENA_CHUNK *)evey_mem_alloc(head + size, 64);
+            evey_assert_rv(chunk != NULL, NULL);
+            chunk->size = chunk->used = head + size;
+            chunk->next = arena->chunk->next;
+            arena->chunk->next = chunk;
+            return (u8 *)chunk + head;
+        }
+        chunk_size = head + size > ARENA_CHUNK_SIZE ? head + size : ARENA_CHUNK_SIZE;
+        chunk = (EVEY_ARENA_CHUNK *)evey_mem_alloc(chunk_size, 64);
+        evey_assert_rv(chunk != NULL, NULL);
+        chunk->size = chunk_size;
+        chunk->used = head;
+        chunk->next = arena->chunk;
+        arena->chunk = chunk;
+    }
+    ptr = (u8 *)chunk + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+void evey_arena_release(EVEY_ARENA * arena)
+{
+    EVEY_ARENA_CHUNK * chunk, * next;
+
+    for(chunk = arena->chunk; chunk != NULL; chunk = next)
+    {
+        next = chunk->next;
+        evey_mem_free(chunk);
+    }
+    arena->chunk = NULL;
+}
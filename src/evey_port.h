@@ -81,10 +81,32 @@ typedef s32                      double_pel;
 /*****************************************************************************
  * memory operations
  *****************************************************************************/
-#define evey_malloc(size)          malloc((size))
-#define evey_malloc_fast(size)     evey_malloc((size))
+/* every heap block of the library comes from evey_mem_alloc() and goes
+   back through evey_mem_free(), which call the allocator installed by
+   evey_mem_set_fn() or the C library heap */
+void * evey_mem_alloc(size_t size, size_t align);
+void evey_mem_free(void * ptr);
+/* picture planes: 64-byte aligned (huge page aligned when large) and
+   recycled through a size-class pool shared by all instances */
+void * evey_mem_alloc_plane(size_t size);
+void evey_mem_free_plane(void * ptr, size_t size);
+
+/* arena for the structures living as long as an instance: blocks are
+   carved out of large chunks and released all together */
+typedef struct _EVEY_ARENA_CHUNK EVEY_ARENA_CHUNK;
+typedef struct _EVEY_ARENA
+{
+    EVEY_ARENA_CHUNK      * chunk;
+} EVEY_ARENA;
+
+/* returns a 64-byte aligned block, NULL when out of memory */
+void * evey_arena_alloc(EVEY_ARENA * arena, size_t size);
+void evey_arena_release(EVEY_ARENA * arena);
+
+#define evey_malloc(size)          evey_mem_alloc((size), 16)
+#define evey_malloc_fast(size)     evey_mem_alloc((size), 64)
 
-#define evey_mfree(m)              if(m){free(m);}
+#define evey_mfree(m)              if(m){evey_mem_free(m);}
 #define evey_mfree_fast(m)         if(m){evey_mfree(m);}
 
 #define evey_mcpy(dst,src,size)    memcpy((dst), (src), (size))
@@ -100,6 +122,56 @@ static __inline void evey_mset_16b(s16 * dst, s16 v, int cnt)
 }
 
 
+/*****************************************************************************
+ * bit operations
+ *****************************************************************************/
+/* count of leading zero bits; the result is undefined when x is zero */
+#if defined(__GNUC__)
+#define evey_clz32(x)              __builtin_clz((x))
+#define evey_clz64(x)              __builtin_clzll((x))
+#else
+static __inline int evey_clz32(u32 x)
+{
+    int n = 0;
+    if(!(x & 0xFFFF0000)) {n += 16; x <<= 16;}
+    if(!(x & 0xFF000000)) {n +=  8; x <<=  8;}
+    if(!(x & 0xF0000000)) {n +=  4; x <<=  4;}
+    if(!(x & 0xC0000000)) {n +=  2; x <<=  2;}
+    if(!(x & 0x80000000)) {n +=  1;}
+    return n;
+}
+static __inline int evey_clz64(u64 x)
+{
+    return (x >> 32) ? evey_clz32((u32)(x >> 32)) : 32 + evey_clz32((u32)x);
+}
+#endif
+
+/*****************************************************************************
+ * timer
+ *****************************************************************************/
+/* monotonic wall clock in nanoseconds, for stage timing */
+s64 evey_time_ns(void);
+
+/*****************************************************************************
+ * thread
+ *****************************************************************************/
+typedef void * EVEY_THREAD;
+
+/* create a thread running fn(arg); returns NULL on failure */
+EVEY_THREAD evey_thread_create(int (*fn)(void * arg), void * arg);
+/* wait for the thread to end and return the value returned by fn */
+int evey_thread_join(EVEY_THREAD thread);
+/* give up the processor; sleeps briefly once spin grows large */
+void evey_thread_wait(int spin);
+/* load with acquire and store with release semantics, for flags and
+   counters shared between two threads without a lock */
+int evey_atomic_load(volatile int * p);
+void evey_atomic_store(volatile int * p, int v);
+/* process-wide lock around the state shared by all the encoder and decoder
+   instances, such as the scan tables */
+void evey_global_lock(void);
+void evey_global_unlock(void);
+
 /*****************************************************************************
  * trace and assert
  *****************************************************************************/
@@ -142,7 +214,11 @@ void evey_trace_line(char * pre);
 #define evey_assert_gv(x,r,v,g) \
     {if(!(x)){assert(x); (r)=(v); goto g;}}
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
 #define X86_SSE                 1
+#else
+#define X86_SSE                 0
+#endif
 
 #if X86_SSE
 #ifdef _WIN32
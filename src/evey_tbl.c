@@ -268,18 +268,7 @@ int *p_evey_tbl_qp_chroma_dynamic[2];
 int evey_tbl_qp_chroma_dynamic_ext[2][MAX_QP_TABLE_SIZE_EXT];
 int *p_evey_tbl_qp_chroma_dynamic_ext[2] = { &(evey_tbl_qp_chroma_dynamic_ext[0][0]) , &(evey_tbl_qp_chroma_dynamic_ext[1][0]) };
 
-void evey_set_chroma_qp_tbl_loc(int codec_bit_depth)
-{
-    for(int i = 0; i < 6 * (codec_bit_depth - 8); i++)
-    {
-        evey_tbl_qp_chroma_dynamic_ext[0][i] = i - 6 * (codec_bit_depth - 8);
-        evey_tbl_qp_chroma_dynamic_ext[1][i] = i - 6 * (codec_bit_depth - 8);
-    }
-    p_evey_tbl_qp_chroma_dynamic[0] = &(evey_tbl_qp_chroma_dynamic_ext[0][6 * (codec_bit_depth - 8)]);
-    p_evey_tbl_qp_chroma_dynamic[1] = &(evey_tbl_qp_chroma_dynamic_ext[1][6 * (codec_bit_depth - 8)]);
-}
-
-void evey_derived_chroma_qp_mapping_tables(EVEY_CHROMA_TABLE * structChromaQP, int bit_depth)
+static void derive_chroma_qp_tbl(EVEY_CHROMA_TABLE * structChromaQP, int bit_depth, int ** qp_tbl)
 {
     int MAX_QP = MAX_QP_TABLE_SIZE - 1;
     int qpInVal[MAX_QP_TABLE_SIZE_EXT] = { 0 };
@@ -303,27 +292,63 @@ void evey_derived_chroma_qp_mapping_tables(EVEY_CHROMA_TABLE * structChromaQP, i
             assert(qpOutVal[j] >= -qpBdOffsetC && qpOutVal[j] <= MAX_QP);
         }
 
-        p_evey_tbl_qp_chroma_dynamic[i][qpInVal[0]] = qpOutVal[0];
+        qp_tbl[i][qpInVal[0]] = qpOutVal[0];
         for (int k = qpInVal[0] - 1; k >= -qpBdOffsetC; k--)
         {
-            p_evey_tbl_qp_chroma_dynamic[i][k] = EVEY_CLIP3(-qpBdOffsetC, MAX_QP, p_evey_tbl_qp_chroma_dynamic[i][k + 1] - 1);
+            qp_tbl[i][k] = EVEY_CLIP3(-qpBdOffsetC, MAX_QP, qp_tbl[i][k + 1] - 1);
         }
         for (int j = 0; j < structChromaQP->num_points_in_qp_table_minus1[i]; j++)
         {
             int sh = (structChromaQP->delta_qp_in_val_minus1[i][j + 1] + 1) >> 1;
             for (int k = qpInVal[j] + 1, m = 1; k <= qpInVal[j + 1]; k++, m++)
             {
-                p_evey_tbl_qp_chroma_dynamic[i][k] = p_evey_tbl_qp_chroma_dynamic[i][qpInVal[j]]
+                qp_tbl[i][k] = qp_tbl[i][qpInVal[j]]
                     + ((qpOutVal[j + 1] - qpOutVal[j]) * m + sh) / (structChromaQP->delta_qp_in_val_minus1[i][j + 1] + 1);
             }
         }
         for (int k = qpInVal[structChromaQP->num_points_in_qp_table_minus1[i]] + 1; k <= MAX_QP; k++)
         {
-            p_evey_tbl_qp_chroma_dynamic[i][k] = EVEY_CLIP3(-qpBdOffsetC, MAX_QP, p_evey_tbl_qp_chroma_dynamic[i][k - 1] + 1);
+            qp_tbl[i][k] = EVEY_CLIP3(-qpBdOffsetC, MAX_QP, qp_tbl[i][k - 1] + 1);
         }
     }
     if (structChromaQP->same_qp_table_for_chroma)
     {
-        evey_mcpy(&(p_evey_tbl_qp_chroma_dynamic[1][-qpBdOffsetC]), &(p_evey_tbl_qp_chroma_dynamic[0][-qpBdOffsetC]), MAX_QP_TABLE_SIZE_EXT * sizeof(int));
+        evey_mcpy(&(qp_tbl[1][-qpBdOffsetC]), &(qp_tbl[0][-qpBdOffsetC]), MAX_QP_TABLE_SIZE_EXT * sizeof(int));
+    }
+}
+
+void evey_set_chroma_qp_tbl(EVEY_CHROMA_TABLE * structChromaQP, int bit_depth_luma, int bit_depth_chroma)
+{
+    int   ext[2][MAX_QP_TABLE_SIZE_EXT];
+    int * qp_tbl[2];
+    int   i, off = 6 * (bit_depth_luma - 8);
+
+    evey_global_lock();
+    evey_mcpy(ext, evey_tbl_qp_chroma_dynamic_ext, sizeof(ext));
+    for(i = 0; i < off; i++)
+    {
+        ext[0][i] = i - off;
+        ext[1][i] = i - off;
+    }
+    qp_tbl[0] = &(ext[0][off]);
+    qp_tbl[1] = &(ext[1][off]);
+
+    if(structChromaQP->chroma_qp_table_present_flag)
+    {
+        derive_chroma_qp_tbl(structChromaQP, bit_depth_chroma, qp_tbl);
+    }
+    else
+    {
+        evey_mcpy(&(ext[0][6 * (bit_depth_chroma - 8)]), evey_tbl_qp_chroma_ajudst, MAX_QP_TABLE_SIZE * sizeof(int));
+        evey_mcpy(&(ext[1][6 * (bit_depth_chroma - 8)]), evey_tbl_qp_chroma_ajudst, MAX_QP_TABLE_SIZE * sizeof(int));
+    }
+
+    if(memcmp(ext, evey_tbl_qp_chroma_dynamic_ext, sizeof(ext)) ||
+       p_evey_tbl_qp_chroma_dynamic[0] != &(evey_tbl_qp_chroma_dynamic_ext[0][off]))
+    {
+        evey_mcpy(evey_tbl_qp_chroma_dynamic_ext, ext, sizeof(ext));
+        p_evey_tbl_qp_chroma_dynamic[0] = &(evey_tbl_qp_chroma_dynamic_ext[0][off]);
+        p_evey_tbl_qp_chroma_dynamic[1] = &(evey_tbl_qp_chroma_dynamic_ext[1][off]);
     }
+    evey_global_unlock();
 }
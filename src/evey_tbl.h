@@ -55,8 +55,11 @@ extern int evey_tbl_qp_chroma_dynamic_ext[2][MAX_QP_TABLE_SIZE_EXT];
 extern int * p_evey_tbl_qp_chroma_dynamic_ext[2]; /* pointer to [0th position in evey_tbl_qp_chroma_dynamic_ext] */
 extern int * p_evey_tbl_qp_chroma_dynamic[2];     /* pointer to [12th position in evey_tbl_qp_chroma_dynamic_ext] */
 
-void evey_derived_chroma_qp_mapping_tables(EVEY_CHROMA_TABLE * structChromaQP, int bit_depth);
-void evey_set_chroma_qp_tbl_loc(int codec_bit_depth);
+/* chroma QP mapping tables of a sequence; the tables are shared by all the
+   encoders and decoders of the process, so they are built aside under the
+   global lock and only copied when they change, which lets the instances
+   of one sequence run concurrently */
+void evey_set_chroma_qp_tbl(EVEY_CHROMA_TABLE * structChromaQP, int bit_depth_luma, int bit_depth_chroma);
 
 #ifdef __cplusplus
 }
@@ -77,7 +77,7 @@ static void imgb_delete(EVEY_IMGB * imgb)
 
     for(i = 0; i < EVEY_IMGB_MAX_PLANE; i++)
     {
-        evey_mfree(imgb->baddr[i]);
+        evey_mem_free_plane(imgb->baddr[i], imgb->bsize[i]);
     }
     evey_mfree(imgb);
 }
@@ -282,6 +282,27 @@ void evey_imgb_cpy(EVEY_IMGB * dst, EVEY_IMGB * src)
     }
 }
 
+void evey_imgb_conv(EVEY_IMGB * imgb, int cs)
+{
+    EVEY_IMGB src;
+    int       bd_src, bd_dst;
+
+    /* the shifts read each sample before writing it back */
+    src = *imgb;
+    bd_src = EVEY_CS_GET_BIT_DEPTH(src.cs);
+    bd_dst = EVEY_CS_GET_BIT_DEPTH(cs);
+    imgb->cs = cs;
+
+    if(bd_src < bd_dst)
+    {
+        imgb_cpy_shift_left(imgb, &src, bd_dst - bd_src);
+    }
+    else if(bd_src > bd_dst)
+    {
+        imgb_cpy_shift_right(imgb, &src, bd_src - bd_dst);
+    }
+}
+
 EVEY_IMGB * evey_imgb_create(int w, int h, int cs, int opt, int pad[EVEY_IMGB_MAX_PLANE], int align[EVEY_IMGB_MAX_PLANE])
 {    
     EVEY_IMGB * imgb;
@@ -322,7 +343,7 @@ EVEY_IMGB * evey_imgb_create(int w, int h, int cs, int opt, int pad[EVEY_IMGB_MA
             imgb->e[i] = imgb->ah[i] + imgb->padu[i] + imgb->padb[i];
 
             imgb->bsize[i] = imgb->s[i] * imgb->e[i];
-            imgb->baddr[i] = evey_malloc(imgb->bsize[i]);
+            imgb->baddr[i] = evey_mem_alloc_plane(imgb->bsize[i]);
 
             imgb->a[i] = ((u8*)imgb->baddr[i]) + imgb->padu[i] * imgb->s[i] +
                 imgb->padl[i] * bd;
@@ -429,7 +450,7 @@ EVEY_PIC * evey_picbuf_alloc(int w, int h, int pad_l, int pad_c, int chroma_form
     /* allocate maps */
     w_scu = (pic->w_l + ((1 << MIN_CU_LOG2) - 1)) >> MIN_CU_LOG2;
     h_scu = (pic->h_l + ((1 << MIN_CU_LOG2) - 1)) >> MIN_CU_LOG2;
-    f_scu = w_scu * h_scu;
+    f_scu = SCU_MAP_SIZE(w_scu, h_scu);
 
     size = sizeof(s8) * f_scu * LIST_NUM;
     pic->map_refi = evey_malloc_fast(size);
@@ -598,8 +619,8 @@ void evey_get_motion(void * ctx, void * core, EVEY_REF_PIC_LIST lidx, s8 refi[EV
     if (IS_AVAIL(c_core->avail_cu, AVAIL_LE))
     {
         refi[0] = 0;
-        mvp[0][MV_X] = c_ctx->map_mv[c_core->scup - 1][lidx][MV_X];
-        mvp[0][MV_Y] = c_ctx->map_mv[c_core->scup - 1][lidx][MV_Y];
+        mvp[0][MV_X] = c_ctx->map_mv[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)][lidx][MV_X];
+        mvp[0][MV_Y] = c_ctx->map_mv[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)][lidx][MV_Y];
     }
     else
     {
@@ -612,8 +633,8 @@ void evey_get_motion(void * ctx, void * core, EVEY_REF_PIC_LIST lidx, s8 refi[EV
     if (IS_AVAIL(c_core->avail_cu, AVAIL_UP))
     {
         refi[1] = 0;
-        mvp[1][MV_X] = c_ctx->map_mv[c_core->scup - c_ctx->w_scu][lidx][MV_X];
-        mvp[1][MV_Y] = c_ctx->map_mv[c_core->scup - c_ctx->w_scu][lidx][MV_Y];
+        mvp[1][MV_X] = c_ctx->map_mv[SCU_IDX(c_core->x_scu, c_core->y_scu - 1, c_ctx->w_scu)][lidx][MV_X];
+        mvp[1][MV_Y] = c_ctx->map_mv[SCU_IDX(c_core->x_scu, c_core->y_scu - 1, c_ctx->w_scu)][lidx][MV_Y];
     }
     else
     {
@@ -626,8 +647,8 @@ void evey_get_motion(void * ctx, void * core, EVEY_REF_PIC_LIST lidx, s8 refi[EV
     if (IS_AVAIL(c_core->avail_cu, AVAIL_UP_RI))
     {
         refi[2] = 0;
-        mvp[2][MV_X] = c_ctx->map_mv[c_core->scup - c_ctx->w_scu + (1 << (c_core->log2_cuw - MIN_CU_LOG2))][lidx][MV_X];
-        mvp[2][MV_Y] = c_ctx->map_mv[c_core->scup - c_ctx->w_scu + (1 << (c_core->log2_cuw - MIN_CU_LOG2))][lidx][MV_Y];
+        mvp[2][MV_X] = c_ctx->map_mv[SCU_IDX(c_core->x_scu + (1 << (c_core->log2_cuw - MIN_CU_LOG2)), c_core->y_scu - 1, c_ctx->w_scu)][lidx][MV_X];
+        mvp[2][MV_Y] = c_ctx->map_mv[SCU_IDX(c_core->x_scu + (1 << (c_core->log2_cuw - MIN_CU_LOG2)), c_core->y_scu - 1, c_ctx->w_scu)][lidx][MV_Y];
     }
     else
     {
@@ -648,7 +669,7 @@ void evey_get_mv_dir(void * ctx, void * core, s16 mvp[LIST_NUM][MV_D])
     EVEY_CORE * c_core = (EVEY_CORE*)core;
     EVEY_REFP * refp = c_ctx->refp[0];
     u32         poc = c_ctx->poc.poc_val;
-    int         scup = c_core->scup + ((1 << (c_core->log2_cuw - MIN_CU_LOG2)) - 1) + ((1 << (c_core->log2_cuh - MIN_CU_LOG2)) - 1) * c_ctx->w_scu;
+    int         scup = SCU_IDX(c_core->x_scu + (1 << (c_core->log2_cuw - MIN_CU_LOG2)) - 1, c_core->y_scu + (1 << (c_core->log2_cuh - MIN_CU_LOG2)) - 1, c_ctx->w_scu);
     s16         mvc[MV_D];
     int         dpoc_co, dpoc_L0, dpoc_L1;
 
@@ -682,24 +703,24 @@ u16 evey_get_avail_inter(void * ctx, void * core)
     int         scuw = 1 << (c_core->log2_cuw - MIN_CU_LOG2);
     u16         avail = 0;
 
-    if(c_core->x_scu > 0 && !MCU_GET_IF(c_ctx->map_scu[c_core->scup - 1]) && MCU_GET_COD(c_ctx->map_scu[c_core->scup - 1]))
+    if(c_core->x_scu > 0 && !MCU_GET_IF(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)]) && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)]))
     {
         SET_AVAIL(avail, AVAIL_LE);
     }
 
     if(c_core->y_scu > 0)
     {
-        if(!MCU_GET_IF(c_ctx->map_scu[c_core->scup - c_ctx->w_scu]))
+        if(MCU_IS_COD_NIF(c_ctx->map_scu[SCU_IDX(c_core->x_scu, c_core->y_scu - 1, c_ctx->w_scu)]))
         {
             SET_AVAIL(avail, AVAIL_UP);
         }
 
-        if(c_core->x_scu > 0 && !MCU_GET_IF(c_ctx->map_scu[c_core->scup - c_ctx->w_scu - 1]) && MCU_GET_COD(c_ctx->map_scu[c_core->scup - c_ctx->w_scu - 1]))
+        if(c_core->x_scu > 0 && !MCU_GET_IF(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu - 1, c_ctx->w_scu)]) && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu - 1, c_ctx->w_scu)]))
         {
             SET_AVAIL(avail, AVAIL_UP_LE);
         }
 
-        if(c_core->x_scu + scuw < c_ctx->w_scu  && MCU_IS_COD_NIF(c_ctx->map_scu[c_core->scup - c_ctx->w_scu + scuw]) && MCU_GET_COD(c_ctx->map_scu[c_core->scup - c_ctx->w_scu + scuw]))
+        if(c_core->x_scu + scuw < c_ctx->w_scu  && MCU_IS_COD_NIF(c_ctx->map_scu[SCU_IDX(c_core->x_scu + scuw, c_core->y_scu - 1, c_ctx->w_scu)]) && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu + scuw, c_core->y_scu - 1, c_ctx->w_scu)]))
         {
             SET_AVAIL(avail, AVAIL_UP_RI);
         }
@@ -715,22 +736,24 @@ u16 evey_get_avail_intra(void * ctx, void * core)
     int         scuw = 1 << (c_core->log2_cuw - MIN_CU_LOG2);
     u16         avail = 0;
 
-    if(c_core->x_scu > 0 && MCU_GET_COD(c_ctx->map_scu[c_core->scup - 1]))
+    if(c_core->x_scu > 0 && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu, c_ctx->w_scu)]))
     {
         SET_AVAIL(avail, AVAIL_LE);
     }
 
     if(c_core->y_scu > 0)
     {
-        SET_AVAIL(avail, AVAIL_UP);
-
+        if(MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu, c_core->y_scu - 1, c_ctx->w_scu)]))
+        {
+            SET_AVAIL(avail, AVAIL_UP);
+        }
 
-        if(c_core->x_scu > 0 && MCU_GET_COD(c_ctx->map_scu[c_core->scup - c_ctx->w_scu - 1]))
+        if(c_core->x_scu > 0 && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu - 1, c_core->y_scu - 1, c_ctx->w_scu)]))
         {
             SET_AVAIL(avail, AVAIL_UP_LE);
         }
 
-        if(c_core->x_scu + scuw < c_ctx->w_scu  && MCU_GET_COD(c_ctx->map_scu[c_core->scup - c_ctx->w_scu + scuw]))
+        if(c_core->x_scu + scuw < c_ctx->w_scu  && MCU_GET_COD(c_ctx->map_scu[SCU_IDX(c_core->x_scu + scuw, c_core->y_scu - 1, c_ctx->w_scu)]))
         {
             SET_AVAIL(avail, AVAIL_UP_RI);
         }
@@ -1064,11 +1087,21 @@ static void evey_init_inverse_scan_sr(u16 * scan_inv, u16 * scan_orig, int width
     }
 }
 
+/* instances sharing the scan tables; the first one builds them and the
+   last one frees them */
+static int scan_tbl_ref = 0;
+
 int evey_scan_tbl_init()
 {
     int x, y, scan_type;
     int size_y, size_x;
 
+    evey_global_lock();
+    if(scan_tbl_ref++ > 0)
+    {
+        evey_global_unlock();
+        return EVEY_OK;
+    }
     for(scan_type = 0; scan_type < COEF_SCAN_TYPE_NUM; scan_type++)
     {
         for(y = 0; y < MAX_TR_LOG2; y++)
@@ -1084,6 +1117,7 @@ int evey_scan_tbl_init()
             }
         }
     }
+    evey_global_unlock();
     return EVEY_OK;
 }
 
@@ -1091,6 +1125,12 @@ int evey_scan_tbl_delete()
 {
     int x, y, scan_type;
 
+    evey_global_lock();
+    if(--scan_tbl_ref > 0)
+    {
+        evey_global_unlock();
+        return EVEY_OK;
+    }
     for(scan_type = 0; scan_type < COEF_SCAN_TYPE_NUM; scan_type++)
     {
         for(y = 0; y < MAX_TR_LOG2; y++)
@@ -1102,6 +1142,7 @@ int evey_scan_tbl_delete()
             }
         }
     }
+    evey_global_unlock();
     return EVEY_OK;
 }
 
@@ -1235,6 +1276,42 @@ void evey_update_core_loc_param(void * ctx, void * core)
     c_core->ctu_num = c_core->x_ctu + c_core->y_ctu * c_ctx->w_ctu;
 }
 
+/* first CTU row of a tile row; tile_row past the last one gives the CTU
+   rows of the picture. tiles span the width of the picture */
+int evey_tile_row_ctu(EVEY_PPS * pps, int h_ctu, int tile_row)
+{
+    int num_tile_rows, y, i;
+
+    num_tile_rows = pps->single_tile_in_pic_flag ? 1 : pps->num_tile_rows_minus1 + 1;
+    if(tile_row >= num_tile_rows)
+    {
+        return h_ctu;
+    }
+    if(pps->single_tile_in_pic_flag || pps->uniform_tile_spacing_flag)
+    {
+        return tile_row * h_ctu / num_tile_rows;
+    }
+    for(i = 0, y = 0; i < tile_row; i++)
+    {
+        y += pps->tile_row_height_minus1[i] + 1;
+    }
+    return y;
+}
+
+/* clear the coded flags of the SCU row above a CTU row, so that a slice
+   starting at the CTU row predicts nothing from the slice above it */
+void evey_clr_cod_above(void * ctx, u32 * map_scu, int y_ctu)
+{
+    EVEY_CTX * c_ctx = (EVEY_CTX*)ctx;
+    int        x, y;
+
+    y = (y_ctu << (c_ctx->log2_ctu_size - MIN_CU_LOG2)) - 1;
+    for(x = 0; y >= 0 && x < c_ctx->w_scu; x++)
+    {
+        MCU_CLR_COD(map_scu[SCU_IDX(x, y, c_ctx->w_scu)]);
+    }
+}
+
 /* cabac initialization value with probability 1/2 and mps = 0 */
 #define PROB_INIT                 (512) 
 
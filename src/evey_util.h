@@ -44,6 +44,8 @@ extern "C"
 /* create image buffer */
 EVEY_IMGB * evey_imgb_create(int w, int h, int cs, int opt, int pad[EVEY_IMGB_MAX_PLANE], int align[EVEY_IMGB_MAX_PLANE]);
 void evey_imgb_cpy(EVEY_IMGB * dst, EVEY_IMGB * src);
+/* convert the samples of a 16-bit image buffer to another bit depth in place */
+void evey_imgb_conv(EVEY_IMGB * imgb, int cs);
 
 /*! macro to determine maximum */
 #define EVEY_MAX(a,b)                   (((a) > (b)) ? (a) : (b))
@@ -155,6 +157,8 @@ int evey_atomic_dec(volatile int * pcnt);
 void evey_block_copy(s16 * src, int src_stride, s16 * dst, int dst_stride, int log2_copy_w, int log2_copy_h);
 
 void evey_update_core_loc_param(void * ctx, void * core);
+int evey_tile_row_ctu(EVEY_PPS * pps, int h_ctu, int tile_row);
+void evey_clr_cod_above(void * ctx, u32 * map_scu, int y_ctu);
 
 void evey_eco_init_ctx_model(EVEY_SBAC_CTX * sbac_ctx);
 
@@ -84,10 +84,17 @@ static void core_free(EVEYD_CORE * core)
 
 static void sequence_deinit(EVEYD_CTX * ctx)
 {
-    evey_mfree(ctx->map_scu);
-    evey_mfree(ctx->map_split);
-    evey_mfree(ctx->map_ipm);
-    evey_mfree(ctx->map_pred_mode);
+    /* maps of the sequence */
+    evey_arena_release(&ctx->arena);
+    ctx->map_scu = NULL;
+    ctx->map_split = NULL;
+    ctx->map_ipm = NULL;
+    ctx->map_pred_mode = NULL;
+    if(ctx->recon_pipe)
+    {
+        ctx->recon_pipe->syn = NULL;
+        ctx->recon_pipe->ctu_recon = NULL;
+    }
     evey_picman_deinit(&ctx->dpbm);
 }
 
@@ -117,13 +124,13 @@ static int sequence_init(EVEYD_CTX * ctx, EVEY_SPS * sps)
     ctx->f_ctu = ctx->w_ctu * ctx->h_ctu;
     ctx->w_scu = (ctx->w + ((1 << MIN_CU_LOG2) - 1)) >> MIN_CU_LOG2;
     ctx->h_scu = (ctx->h + ((1 << MIN_CU_LOG2) - 1)) >> MIN_CU_LOG2;
-    ctx->f_scu = ctx->w_scu * ctx->h_scu;
+    ctx->f_scu = SCU_MAP_SIZE(ctx->w_scu, ctx->h_scu);
 
     /* alloc SCU map */
     if(ctx->map_scu == NULL)
     {
         size = sizeof(u32) * ctx->f_scu;
-        ctx->map_scu = (u32 *)evey_malloc(size);
+        ctx->map_scu = (u32 *)evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_scu, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset_x64a(ctx->map_scu, 0, size);
     }
@@ -132,7 +139,7 @@ static int sequence_init(EVEYD_CTX * ctx, EVEY_SPS * sps)
     if(ctx->map_split == NULL)
     {
         size = sizeof(s8) * ctx->f_ctu * NUM_CU_DEPTH * NUM_BLOCK_SHAPE * MAX_CU_CNT_IN_CTU;
-        ctx->map_split = evey_malloc(size);
+        ctx->map_split = evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_split, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset_x64a(ctx->map_split, 0, size);
     }
@@ -141,7 +148,7 @@ static int sequence_init(EVEYD_CTX * ctx, EVEY_SPS * sps)
     if(ctx->map_ipm == NULL)
     {
         size = sizeof(s8) * ctx->f_scu;
-        ctx->map_ipm = (s8 *)evey_malloc(size);
+        ctx->map_ipm = (s8 *)evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_ipm, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset_x64a(ctx->map_ipm, -1, size);
     }
@@ -150,11 +157,27 @@ static int sequence_init(EVEYD_CTX * ctx, EVEY_SPS * sps)
     if(ctx->map_pred_mode == NULL)
     {
         size = sizeof(u8) * ctx->f_scu;
-        ctx->map_pred_mode = (u8 *)evey_malloc(size);
+        ctx->map_pred_mode = (u8 *)evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_pred_mode, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset_x64a(ctx->map_pred_mode, 0, size);
     }
 
+    /* syntax records and row progress of the pipeline */
+    if(ctx->recon_pipe && ctx->recon_pipe->syn == NULL)
+    {
+        EVEYD_RECON_PIPE * pipe = ctx->recon_pipe;
+
+        /* the parsing runs ahead of the reconstruction by a few rows */
+        pipe->syn_num = ctx->w_ctu * EVEY_MIN(pipe->worker_num + 2, ctx->h_ctu);
+        size = sizeof(EVEYD_CTU_SYN) * pipe->syn_num;
+        pipe->syn = (EVEYD_CTU_SYN *)evey_arena_alloc(&ctx->arena, size);
+        evey_assert_gv(pipe->syn, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
+
+        size = sizeof(int) * ctx->h_ctu;
+        pipe->ctu_recon = (volatile int *)evey_arena_alloc(&ctx->arena, size);
+        evey_assert_gv(pipe->ctu_recon, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
+    }
+
     /* initialize reference picture manager */
     EVEY_PICBUF_ALLOCATOR pa;
     pa.fn_alloc          = evey_pic_alloc;
@@ -171,17 +194,7 @@ static int sequence_init(EVEYD_CTX * ctx, EVEY_SPS * sps)
 
     ctx->ref_pic_gap_length = (int)pow(2.0, sps->log2_ref_pic_gap_length);
 
-    evey_set_chroma_qp_tbl_loc(ctx->sps.bit_depth_luma_minus8 + 8);
-
-    if (sps->chroma_qp_table_struct.chroma_qp_table_present_flag)
-    {
-        evey_derived_chroma_qp_mapping_tables(&(sps->chroma_qp_table_struct), sps->bit_depth_chroma_minus8 + 8);
-    }
-    else
-    {
-        evey_mcpy(&(evey_tbl_qp_chroma_dynamic_ext[0][6 * sps->bit_depth_chroma_minus8]), evey_tbl_qp_chroma_ajudst, MAX_QP_TABLE_SIZE * sizeof(int));
-        evey_mcpy(&(evey_tbl_qp_chroma_dynamic_ext[1][6 * sps->bit_depth_chroma_minus8]), evey_tbl_qp_chroma_ajudst, MAX_QP_TABLE_SIZE * sizeof(int));
-    }
+    evey_set_chroma_qp_tbl(&(sps->chroma_qp_table_struct), sps->bit_depth_luma_minus8 + 8, sps->bit_depth_chroma_minus8 + 8);
 
     return EVEY_OK;
 ERR:
@@ -205,9 +218,12 @@ static int slice_init(EVEYD_CTX * ctx, EVEYD_CORE * core, EVEY_SH * sh)
     core->qp_u    = p_evey_tbl_qp_chroma_dynamic[0][sh->qp_u] + 6 * ctx->sps.bit_depth_chroma_minus8;
     core->qp_v    = p_evey_tbl_qp_chroma_dynamic[1][sh->qp_v] + 6 * ctx->sps.bit_depth_chroma_minus8;
 
-    /* clear maps */
-    evey_mset_x64a(ctx->map_scu, 0, sizeof(u32) * ctx->f_scu);
-    
+    /* clear maps at the first slice of a picture */
+    if(ctx->ctu_cnt == 0)
+    {
+        evey_mset_x64a(ctx->map_scu, 0, sizeof(u32) * ctx->f_scu);
+    }
+
     if(ctx->sh.slice_type == SLICE_I)
     {
         ctx->last_intra_poc = ctx->poc.poc_val;
@@ -232,6 +248,7 @@ static void make_stat(EVEYD_CTX * ctx, int btype, EVEYD_STAT * stat)
 
             /* increase decoded picture count */
             ctx->pic_cnt++;
+            ctx->stats.frames++;
             stat->poc = ctx->poc.poc_val;
             stat->tid = ctx->nalu.nuh_temporal_id;
 
@@ -244,6 +261,11 @@ static void make_stat(EVEYD_CTX * ctx, int btype, EVEYD_STAT * stat)
                 }
             }
         }
+        for(i = 0; i < EVEYD_STAGE_NUM; i++)
+        {
+            stat->stage_ns[i] = ctx->stage_ns[i];
+            ctx->stats.stage_ns[i] += ctx->stage_ns[i];
+        }
     }
 }
 
@@ -320,7 +342,7 @@ static int eveyd_eco_unit(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y, int
     core->log2_cuh = log2_cuh;
     core->x_scu = PEL2SCU(x);
     core->y_scu = PEL2SCU(y);
-    core->scup = core->x_scu + core->y_scu * ctx->w_scu;
+    core->scup = SCU_IDX(core->x_scu, core->y_scu, ctx->w_scu);
 
     /* parse CU info */
     ret = eveyd_eco_cu(ctx, core);
@@ -367,7 +389,7 @@ static int eveyd_dec_cu(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y, int lo
     core->log2_cuh = log2_cuh;
     core->x_scu = PEL2SCU(x);
     core->y_scu = PEL2SCU(y);
-    core->scup = core->x_scu + core->y_scu * ctx->w_scu;
+    core->scup = SCU_IDX(core->x_scu, core->y_scu, ctx->w_scu);
     cuw = 1 << log2_cuw;
     cuh = 1 << log2_cuh;    
 
@@ -377,6 +399,9 @@ static int eveyd_dec_cu(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y, int lo
     /* skip mode */
     if(core->pred_mode == MODE_SKIP) 
     {
+        core->cnt.skip_cu++;
+        core->cnt.inter_cu++;
+
         /* check availability of neighboring blocks */
         core->avail_cu = evey_get_avail_inter(ctx, core);
 
@@ -392,6 +417,8 @@ static int eveyd_dec_cu(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y, int lo
         /* intra prediction */
         if(core->pred_mode == MODE_INTRA)
         {
+            core->cnt.intra_cu[core->ipm[0]]++;
+
             /* check availability of neighboring blocks */
             core->avail_cu = evey_get_avail_intra(ctx, core);
 
@@ -417,6 +444,8 @@ static int eveyd_dec_cu(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y, int lo
         /* inter prediction */
         else
         {
+            core->cnt.inter_cu++;
+
             /* check availability of neighboring blocks */
             core->avail_cu = evey_get_avail_inter(ctx, core);
 
@@ -557,6 +586,7 @@ static int eveyd_dec_tree(EVEYD_CTX * ctx, EVEYD_CORE * core, int x0, int y0, in
         /* decode a CU */
         ret = eveyd_dec_cu(ctx, core, x0, y0, log2_cuw, log2_cuh);
         evey_assert_g(ret == EVEY_OK, ERR);
+        core->cnt.cu[cud]++;
     }
 
     return EVEY_OK;
@@ -565,6 +595,194 @@ ERR:
     return ret;
 }
 
+/* reconstruct the CTU at core->x_ctu and core->y_ctu from its syntax record */
+static int eveyd_recon_ctu(EVEYD_CTX * ctx, EVEYD_CORE * core, EVEYD_CTU_SYN * syn)
+{
+    core->syn = syn;
+    core->qp_y = syn->qp_y;
+    core->qp_u = syn->qp_u;
+    core->qp_v = syn->qp_v;
+    evey_update_core_loc_param(ctx, core);
+
+    return eveyd_dec_tree(ctx, core, core->x_pel, core->y_pel, ctx->log2_ctu_size, ctx->log2_ctu_size, 0, 0);
+}
+
+/* wait until a progress counter of the pipeline reaches num.
+   returns 0 if the slice was aborted meanwhile */
+static int recon_pipe_wait(EVEYD_RECON_PIPE * pipe, volatile int * cnt, int num)
+{
+    int spin = 0;
+
+    while(evey_atomic_load(cnt) < num)
+    {
+        if(evey_atomic_load(&pipe->abort))
+        {
+            return 0;
+        }
+        evey_thread_wait(spin++);
+    }
+    return 1;
+}
+
+/* deblock a CTU row after the rows above it.
+   returns 0 if the slice was aborted meanwhile */
+static int recon_pipe_deblock(EVEYD_RECON_WORKER * worker, int y_ctu)
+{
+    EVEYD_RECON_PIPE * pipe = worker->pipe;
+    s64                t0;
+
+    if(!recon_pipe_wait(pipe, &pipe->row_dbk, y_ctu))
+    {
+        return 0;
+    }
+
+    t0 = evey_time_ns();
+    evey_deblock_ctu_row(pipe->ctx, y_ctu);
+    worker->dbk_ns += evey_time_ns() - t0;
+
+    evey_atomic_store(&pipe->row_dbk, y_ctu + 1);
+    return 1;
+}
+
+/* reconstruction thread: reconstructs its CTU rows of the slice as the CTUs
+   are parsed and the row above is two CTUs ahead, and deblocks the row above
+   each row it completes */
+static int recon_pipe_run(void * arg)
+{
+    EVEYD_RECON_WORKER * worker = (EVEYD_RECON_WORKER *)arg;
+    EVEYD_RECON_PIPE   * pipe = worker->pipe;
+    EVEYD_CTX          * ctx = pipe->ctx;
+    EVEYD_CORE         * core = worker->core;
+    int                  x_ctu, y_ctu, ctu_num, ret;
+    s64                  t0;
+
+    for(y_ctu = worker->y_ctu; y_ctu < pipe->y_ctu_end; y_ctu += pipe->worker_num)
+    {
+        for(x_ctu = 0; x_ctu < ctx->w_ctu; x_ctu++)
+        {
+            /* number of the CTU in the slice */
+            ctu_num = (y_ctu - pipe->y_ctu_beg) * ctx->w_ctu + x_ctu;
+
+            if(!recon_pipe_wait(pipe, &pipe->ctu_parsed, ctu_num + 1))
+            {
+                return EVEY_OK;
+            }
+            if(y_ctu > pipe->y_ctu_beg &&
+               !recon_pipe_wait(pipe, &pipe->ctu_recon[y_ctu - 1], EVEY_MIN(x_ctu + 2, ctx->w_ctu)))
+            {
+                return EVEY_OK;
+            }
+
+            t0 = evey_time_ns();
+            core->x_ctu = x_ctu;
+            core->y_ctu = y_ctu;
+            ret = eveyd_recon_ctu(ctx, core, pipe->syn + ctu_num % pipe->syn_num);
+            evey_assert_g(ret == EVEY_OK, ERR);
+            worker->recon_ns += evey_time_ns() - t0;
+
+            evey_atomic_store(&pipe->ctu_recon[y_ctu], x_ctu + 1);
+        }
+
+        if(pipe->dbk)
+        {
+            if(y_ctu > 0 && !recon_pipe_deblock(worker, y_ctu - 1))
+            {
+                return EVEY_OK;
+            }
+            if(y_ctu == pipe->y_ctu_end - 1 && !recon_pipe_deblock(worker, y_ctu))
+            {
+                return EVEY_OK;
+            }
+        }
+    }
+    return EVEY_OK;
+ERR:
+    evey_atomic_store(&pipe->abort, 1);
+    return ret;
+}
+
+/* start the reconstruction threads for the slice of ctu_cnt CTUs from the
+   CTU row y_ctu */
+static int recon_pipe_start(EVEYD_CTX * ctx, int y_ctu, int ctu_cnt)
+{
+    EVEYD_RECON_PIPE   * pipe = ctx->recon_pipe;
+    EVEYD_RECON_WORKER * worker;
+    int                  i;
+
+    pipe->y_ctu_beg = y_ctu;
+    pipe->y_ctu_end = y_ctu + ctu_cnt / ctx->w_ctu;
+    /* a picture of several slices is deblocked once all are decoded */
+    pipe->dbk = ctu_cnt == (int)ctx->f_ctu && ctx->sh.slice_deblocking_filter_flag;
+    pipe->ctu_parsed = 0;
+    pipe->row_dbk = 0;
+    pipe->abort = 0;
+    for(i = pipe->y_ctu_beg; i < pipe->y_ctu_end; i++)
+    {
+        pipe->ctu_recon[i] = 0;
+    }
+
+    for(i = 0; i < pipe->worker_num; i++)
+    {
+        worker = &pipe->worker[i];
+        worker->y_ctu = y_ctu + i;
+        worker->recon_ns = 0;
+        worker->dbk_ns = 0;
+        if(worker->y_ctu < pipe->y_ctu_end)
+        {
+            worker->thread = evey_thread_create(recon_pipe_run, worker);
+            evey_assert_rv(worker->thread != NULL, EVEY_ERR_UNKNOWN);
+        }
+    }
+    return EVEY_OK;
+}
+
+/* get the syntax record of the CTU of the slice, once the CTU which used the
+   record before is reconstructed. returns NULL if the slice was aborted */
+static EVEYD_CTU_SYN * recon_pipe_syn(EVEYD_CTX * ctx, int ctu_num)
+{
+    EVEYD_RECON_PIPE * pipe = ctx->recon_pipe;
+    int                prev = ctu_num - pipe->syn_num;
+
+    if(prev >= 0 &&
+       !recon_pipe_wait(pipe, &pipe->ctu_recon[pipe->y_ctu_beg + prev / ctx->w_ctu], prev % ctx->w_ctu + 1))
+    {
+        return NULL;
+    }
+    return pipe->syn + ctu_num % pipe->syn_num;
+}
+
+/* wait for the reconstruction threads of the slice */
+static int recon_pipe_finish(EVEYD_CTX * ctx, int abort)
+{
+    EVEYD_RECON_PIPE   * pipe = ctx->recon_pipe;
+    EVEYD_RECON_WORKER * worker;
+    int                  i, ret, ret_thread;
+
+    if(abort)
+    {
+        evey_atomic_store(&pipe->abort, 1);
+    }
+
+    ret = EVEY_OK;
+    for(i = 0; i < pipe->worker_num; i++)
+    {
+        worker = &pipe->worker[i];
+        if(worker->thread == NULL)
+        {
+            continue;
+        }
+        ret_thread = evey_thread_join(worker->thread);
+        worker->thread = NULL;
+        if(ret == EVEY_OK)
+        {
+            ret = ret_thread;
+        }
+        ctx->stage_ns[EVEYD_STAGE_RECON] += worker->recon_ns;
+        ctx->stage_ns[EVEYD_STAGE_DBK] += worker->dbk_ns;
+    }
+    return ret;
+}
+
 static int set_active_pps_info(EVEYD_CTX * ctx)
 {
     int active_pps_id = ctx->sh.slice_pic_parameter_set_id;
@@ -575,47 +793,77 @@ static int set_active_pps_info(EVEYD_CTX * ctx)
 
 static int eveyd_dec_slice(EVEYD_CTX * ctx, EVEYD_CORE * core)
 {
-    int ret;
+    EVEYD_RECON_PIPE * pipe = ctx->recon_pipe;
+    EVEYD_CTU_SYN    * syn;
+    int                ret, y_ctu, ctu_cnt, ctu_num;
+    s64                t0;
 
     ctx->sh.qp_prev_eco = ctx->sh.qp;
 
     /* Initialize arithmetic decoder */
     eveyd_sbac_reset(ctx);
 
+    /* the slice is a tile of CTU rows; slices come in raster order */
+    y_ctu = evey_tile_row_ctu(&ctx->pps, ctx->h_ctu, ctx->sh.first_tile_id);
+    ctu_cnt = (evey_tile_row_ctu(&ctx->pps, ctx->h_ctu, ctx->sh.first_tile_id + 1) - y_ctu) * ctx->w_ctu;
+    evey_assert_rv(y_ctu * ctx->w_ctu == (int)(ctx->f_ctu - ctx->ctu_cnt), EVEY_ERR_MALFORMED_BITSTREAM);
+    evey_assert_rv(ctu_cnt > 0 && ctu_cnt <= (int)ctx->ctu_cnt, EVEY_ERR_MALFORMED_BITSTREAM);
+
+    /* nothing is predicted from the slices above */
+    evey_clr_cod_above(ctx, ctx->map_scu, y_ctu);
+    ctx->y_scu_slice = y_ctu << (ctx->log2_ctu_size - MIN_CU_LOG2);
+
     core->x_ctu = 0;
-    core->y_ctu = 0;
-        
+    core->y_ctu = y_ctu;
+
+    if(pipe)
+    {
+        ret = recon_pipe_start(ctx, y_ctu, ctu_cnt);
+        evey_assert_g(ret == EVEY_OK, ERR);
+    }
+
     /* CTU decoding loop */
-    while(ctx->ctu_cnt > 0)
+    for(ctu_num = 0; ctu_num < ctu_cnt; ctu_num++)
     {
         evey_update_core_loc_param(ctx, core);        
-        evey_assert_rv(core->ctu_num < ctx->f_ctu, EVEY_ERR_UNEXPECTED);
+        evey_assert_gv(core->ctu_num < ctx->f_ctu, ret, EVEY_ERR_UNEXPECTED, ERR);
+
+        if(pipe)
+        {
+            syn = recon_pipe_syn(ctx, ctu_num);
+            evey_assert_gv(syn != NULL, ret, EVEY_ERR_UNKNOWN, ERR);
+        }
+        else
+        {
+            syn = ctx->syn;
+        }
+        core->syn = syn;
 
         /* initialize the map for split flags */
         evey_mset(ctx->map_split[core->ctu_num], 0, sizeof(s8) * NUM_CU_DEPTH * NUM_BLOCK_SHAPE * MAX_CU_CNT_IN_CTU);
         
         /* parse a CTU */
+        t0 = evey_time_ns();
         ret = eveyd_eco_tree(ctx, core, core->x_pel, core->y_pel, ctx->log2_ctu_size, ctx->log2_ctu_size, 0, 0);
         evey_assert_g(EVEY_SUCCEEDED(ret), ERR);
+        syn->qp_y = core->qp_y;
+        syn->qp_u = core->qp_u;
+        syn->qp_v = core->qp_v;
+        ctx->stage_ns[EVEYD_STAGE_ECO] += evey_time_ns() - t0;
 
-        /* reset all coded flags for the current ctu */
-        evey_update_core_loc_param(ctx, core);
-        u32 *map_scu;
-        int i, j, w, h;
-        map_scu = ctx->map_scu + ((u32)core->y_scu * ctx->w_scu) + core->x_scu;
-        w = EVEY_MIN(1 << (ctx->log2_ctu_size - MIN_CU_LOG2), ctx->w_scu - core->x_scu);
-        h = EVEY_MIN(1 << (ctx->log2_ctu_size - MIN_CU_LOG2), ctx->h_scu - core->y_scu);
-        for(i = 0; i < h; i++)
+        if(pipe)
         {
-            for(j = 0; j < w; j++)
-            {
-                MCU_CLR_COD(map_scu[j]);
-            }
-            map_scu += ctx->w_scu;
+            /* hand the CTU over to the reconstruction threads */
+            evey_atomic_store(&pipe->ctu_parsed, ctu_num + 1);
+        }
+        else
+        {
+            /* decode a CTU */
+            t0 = evey_time_ns();
+            ret = eveyd_recon_ctu(ctx, core, syn);
+            evey_assert_g(ret == EVEY_OK, ERR);
+            ctx->stage_ns[EVEYD_STAGE_RECON] += evey_time_ns() - t0;
         }
-
-        /* decode a CTU */
-        eveyd_dec_tree(ctx, core, core->x_pel, core->y_pel, ctx->log2_ctu_size, ctx->log2_ctu_size, 0, 0);
 
         core->x_ctu++;
         if(core->x_ctu >= ctx->w_ctu)
@@ -630,40 +878,88 @@ static int eveyd_dec_slice(EVEYD_CTX * ctx, EVEYD_CORE * core)
     ret = eveyd_eco_tile_end_flag(&ctx->bs);
     assert(ret == 1);
 
+    if(pipe)
+    {
+        ret = recon_pipe_finish(ctx, 0);
+        evey_assert_rv(ret == EVEY_OK, ret);
+    }
+
     return EVEY_OK;
 
 ERR:
+    if(pipe)
+    {
+        recon_pipe_finish(ctx, 1);
+    }
     return ret;
 }
 
 static int eveyd_ready(EVEYD_CTX * ctx)
 {
-    int          ret = EVEY_OK;
-    EVEYD_CORE * core = NULL;
+    int                ret = EVEY_OK;
+    EVEYD_CORE       * core = NULL;
+    EVEYD_RECON_PIPE * pipe;
+    int                i;
 
     evey_assert(ctx);
 
     core = core_alloc();
     evey_assert_gv(core != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
-
     ctx->core = core;
-    return EVEY_OK;
-ERR:
-    if(core)
+
+    ctx->syn = (EVEYD_CTU_SYN *)evey_malloc_fast(sizeof(EVEYD_CTU_SYN));
+    evey_assert_gv(ctx->syn != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
+
+    if(ctx->cdsc.recon_threads > 0)
     {
-        core_free(core);
+        /* the syntax records are allocated with the maps of the sequence */
+        pipe = (EVEYD_RECON_PIPE *)evey_malloc(sizeof(EVEYD_RECON_PIPE));
+        evey_assert_gv(pipe != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
+        evey_mset(pipe, 0, sizeof(EVEYD_RECON_PIPE));
+        ctx->recon_pipe = pipe;
+
+        pipe->ctx = ctx;
+        pipe->worker_num = ctx->cdsc.recon_threads;
+        for(i = 0; i < pipe->worker_num; i++)
+        {
+            pipe->worker[i].pipe = pipe;
+            pipe->worker[i].core = core_alloc();
+            evey_assert_gv(pipe->worker[i].core != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
+        }
     }
-
+    return EVEY_OK;
+ERR:
+    /* released by eveyd_flush() */
     return ret;
 }
 
 static void eveyd_flush(EVEYD_CTX * ctx)
 {
+    EVEYD_RECON_PIPE * pipe = ctx->recon_pipe;
+    int                i;
+
     if(ctx->core)
     {
         core_free(ctx->core);
         ctx->core = NULL;
     }
+    if(ctx->syn)
+    {
+        evey_mfree_fast(ctx->syn);
+        ctx->syn = NULL;
+    }
+    if(pipe)
+    {
+        for(i = 0; i < pipe->worker_num; i++)
+        {
+            if(pipe->worker[i].core)
+            {
+                core_free(pipe->worker[i].core);
+            }
+        }
+        evey_mfree(pipe);
+        ctx->recon_pipe = NULL;
+    }
 }
 
 static int eveyd_dec_nalu(EVEYD_CTX * ctx, EVEY_BITB * bitb, EVEYD_STAT * stat)
@@ -674,8 +970,10 @@ static int eveyd_dec_nalu(EVEYD_CTX * ctx, EVEY_BITB * bitb, EVEYD_STAT * stat)
     EVEY_SH   * sh = &ctx->sh;
     EVEY_NALU * nalu = &ctx->nalu;
     int         ret;
+    s64         t0;
 
     ret = EVEY_OK;
+    evey_mset(ctx->stage_ns, 0, sizeof(ctx->stage_ns));
     /* set error status */
     ctx->bs_err = bitb->err;
 #if TRACE_START_POC
@@ -747,21 +1045,27 @@ static int eveyd_dec_nalu(EVEYD_CTX * ctx, EVEY_BITB * bitb, EVEYD_STAT * stat)
         else
         {
             ctx->slice_ref_flag = (ctx->nalu.nuh_temporal_id == 0 || ctx->nalu.nuh_temporal_id < ctx->sps.log2_sub_gop_length);
-            evey_poc_derivation(&ctx->sps, ctx->nalu.nuh_temporal_id, &ctx->poc);
+            /* once for the first slice of a picture */
+            if(ctx->ctu_cnt == 0)
+            {
+                evey_poc_derivation(&ctx->sps, ctx->nalu.nuh_temporal_id, &ctx->poc);
+            }
             sh->poc_lsb = ctx->poc.poc_val;
         }
 
         ret = slice_init(ctx, ctx->core, sh);
         evey_assert_rv(EVEY_SUCCEEDED(ret), ret);
 
-        static u16 slice_num = 0;        
+        /* numbered per picture in the context, as decoders can run side by side */
         if (ctx->ctu_cnt == 0)
         {
             ctx->ctu_cnt = ctx->f_ctu;
-            slice_num = 0;
+            ctx->slice_num = 0;
+        }
+        else
+        {
+            ctx->slice_num++;
         }
-        ctx->slice_num = slice_num;
-        slice_num++;
 
 #if TRACE_START_POC
         if (ctx->poc.poc_val == TRACE_START_POC)
@@ -772,6 +1076,7 @@ static int eveyd_dec_nalu(EVEYD_CTX * ctx, EVEY_BITB * bitb, EVEYD_STAT * stat)
 #endif
 
         /* initialize reference pictures */
+        t0 = evey_time_ns();
         ret = evey_picman_refp_init(ctx);
         evey_assert_rv(ret == EVEY_OK, ret);
 
@@ -794,19 +1099,23 @@ static int eveyd_dec_nalu(EVEYD_CTX * ctx, EVEY_BITB * bitb, EVEYD_STAT * stat)
 
             ctx->pic->imgb->imgb_active_pps_id = ctx->pps.pps_pic_parameter_set_id;
         }
+        ctx->stage_ns[EVEYD_STAGE_PICMAN] += evey_time_ns() - t0;
 
         /* decode slice layer */
         ret = ctx->fn_dec_slice(ctx, ctx->core);
         evey_assert_rv(EVEY_SUCCEEDED(ret), ret);
 
-        /* deblocking filter */
-        if(ctx->sh.slice_deblocking_filter_flag)
+        /* deblocking filter, once all slices of the picture are decoded.
+           the pipeline deblocks a picture of one slice row by row */
+        if(ctx->ctu_cnt == 0 && ctx->sh.slice_deblocking_filter_flag && !(ctx->recon_pipe && ctx->recon_pipe->dbk))
         {
 #if TRACE_DBF
             EVEY_TRACE_SET(1);
 #endif
+            t0 = evey_time_ns();
             ret = ctx->fn_deblock(ctx);
             evey_assert_rv(EVEY_SUCCEEDED(ret), ret);
+            ctx->stage_ns[EVEYD_STAGE_DBK] += evey_time_ns() - t0;
 #if TRACE_DBF
             EVEY_TRACE_SET(0);
 #endif
@@ -817,10 +1126,12 @@ static int eveyd_dec_nalu(EVEYD_CTX * ctx, EVEY_BITB * bitb, EVEYD_STAT * stat)
 #endif
         if (ctx->ctu_cnt == 0)
         {
+            t0 = evey_time_ns();
 #if PIC_PAD_SIZE_L > 0
             /* expand pixels to padding area */
             ctx->dpbm.pa.fn_expand(ctx->pic);
 #endif
+            ctx->stage_ns[EVEYD_STAGE_PICMAN] += evey_time_ns() - t0;
 
             if (ctx->use_opl)
             {
@@ -830,8 +1141,10 @@ static int eveyd_dec_nalu(EVEYD_CTX * ctx, EVEY_BITB * bitb, EVEYD_STAT * stat)
             }
 
             /* put decoded picture to DPB */
+            t0 = evey_time_ns();
             ret = evey_picman_put_pic(ctx, ctx->pic, 1);
             evey_assert_rv(EVEY_SUCCEEDED(ret), ret);
+            ctx->stage_ns[EVEYD_STAGE_PICMAN] += evey_time_ns() - t0;
         }
         slice_deinit(ctx);
     }
@@ -949,6 +1262,9 @@ EVEYD eveyd_create(EVEYD_CDSC * cdsc, int * err)
     ctx = ctx_alloc();
     evey_assert_gv(ctx != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
     evey_mcpy(&ctx->cdsc, cdsc, sizeof(EVEYD_CDSC));
+    /* select kernels; keep the level actually used */
+    ctx->cdsc.isa = evey_kfn_init(cdsc->isa);
+    ctx->cdsc.recon_threads = EVEY_CLIP3(0, EVEYD_RECON_THREADS_MAX, cdsc->recon_threads);
     /* additional initialization for each platform, if needed */
     ret = eveyd_platform_init(ctx);
     evey_assert_g(ret == EVEY_OK, ERR);
@@ -997,6 +1313,40 @@ void eveyd_delete(EVEYD id)
     ctx_free(ctx);
 }
 
+static void add_cnt(EVEYD_STATS * stats, EVEYD_CNT * cnt)
+{
+    int i;
+
+    for(i = 0; i < EVEYD_STATS_CU_DEPTH_NUM; i++)
+    {
+        stats->cu_cnt[i] += cnt->cu[i];
+    }
+    for(i = 0; i < EVEYD_STATS_IPD_NUM; i++)
+    {
+        stats->intra_cu_cnt[i] += cnt->intra_cu[i];
+    }
+    stats->inter_cu_cnt += cnt->inter_cu;
+    stats->skip_cu_cnt += cnt->skip_cu;
+}
+
+static void get_stats(EVEYD_CTX * ctx, EVEYD_STATS * stats)
+{
+    int i;
+
+    *stats = ctx->stats;
+    stats->dbk_edge_cnt = ctx->dbk_edge_cnt;
+
+    /* add up the counters of the cores */
+    add_cnt(stats, &ctx->core->cnt);
+    if(ctx->recon_pipe)
+    {
+        for(i = 0; i < ctx->recon_pipe->worker_num; i++)
+        {
+            add_cnt(stats, &ctx->recon_pipe->worker[i].core->cnt);
+        }
+    }
+}
+
 int eveyd_config(EVEYD id, int cfg, void * buf, int * size)
 {
     EVEYD_CTX *ctx;
@@ -1015,6 +1365,16 @@ int eveyd_config(EVEYD id, int cfg, void * buf, int * size)
             break;
 
         /* get config ************************************************************/
+        case EVEYD_CFG_GET_ISA:
+            evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
+            *((int *)buf) = ctx->cdsc.isa;
+            break;
+
+        case EVEYD_CFG_GET_STATS:
+            evey_assert_rv(*size == sizeof(EVEYD_STATS), EVEY_ERR_INVALID_ARGUMENT);
+            get_stats(ctx, (EVEYD_STATS *)buf);
+            break;
+
         default:
             evey_assert_rv(0, EVEY_ERR_UNSUPPORTED);
     }
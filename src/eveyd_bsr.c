@@ -32,21 +32,18 @@
 #include "eveyd_bsr.h"
 
 
+/* size is 32 at most, so the 64-bit code can always be shifted */
 #define EVEYD_BSR_SKIP_CODE(bs, size) \
     evey_assert((bs)->leftbits >= (size)); \
-    if((size) == 32) {(bs)->code = 0; (bs)->leftbits = 0;} \
-    else           {(bs)->code <<= (size); (bs)->leftbits -= (size);}
+    (bs)->code <<= (size); (bs)->leftbits -= (size);
 
-/* Table of count of leading zero for 4 bit value */
-static const u8 tbl_zero_count4[16] =
-{
-    4, 3, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0
-};
+/* number of bytes loaded to the code buffer by one flush */
+#define EVEYD_BSR_FLUSH_BYTE            8
 
 static int eveyd_bsr_flush(EVEYD_BSR * bs, int byte)
 {
-    int    shift = 24, remained;
-    u32 code = 0;
+    int    shift = 56, remained;
+    u64 code = 0;
 
     evey_assert(byte);
 
@@ -65,7 +62,7 @@ static int eveyd_bsr_flush(EVEYD_BSR * bs, int byte)
     bs->cur += byte;
     while(byte)
     {
-        code |= *(bs->cur - byte) << shift;
+        code |= (u64)*(bs->cur - byte) << shift;
         byte--;
         shift -= 8;
     }
@@ -84,23 +81,11 @@ void eveyd_bsr_init(EVEYD_BSR * bs, u8 * buf, int size, EVEYD_BSR_FN_FLUSH fn_fl
     bs->fn_flush = (fn_flush == NULL)? eveyd_bsr_flush : fn_flush;
 }
 
-int eveyd_bsr_clz_in_code(u32 code)
+int eveyd_bsr_clz_in_code(u64 code)
 {
-    int clz, bits4, shift;
+    if(code == 0) return 64; /* to protect infinite loop */
 
-    if(code == 0) return 32; /* to protect infinite loop */
-
-    bits4 = 0;
-    clz = 0;
-    shift = 28;
-
-    while(bits4 == 0 && shift >= 0)
-    {
-        bits4 = (code >> shift) & 0xf;
-        clz += tbl_zero_count4[bits4];
-        shift -= 4;
-    }
-    return clz;
+    return evey_clz64(code);
 }
 
 #if TRACE_HLS
@@ -112,17 +97,17 @@ void eveyd_bsr_read_trace(EVEYD_BSR * bs, u32 * val, char * name, int size)
 
     if (bs->leftbits < size)
     {
-        code = bs->code >> (32 - size);
+        code = (u32)(bs->code >> (64 - size));
         size -= bs->leftbits;
 
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, EVEYD_BSR_FLUSH_BYTE))
         {
             evey_trace("already reached the end of bitstream\n");
             *val = (u32)-1;
             return;
         }
     }
-    code |= bs->code >> (32 - size);
+    code |= (u32)(bs->code >> (64 - size));
 
     EVEYD_BSR_SKIP_CODE(bs, size);
 
@@ -142,13 +127,13 @@ void eveyd_bsr_read1_trace(EVEYD_BSR * bs, u32 * val, char * name)
     int code;
     if (bs->leftbits == 0)
     {
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, EVEYD_BSR_FLUSH_BYTE))
         {
             evey_trace("already reached the end of bitstream\n");
             return;
         }
     }
-    code = (int)(bs->code >> 31);
+    code = (int)(bs->code >> 63);
 
     bs->code <<= 1;
     bs->leftbits -= 1;
@@ -166,7 +151,7 @@ void eveyd_bsr_read_ue_trace(EVEYD_BSR * bs, u32 * val, char * name)
 {
     int clz, len;
 
-    if ((bs->code >> 31) == 1)
+    if ((bs->code >> 63) == 1)
     {
         /* early termination.
         we don't have to worry about leftbits == 0 case, because if the bs->code
@@ -189,7 +174,7 @@ void eveyd_bsr_read_ue_trace(EVEYD_BSR * bs, u32 * val, char * name)
     {
         clz = bs->leftbits;
 
-        bs->fn_flush(bs, 4);
+        bs->fn_flush(bs, EVEYD_BSR_FLUSH_BYTE);
     }
 
     len = eveyd_bsr_clz_in_code(bs->code);
@@ -250,17 +235,17 @@ void eveyd_bsr_read(EVEYD_BSR * bs, u32 * val, int size)
 
     if (bs->leftbits < size)
     {
-        code = bs->code >> (32 - size);
+        code = (u32)(bs->code >> (64 - size));
         size -= bs->leftbits;
 
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, EVEYD_BSR_FLUSH_BYTE))
         {
             evey_trace("already reached the end of bitstream\n");
             *val = (u32)-1;
             return;
         }
     }
-    code |= bs->code >> (32 - size);
+    code |= (u32)(bs->code >> (64 - size));
 
     EVEYD_BSR_SKIP_CODE(bs, size);
 
@@ -272,13 +257,13 @@ void eveyd_bsr_read1(EVEYD_BSR * bs, u32 * val)
     int code;
     if (bs->leftbits == 0)
     {
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, EVEYD_BSR_FLUSH_BYTE))
         {
             evey_trace("already reached the end of bitstream\n");
             return;
         }
     }
-    code = (int)(bs->code >> 31);
+    code = (int)(bs->code >> 63);
 
     bs->code <<= 1;
     bs->leftbits -= 1;
@@ -289,7 +274,7 @@ void eveyd_bsr_read_ue(EVEYD_BSR * bs, u32 * val)
 {
     int clz, len;
 
-    if((bs->code >> 31) == 1)
+    if((bs->code >> 63) == 1)
     {
         /* early termination.
         we don't have to worry about leftbits == 0 case, because if the bs->code
@@ -305,7 +290,7 @@ void eveyd_bsr_read_ue(EVEYD_BSR * bs, u32 * val)
     {
         clz = bs->leftbits;
 
-        bs->fn_flush(bs, 4);
+        bs->fn_flush(bs, EVEYD_BSR_FLUSH_BYTE);
     }
 
     len = eveyd_bsr_clz_in_code(bs->code);
@@ -51,8 +51,8 @@ typedef int (*EVEYD_BSR_FN_FLUSH)(EVEYD_BSR *bs, int byte);
  */
 struct _EVEYD_BSR
 {
-    /* temporary read code buffer */
-    u32                 code;
+    /* temporary read code buffer, MSB first */
+    u64                 code;
     /* left bits count in code */
     int                 leftbits;
     /*! address of current bitstream position */
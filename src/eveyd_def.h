@@ -53,6 +53,39 @@ typedef struct _EVEYD_SBAC
  *
  * The variables in this structure are very often used in decoding process.
  *****************************************************************************/
+/* counters of the decoding hot paths.
+   each core owns one block, which is added up when the statistics are read */
+typedef struct _EVEYD_CNT
+{
+    u64                     cu[NUM_CU_DEPTH];
+    u64                     intra_cu[IPD_CNT];
+    u64                     inter_cu;
+    u64                     skip_cu;
+
+} EVEYD_CNT;
+
+/* syntax of a CTU, written by the parsing and read by the reconstruction */
+typedef struct _EVEYD_CTU_SYN
+{
+    /* coefficient map */
+    s16                     map_coef[N_C][MAX_CU_DIM];
+    /* SCU map; coded flag, intra flag, cbf, slice number and QP */
+    u32                     map_scu[MAX_CU_CNT_IN_CTU];
+    /* reference index map */
+    s8                      map_refi[MAX_CU_CNT_IN_CTU][LIST_NUM];
+    /* mvd map */
+    s16                     map_mvd[MAX_CU_CNT_IN_CTU][LIST_NUM][MV_D];
+    /* mvp index map */
+    int                     map_mvp_idx[MAX_CU_CNT_IN_CTU][LIST_NUM];
+    /* inter_dir map */
+    int                     map_inter_dir[MAX_CU_CNT_IN_CTU];
+    /* QPs of the core at the end of the parsing, used by the transform */
+    u8                      qp_y;
+    u8                      qp_u;
+    u8                      qp_v;
+
+} EVEYD_CTU_SYN;
+
 typedef struct _EVEYD_CORE
 {
     EVEY_CORE; /* should be first */
@@ -67,30 +100,74 @@ typedef struct _EVEYD_CORE
     s16                     mvd[LIST_NUM][MV_D];
     /* inter prediction indicator for current CU */
     int                     inter_dir;
-    /* coefficient map for current CTU */
-    s16                     map_coef[N_C][MAX_CU_DIM];
-    /* mvd map for current CTU */
-    s16                     map_mvd[MAX_CU_CNT_IN_CTU][LIST_NUM][MV_D];
-    /* mvp index map for current CTU */
-    int                     map_mvp_idx[MAX_CU_CNT_IN_CTU][LIST_NUM];
-    /* inter_dir map for current CTU */
-    int                     map_inter_dir[MAX_CU_CNT_IN_CTU];
+    /* syntax record of current CTU */
+    EVEYD_CTU_SYN         * syn;
 
 #if TRACE_ENC_CU_DATA
     u64                     trace_idx;
 #endif
+    /* hot path counters */
+    EVEYD_CNT               cnt;
 
     /* platform specific data, if needed */
     void                  * pf;
 
 } EVEYD_CORE;
 
+typedef struct _EVEYD_CTX EVEYD_CTX;
+
+/* maximum number of reconstruction threads of a decoder */
+#define EVEYD_RECON_THREADS_MAX   32
+
+typedef struct _EVEYD_RECON_PIPE EVEYD_RECON_PIPE;
+
+/* reconstruction thread; it takes every worker_num-th CTU row of a slice */
+typedef struct _EVEYD_RECON_WORKER
+{
+    EVEY_THREAD             thread;
+    EVEYD_RECON_PIPE      * pipe;
+    EVEYD_CORE            * core;
+    /* first CTU row of the slice taken by the thread */
+    int                     y_ctu;
+    /* wall time of the reconstruction and deblocking for the slice */
+    s64                     recon_ns;
+    s64                     dbk_ns;
+
+} EVEYD_RECON_WORKER;
+
+/* parsing and reconstruction pipeline. the calling thread parses the CTUs of
+   a slice into a ring of syntax records, and the reconstruction threads
+   reconstruct the CTU rows in wavefront order, each CTU after the CTU above
+   right of it. the deblocking of a CTU row follows the reconstruction of the
+   row below it when the slice is the whole picture */
+struct _EVEYD_RECON_PIPE
+{
+    EVEYD_CTX             * ctx;
+    EVEYD_RECON_WORKER      worker[EVEYD_RECON_THREADS_MAX];
+    int                     worker_num;
+    /* ring of syntax records of syn_num CTUs, in whole CTU rows */
+    EVEYD_CTU_SYN         * syn;
+    int                     syn_num;
+    /* CTU rows of the slice, from y_ctu_beg to y_ctu_end (exclusive) */
+    int                     y_ctu_beg;
+    int                     y_ctu_end;
+    /* deblock the CTU rows as they are reconstructed */
+    int                     dbk;
+    /* number of CTUs of the slice parsed */
+    volatile int            ctu_parsed;
+    /* number of CTUs reconstructed in each CTU row of the picture */
+    volatile int          * ctu_recon;
+    /* number of CTU rows deblocked */
+    volatile int            row_dbk;
+    /* set when the slice cannot be decoded */
+    volatile int            abort;
+};
+
 /******************************************************************************
  * CONTEXT used for decoding process.
  *
  * All have to be stored are in this structure.
  *****************************************************************************/
-typedef struct _EVEYD_CTX EVEYD_CTX;
 struct _EVEYD_CTX
 {
     EVEY_CTX; /* should be first */
@@ -101,6 +178,12 @@ struct _EVEYD_CTX
     EVEYD_CDSC              cdsc;    
     /* CORE information used for fast operation */
     EVEYD_CORE            * core;
+    /* syntax record of the CTU reconstructed on the calling thread */
+    EVEYD_CTU_SYN         * syn;
+    /* parsing and reconstruction pipeline, NULL if not used */
+    EVEYD_RECON_PIPE      * recon_pipe;
+    /* first SCU row of the current slice */
+    int                     y_scu_slice;
     /* SBAC */
     EVEYD_SBAC              sbac_dec;
     /* current decoding bitstream */
@@ -115,6 +198,10 @@ struct _EVEYD_CTX
     u8                      pic_sign_exist;
     /* flag to indicate opl decoder output */
     u8                      use_opl;
+    /* wall time of each stage (EVEYD_STAGE_XXX) for the current NALU */
+    s64                     stage_ns[EVEYD_STAGE_NUM];
+    /* picture level statistics; the core counters are added on read */
+    EVEYD_STATS             stats;
     
     /* address of ready function */
     int  (* fn_ready)(EVEYD_CTX * ctx);
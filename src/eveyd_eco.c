@@ -34,9 +34,25 @@
 #pragma warning(disable:4018)
 
 
+/* shift the range up to 8192 or above at once, reading all the bits
+   needed for the value by one call */
+static __inline void sbac_renorm(EVEYD_BSR * bs, EVEYD_SBAC * sbac)
+{
+    u32 t0;
+    int shift = evey_clz32(sbac->range) - 18;
+
+    sbac->range <<= shift;
+#if TRACE_HLS
+    eveyd_bsr_read_trace(bs, &t0, 0, shift);
+#else
+    eveyd_bsr_read(bs, &t0, shift);
+#endif
+    sbac->value = ((sbac->value << shift) | t0) & 0xFFFF;
+}
+
 u32 eveyd_sbac_decode_bin(EVEYD_BSR * bs, EVEYD_SBAC * sbac, SBAC_CTX_MODEL * model)
 {
-    u32 bin, lps, t0;
+    u32 bin, lps;
     u16 mps, state;
 
     state = (*model) >> 1;
@@ -81,15 +97,9 @@ u32 eveyd_sbac_decode_bin(EVEYD_BSR * bs, EVEYD_SBAC * sbac, SBAC_CTX_MODEL * mo
         *model = (state << 1) + mps;
     }
 
-    while(sbac->range < 8192)
+    if(sbac->range < 8192)
     {
-        sbac->range <<= 1;
-#if TRACE_HLS
-        eveyd_bsr_read1_trace(bs, &t0, 0);
-#else
-        eveyd_bsr_read1(bs, &t0);
-#endif
-        sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
+        sbac_renorm(bs, sbac);
     }
 
     return bin;
@@ -150,19 +160,45 @@ static u32 eveyd_sbac_decode_bin_trm(EVEYD_BSR * bs, EVEYD_SBAC * sbac)
     else
     {
         bin = 0;
-        while(sbac->range < 8192)
+        if(sbac->range < 8192)
         {
-            sbac->range <<= 1;
+            sbac_renorm(bs, sbac);
+        }
+    }
+
+    return bin;
+}
+
+/* decode num_bin bypass bins (num_bin: 1 ~ 16), MSB first. The bits of all
+   the bins are read at once and the value is compared with the scaled half
+   range for each bin */
+static u32 sbac_decode_bins_ep(EVEYD_BSR * bs, EVEYD_SBAC * sbac, int num_bin)
+{
+    u32 bins = 0, t0, half, value;
+    int i;
+
+    half = sbac->range >> 1;
 #if TRACE_HLS
-            eveyd_bsr_read1_trace(bs, &t0, 0);
+    eveyd_bsr_read_trace(bs, &t0, 0, num_bin);
 #else
-            eveyd_bsr_read1(bs, &t0);
+    eveyd_bsr_read(bs, &t0, num_bin);
 #endif
-            sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
+    value = (sbac->value << num_bin) | t0;
+
+    for(i = num_bin; i > 0; i--)
+    {
+        bins <<= 1;
+        if(value >= (half << i))
+        {
+            bins |= 1;
+            value -= (half << i);
         }
     }
 
-    return bin;
+    sbac->range = half << 1;
+    sbac->value = value & 0xFFFF;
+
+    return bins;
 }
 
 static u32 sbac_read_unary_sym_ep(EVEYD_BSR * bs, EVEYD_SBAC * sbac, u32 max_val)
@@ -190,22 +226,6 @@ static u32 sbac_read_unary_sym_ep(EVEYD_BSR * bs, EVEYD_SBAC * sbac, u32 max_val
     return symbol;
 }
 
-static u32 sbac_decode_bins_ep(EVEYD_BSR *bs, EVEYD_SBAC *sbac, int num_bin)
-{
-    int bin = 0;
-    u32 value = 0;
-
-    for(bin = num_bin - 1; bin >= 0; bin--)
-    {
-        if(sbac_decode_bin_ep(bs, sbac))
-        {
-            value += (1 << bin);
-        }
-    }
-
-    return value;
-}
-
 static u32 sbac_read_unary_sym(EVEYD_BSR * bs, EVEYD_SBAC * sbac, SBAC_CTX_MODEL * model, u32 num_ctx)
 {
     u32 ctx_idx = 0;
@@ -526,13 +546,12 @@ static u32 eveyd_eco_abs_mvd(EVEYD_BSR *bs, EVEYD_SBAC *sbac, SBAC_CTX_MODEL *mo
         }
         val = (1 << len) - 1;
 
+        /* suffix bins are all bypass coded */
         while(len != 0)
         {
-            if(len == 0)
-                code = eveyd_sbac_decode_bin(bs, sbac, model);
-            else
-                code = sbac_decode_bin_ep(bs, sbac);
-            val += (code << (--len));
+            int bins = EVEY_MIN(len, 16);
+            len -= bins;
+            val += sbac_decode_bins_ep(bs, sbac, bins) << len;
         }
     }
 
@@ -725,19 +744,15 @@ void eveyd_sbac_reset(EVEYD_CTX * ctx)
     evey_eco_init_ctx_model(&sbac->ctx);
 
     /* Initialization of the internal variables */
-    int i;
     u32 t0;
     sbac->range = 16384;
     sbac->value = 0;
-    for(i = 0; i < 14; i++)
-    {
 #if TRACE_HLS
-        eveyd_bsr_read1_trace(bs, &t0, 0);
+    eveyd_bsr_read_trace(bs, &t0, 0, 14);
 #else
-        eveyd_bsr_read1(bs, &t0);
+    eveyd_bsr_read(bs, &t0, 14);
 #endif
-        sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
-    }
+    sbac->value = t0 & 0xFFFF;
 }
 
 static int eveyd_eco_intra_dir(EVEYD_BSR * bs, EVEYD_SBAC * sbac, u8 * mpm)
@@ -870,6 +885,35 @@ void eveyd_eco_cu_skip_flag(EVEYD_CTX * ctx, EVEYD_CORE * core)
     }
 }
 
+/* most probable modes from the modes of the left and above CUs. the
+   neighbours are taken by position, as the coded flags of the SCU map belong
+   to the reconstruction; left and above CUs are parsed before the current CU
+   when they are in the slice */
+static void get_mpm(EVEYD_CTX * ctx, EVEYD_CORE * core)
+{
+    u8  ipm_l = IPD_DC;
+    u8  ipm_u = IPD_DC;
+    u32 scup;
+
+    if(core->x_scu > 0)
+    {
+        scup = SCU_IDX(core->x_scu - 1, core->y_scu, ctx->w_scu);
+        if(ctx->map_pred_mode[scup] == MODE_INTRA)
+        {
+            ipm_l = ctx->map_ipm[scup] + 1;
+        }
+    }
+    if(core->y_scu > ctx->y_scu_slice)
+    {
+        scup = SCU_IDX(core->x_scu, core->y_scu - 1, ctx->w_scu);
+        if(ctx->map_pred_mode[scup] == MODE_INTRA)
+        {
+            ipm_u = ctx->map_ipm[scup] + 1;
+        }
+    }
+    core->mpm_b_list = (u8*)&evey_tbl_mpm[ipm_l][ipm_u];
+}
+
 int eveyd_eco_cu(EVEYD_CTX * ctx, EVEYD_CORE * core)
 {
     EVEYD_SBAC * sbac;
@@ -957,7 +1001,7 @@ int eveyd_eco_cu(EVEYD_CTX * ctx, EVEYD_CORE * core)
         }
         else if (core->pred_mode == MODE_INTRA)
         {
-            evey_get_mpm(ctx, core);
+            get_mpm(ctx, core);
 
             int luma_ipm = IPD_DC;
 
@@ -1235,9 +1279,37 @@ int eveyd_eco_pps(EVEYD_BSR * bs, EVEY_SPS * sps, EVEY_PPS * pps)
     eveyd_bsr_read_ue(bs, &pps->num_ref_idx_default_active_minus1[1]);
     eveyd_bsr_read_ue(bs, &pps->additional_lt_poc_lsb_len);
     eveyd_bsr_read1(bs, &pps->rpl1_idx_present_flag);
-    eveyd_bsr_read1(bs, &pps->single_tile_in_pic_flag); /* Should be 1 */
-    evey_assert(pps->single_tile_in_pic_flag == 1);
-    eveyd_bsr_read_ue(bs, &pps->tile_id_len_minus1);    /* Not used, but should be read */
+    eveyd_bsr_read1(bs, &pps->single_tile_in_pic_flag);
+    if(!pps->single_tile_in_pic_flag)
+    {
+        /* tiles of one column, each coded as a slice */
+        eveyd_bsr_read_ue(bs, &pps->num_tile_columns_minus1);
+        eveyd_bsr_read_ue(bs, &pps->num_tile_rows_minus1);
+        evey_assert_rv(pps->num_tile_columns_minus1 < MAX_NUM_TILES_COL, EVEY_ERR_UNSUPPORTED);
+        evey_assert_rv(pps->num_tile_rows_minus1 < MAX_NUM_TILES_ROW, EVEY_ERR_UNSUPPORTED);
+        eveyd_bsr_read1(bs, &pps->uniform_tile_spacing_flag);
+        if(!pps->uniform_tile_spacing_flag)
+        {
+            for(int i = 0; i < pps->num_tile_columns_minus1; i++)
+            {
+                eveyd_bsr_read_ue(bs, &pps->tile_column_width_minus1[i]);
+            }
+            for(int i = 0; i < pps->num_tile_rows_minus1; i++)
+            {
+                eveyd_bsr_read_ue(bs, &pps->tile_row_height_minus1[i]);
+            }
+        }
+        eveyd_bsr_read1(bs, &pps->loop_filter_across_tiles_enabled_flag);
+        eveyd_bsr_read_ue(bs, &pps->tile_offset_lens_minus1);
+    }
+    else
+    {
+        pps->num_tile_columns_minus1 = 0;
+        pps->num_tile_rows_minus1 = 0;
+        pps->loop_filter_across_tiles_enabled_flag = 1;
+    }
+    eveyd_bsr_read_ue(bs, &pps->tile_id_len_minus1);
+    evey_assert_rv(pps->tile_id_len_minus1 < 16, EVEY_ERR_MALFORMED_BITSTREAM);
     eveyd_bsr_read1(bs, &pps->explicit_tile_id_flag);   /* Not used, but should be read */
     if(pps->explicit_tile_id_flag)
     {
@@ -1288,6 +1360,21 @@ int eveyd_eco_sh(EVEYD_BSR * bs, EVEY_SPS * sps, EVEY_PPS * pps, EVEY_SH * sh, i
     eveyd_bsr_read_ue(bs, &sh->slice_pic_parameter_set_id);
     assert(sh->slice_pic_parameter_set_id >= 0 && sh->slice_pic_parameter_set_id < MAX_NUM_PPS);
 
+    sh->single_tile_in_slice_flag = 1;
+    sh->first_tile_id = 0;
+    if(!pps->single_tile_in_pic_flag)
+    {
+        eveyd_bsr_read1(bs, &sh->single_tile_in_slice_flag);
+        eveyd_bsr_read(bs, &sh->first_tile_id, pps->tile_id_len_minus1 + 1);
+        /* slices of several tiles are not supported */
+        evey_assert_rv(sh->single_tile_in_slice_flag, EVEY_ERR_UNSUPPORTED);
+        if(sh->first_tile_id > pps->num_tile_rows_minus1)
+        {
+            evey_trace("malformed bitstream: first_tile_id out of the tiles of the picture\n");
+            return EVEY_ERR_MALFORMED_BITSTREAM;
+        }
+    }
+
     eveyd_bsr_read_ue(bs, &sh->slice_type);
 
     if(nut == EVEY_IDR_NUT)
@@ -78,8 +78,8 @@ void eveyd_set_mv_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y)
             evey_mcpy(&map_refi[j], core->refi, sizeof(core->refi)); /* ref_idx can be updated in CU decoding process */
             evey_mcpy(&map_mv[j], core->mv, sizeof(core->mv));
         }
-        map_refi += ctx->w_scu;
-        map_mv += ctx->w_scu;
+        map_refi += SCU_STRIDE(ctx->w_scu);
+        map_mv += SCU_STRIDE(ctx->w_scu);
     }
 }
 
@@ -89,6 +89,7 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
 #endif
 )
 {
+    EVEYD_CTU_SYN * syn = core->syn;
     u32  * map_scu;
     s8   * map_ipm;
     u8   * map_pred_mode;
@@ -96,6 +97,7 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
     s16 (* map_mvd)[LIST_NUM][MV_D];
     int (* map_mvp_idx)[LIST_NUM];
     int  * map_inter_dir;
+    u32    scu;
     int    w_cu;
     int    h_cu;
     int    cup;
@@ -105,15 +107,17 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
 
     w_cu = (1 << core->log2_cuw) >> MIN_CU_LOG2;
     h_cu = (1 << core->log2_cuh) >> MIN_CU_LOG2;
-    map_scu  = ctx->map_scu + core->scup;
     map_ipm  = ctx->map_ipm + core->scup;
     map_pred_mode = ctx->map_pred_mode + core->scup;
-    map_refi = ctx->map_refi + core->scup;
     w_ctu_in_scu = PEL2SCU(ctx->ctu_size);
     cup = PEL2SCU(x - core->x_pel) + PEL2SCU(y - core->y_pel) * w_ctu_in_scu;
-    map_mvd = core->map_mvd + cup;
-    map_mvp_idx = core->map_mvp_idx + cup;
-    map_inter_dir = core->map_inter_dir + cup;
+    /* the SCU map and the reference indices of the picture are set by the
+       reconstruction, parsing only uses the maps of the intra modes */
+    map_scu = syn->map_scu + cup;
+    map_refi = syn->map_refi + cup;
+    map_mvd = syn->map_mvd + cup;
+    map_mvp_idx = syn->map_mvp_idx + cup;
+    map_inter_dir = syn->map_inter_dir + cup;
 
     flag = (core->pred_mode == MODE_INTRA) ? 1 : 0;
 
@@ -122,40 +126,30 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
         for(j = 0; j < w_cu; j++)
         {
             int sub_idx = ((!!(i & 32)) << 1) | (!!(j & 32));
+
+            scu = 0;
             if (core->nnz_sub[Y_C][sub_idx])
             {
-                MCU_SET_CBFL(map_scu[j]);
-            }
-            else
-            {
-                MCU_CLR_CBFL(map_scu[j]);
+                MCU_SET_CBFL(scu);
             }
             if(core->nnz_sub[U_C][sub_idx])
             {
-                MCU_SET_CBFCB(map_scu[j]);
-            }
-            else
-            {
-                MCU_CLR_CBFCB(map_scu[j]);
+                MCU_SET_CBFCB(scu);
             }
             if(core->nnz_sub[V_C][sub_idx])
             {
-                MCU_SET_CBFCR(map_scu[j]);
-            }
-            else
-            {
-                MCU_CLR_CBFCR(map_scu[j]);
+                MCU_SET_CBFCR(scu);
             }
 
             if(ctx->pps.cu_qp_delta_enabled_flag)
             {
-                MCU_RESET_QP(map_scu[j]);
-                MCU_SET_IF_COD_SN_QP(map_scu[j], flag, ctx->slice_num, core->qp);
+                MCU_SET_IF_COD_SN_QP(scu, flag, ctx->slice_num, core->qp);
             }
             else
             {
-                MCU_SET_IF_COD_SN_QP(map_scu[j], flag, ctx->slice_num, ctx->sh.qp);
+                MCU_SET_IF_COD_SN_QP(scu, flag, ctx->slice_num, ctx->sh.qp);
             }
+            map_scu[j] = scu;
 
             map_pred_mode[j] = core->pred_mode;
 
@@ -166,10 +160,10 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
             map_ipm[j] = core->ipm[0];
         }
 
-        map_scu += ctx->w_scu;
-        map_ipm += ctx->w_scu;
-        map_pred_mode += ctx->w_scu;
-        map_refi += ctx->w_scu;
+        map_scu += w_ctu_in_scu;
+        map_ipm += SCU_STRIDE(ctx->w_scu);
+        map_pred_mode += SCU_STRIDE(ctx->w_scu);
+        map_refi += w_ctu_in_scu;
         map_mvd += w_ctu_in_scu;
         map_mvp_idx += w_ctu_in_scu;
         map_inter_dir += w_ctu_in_scu;
@@ -187,12 +181,12 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
 
     for(i = 0; i < cuh; i++)
     {
-        evey_mcpy(core->map_coef[Y_C] + cu_offset + i * ctuw, core->coef[Y_C] + i * cuw, sizeof(s16) * cuw);
+        evey_mcpy(syn->map_coef[Y_C] + cu_offset + i * ctuw, core->coef[Y_C] + i * cuw, sizeof(s16) * cuw);
     }
     for(i = 0; i < cuh_c; i++)
     {
-        evey_mcpy(core->map_coef[U_C] + cu_c_offset + i * ctuw_c, core->coef[U_C] + i * cuw_c, sizeof(s16) * cuw_c);
-        evey_mcpy(core->map_coef[V_C] + cu_c_offset + i * ctuw_c, core->coef[V_C] + i * cuw_c, sizeof(s16) * cuw_c);
+        evey_mcpy(syn->map_coef[U_C] + cu_c_offset + i * ctuw_c, core->coef[U_C] + i * cuw_c, sizeof(s16) * cuw_c);
+        evey_mcpy(syn->map_coef[V_C] + cu_c_offset + i * ctuw_c, core->coef[V_C] + i * cuw_c, sizeof(s16) * cuw_c);
     }
 
 #if MVF_TRACE
@@ -227,9 +221,9 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
 
                 EVEY_TRACE_STR("\n");
             }
-            map_refi += ctx->w_scu;
-            map_mv += ctx->w_scu;
-            map_scu += ctx->w_scu;
+            map_refi += SCU_STRIDE(ctx->w_scu);
+            map_mv += SCU_STRIDE(ctx->w_scu);
+            map_scu += SCU_STRIDE(ctx->w_scu);
         }
     }
 #endif
@@ -237,7 +231,9 @@ void eveyd_set_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y
 
 void eveyd_get_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y)
 {
+    EVEYD_CTU_SYN * syn = core->syn;
     u32  * map_scu;
+    u32  * syn_scu;
     s8   * map_ipm;
     u8   * map_pred_mode;
     s8  (* map_refi)[LIST_NUM];
@@ -262,34 +258,37 @@ void eveyd_get_dec_info(EVEYD_CTX * ctx, EVEYD_CORE * core, int x, int y)
     w_cu = (1 << core->log2_cuw) >> MIN_CU_LOG2;
     h_cu = (1 << core->log2_cuh) >> MIN_CU_LOG2;
 
+    /* the CU is coded from now on */
     map_scu = ctx->map_scu + core->scup;
+    syn_scu = syn->map_scu + cup;
 
     for(i = 0; i < h_cu; i++)
     {
         for(j = 0; j < w_cu; j++)
         {
-            MCU_SET_COD(map_scu[j]);
+            map_scu[j] = syn_scu[j];
         }
-        map_scu += ctx->w_scu;
+        map_scu += SCU_STRIDE(ctx->w_scu);
+        syn_scu += PEL2SCU(ctx->ctu_size);
     }
 
     for(i = 0; i < cuh; i++)
     {
-        evey_mcpy(core->coef[Y_C] + i * cuw, core->map_coef[Y_C] + cu_offset + i * ctuw, sizeof(s16) * cuw);
+        evey_mcpy(core->coef[Y_C] + i * cuw, syn->map_coef[Y_C] + cu_offset + i * ctuw, sizeof(s16) * cuw);
     }
     for(i = 0; i < cuh_c; i++)
     {
-        evey_mcpy(core->coef[U_C] + i * cuw_c, core->map_coef[U_C] + cu_c_offset + i * ctuw_c, sizeof(s16) * cuw_c);
-        evey_mcpy(core->coef[V_C] + i * cuw_c, core->map_coef[V_C] + cu_c_offset + i * ctuw_c, sizeof(s16) * cuw_c);
+        evey_mcpy(core->coef[U_C] + i * cuw_c, syn->map_coef[U_C] + cu_c_offset + i * ctuw_c, sizeof(s16) * cuw_c);
+        evey_mcpy(core->coef[V_C] + i * cuw_c, syn->map_coef[V_C] + cu_c_offset + i * ctuw_c, sizeof(s16) * cuw_c);
     }
 
     map_pred_mode = ctx->map_pred_mode + core->scup;
-    map_refi = ctx->map_refi + core->scup;
+    map_refi = syn->map_refi + cup;
     map_ipm = ctx->map_ipm + core->scup;
     map_scu = ctx->map_scu + core->scup;
-    map_mvd = core->map_mvd + cup;
-    map_mvp_idx = core->map_mvp_idx + cup;
-    map_inter_dir = core->map_inter_dir + cup;
+    map_mvd = syn->map_mvd + cup;
+    map_mvp_idx = syn->map_mvp_idx + cup;
+    map_inter_dir = syn->map_inter_dir + cup;
 
     evey_mcpy(core->refi, map_refi, sizeof(core->refi));
     evey_mcpy(core->mvd, map_mvd, sizeof(core->mvd));
@@ -94,147 +94,116 @@ static EVEYE_CTX * ctx_alloc(void)
     return ctx;
 }
 
-static void eveye_malloc_1d(void ** dst, int size)
+static void ctx_free(EVEYE_CTX * ctx)
 {
-    if(*dst == NULL)
-    {
-        *dst = evey_malloc_fast(size);
-        evey_mset(*dst, 0, size);
-    }
+    evey_mfree_fast(ctx);
 }
 
-static void eveye_malloc_2d(s8 *** dst, int size_1d, int size_2d, int type_size)
+/* buffers of a CU data are carved out of one block, each aligned for SIMD
+   access. without buf, only the size of the block is returned */
+#define CU_DATA_ALIGN(size)             (((size) + 63) & ~63)
+
+static int cu_data_bind(EVEYE_CU_DATA * cu_data, u8 * buf, int log2_cuw, int log2_cuh)
 {
-    int i;
+    int i, j, pos = 0;
+    int cu_cnt, pixel_cnt;
 
-    if(*dst == NULL)
-    {
-        *dst = evey_malloc_fast(size_1d * sizeof(s8*));
-        evey_mset(*dst, 0, size_1d * sizeof(s8*));
+#define CU_DATA_CARVE(ptr, type, size) \
+    { if(buf) (ptr) = (type)(buf + pos); pos += CU_DATA_ALIGN(size); }
 
+    cu_cnt = (1 << log2_cuw) * (1 << log2_cuh);
+    pixel_cnt = cu_cnt << 4;
 
-        (*dst)[0] = evey_malloc_fast(size_1d * size_2d * type_size);
-        evey_mset((*dst)[0], 0, size_1d * size_2d * type_size);
+    CU_DATA_CARVE(cu_data->qp_y, u8 *, cu_cnt * sizeof(u8));
+    CU_DATA_CARVE(cu_data->qp_u, u8 *, cu_cnt * sizeof(u8));
+    CU_DATA_CARVE(cu_data->qp_v, u8 *, cu_cnt * sizeof(u8));
+    CU_DATA_CARVE(cu_data->pred_mode, u8 *, cu_cnt * sizeof(u8));
 
-        for(i = 1; i < size_1d; i++)
+    /* 2D arrays: a row pointer table followed by the rows */
+    CU_DATA_CARVE(cu_data->ipm, s8 **, 2 * sizeof(s8 *));
+    CU_DATA_CARVE(cu_data->refi, s8 **, cu_cnt * sizeof(s8 *));
+    CU_DATA_CARVE(cu_data->mvp_idx, u8 **, cu_cnt * sizeof(u8 *));
+    if(buf)
+    {
+        for(i = 0; i < 2; i++)
         {
-            (*dst)[i] = (*dst)[i - 1] + size_2d * type_size;
+            cu_data->ipm[i] = (s8 *)(buf + pos) + i * cu_cnt;
         }
     }
-}
-
-static void ctx_free(EVEYE_CTX * ctx)
-{
-    evey_mfree_fast(ctx);
-}
-
-static void eveye_free_1d(void * dst)
-{
-    if(dst != NULL)
+    pos += CU_DATA_ALIGN(2 * cu_cnt * sizeof(s8));
+    if(buf)
     {
-        evey_mfree_fast(dst);
+        for(i = 0; i < cu_cnt; i++)
+        {
+            cu_data->refi[i] = (s8 *)(buf + pos) + i * LIST_NUM;
+        }
     }
-}
-
-static void eveye_free_2d(void ** dst)
-{
-    if(dst)
+    pos += CU_DATA_ALIGN(cu_cnt * LIST_NUM * sizeof(s8));
+    if(buf)
     {
-        if(dst[0])
+        for(i = 0; i < cu_cnt; i++)
         {
-            evey_mfree_fast(dst[0]);
+            cu_data->mvp_idx[i] = (u8 *)(buf + pos) + i * LIST_NUM;
         }
-        evey_mfree_fast(dst);
     }
-}
-
-static int eveye_create_cu_data(EVEYE_CU_DATA * cu_data, int log2_cuw, int log2_cuh, int chroma_format_idc)
-{
-    int i, j;
-    int cuw_scu, cuh_scu;
-    int size_8b, size_16b, size_32b, cu_cnt, pixel_cnt;
-
-    cuw_scu = 1 << log2_cuw;
-    cuh_scu = 1 << log2_cuh;
-
-    size_8b = cuw_scu * cuh_scu * sizeof(s8);
-    size_16b = cuw_scu * cuh_scu * sizeof(s16);
-    size_32b = cuw_scu * cuh_scu * sizeof(s32);
-    cu_cnt = cuw_scu * cuh_scu;
-    pixel_cnt = cu_cnt << 4;
-
-    eveye_malloc_1d((void**)&cu_data->qp_y, size_8b);
-    eveye_malloc_1d((void**)&cu_data->qp_u, size_8b);
-    eveye_malloc_1d((void**)&cu_data->qp_v, size_8b);
-    eveye_malloc_1d((void**)&cu_data->pred_mode, size_8b);
-    eveye_malloc_2d((s8***)&cu_data->ipm, 2, cu_cnt, sizeof(u8));
-    eveye_malloc_2d((s8***)&cu_data->refi, cu_cnt, LIST_NUM, sizeof(u8));
-    eveye_malloc_2d((s8***)&cu_data->mvp_idx, cu_cnt, LIST_NUM, sizeof(u8));
+    pos += CU_DATA_ALIGN(cu_cnt * LIST_NUM * sizeof(u8));
 
     for(i = 0; i < N_C; i++)
     {
-        eveye_malloc_1d((void**)&cu_data->nnz[i], size_32b);
+        CU_DATA_CARVE(cu_data->nnz[i], int *, cu_cnt * sizeof(int));
     }
     for(i = 0; i < N_C; i++)
     {
         for(j = 0; j < 4; j++)
         {
-            eveye_malloc_1d((void**)&cu_data->nnz_sub[i][j], size_32b);
+            CU_DATA_CARVE(cu_data->nnz_sub[i][j], int *, cu_cnt * sizeof(int));
         }
     }
-    eveye_malloc_1d((void**)&cu_data->map_scu, size_32b);
+    CU_DATA_CARVE(cu_data->map_scu, u32 *, cu_cnt * sizeof(u32));
 
-    int shift = 0;
     for(i = 0; i < N_C; i++)
     {
-        eveye_malloc_1d((void**)&cu_data->coef[i], (pixel_cnt >> (!!(i)* shift)) * sizeof(s16));
-        eveye_malloc_1d((void**)&cu_data->reco[i], (pixel_cnt >> (!!(i)* shift)) * sizeof(pel));
+        CU_DATA_CARVE(cu_data->coef[i], s16 *, pixel_cnt * sizeof(s16));
+        CU_DATA_CARVE(cu_data->reco[i], pel *, pixel_cnt * sizeof(pel));
     }
+#undef CU_DATA_CARVE
 
-    return EVEY_OK;
+    return pos;
 }
 
-static int eveye_delete_cu_data(EVEYE_CU_DATA * cu_data, int log2_cuw, int log2_cuh)
+static EVEYE_CU_DATA * eveye_create_cu_data(EVEY_ARENA * arena, int log2_cuw, int log2_cuh)
 {
-    int i, j;
+    EVEYE_CU_DATA * cu_data;
+    u8            * buf;
+    int             size;
 
-    eveye_free_1d((void*)cu_data->qp_y);
-    eveye_free_1d((void*)cu_data->qp_u);
-    eveye_free_1d((void*)cu_data->qp_v);
-    eveye_free_1d((void*)cu_data->pred_mode);
-    eveye_free_2d((void**)cu_data->ipm);
-    eveye_free_2d((void**)cu_data->refi);
-    eveye_free_2d((void**)cu_data->mvp_idx);
+    cu_data = (EVEYE_CU_DATA *)evey_arena_alloc(arena, sizeof(EVEYE_CU_DATA));
+    evey_assert_rv(cu_data != NULL, NULL);
+    evey_mset_x64a(cu_data, 0, sizeof(EVEYE_CU_DATA));
 
-    for(i = 0; i < N_C; i++)
-    {
-        eveye_free_1d((void*)cu_data->nnz[i]);
-    }
-    for(i = 0; i < N_C; i++)
-    {
-        for(j = 0; j < 4; j++)
-        {
-            eveye_free_1d((void*)cu_data->nnz_sub[i][j]);
-        }
-    }
-    eveye_free_1d((void*)cu_data->map_scu);
+    size = cu_data_bind(cu_data, NULL, log2_cuw, log2_cuh);
+    buf = (u8 *)evey_arena_alloc(arena, size);
+    evey_assert_rv(buf != NULL, NULL);
+    evey_mset(buf, 0, size);
 
-    for(i = 0; i < N_C; i++)
-    {
-        eveye_free_1d((void*)cu_data->coef[i]);
-        eveye_free_1d((void*)cu_data->reco[i]);
-    }
+    cu_data_bind(cu_data, buf, log2_cuw, log2_cuh);
 
-    return EVEY_OK;
+    return cu_data;
 }
 
+/* CU data of the RDO are kept only for the CU shapes the split modes can
+   reach from a CTU; quad-tree split makes only square CUs */
+static int core_cu_shape_used(int log2_cuw, int log2_cuh, int log2_ctu_size)
+{
+    return log2_cuw == log2_cuh && log2_cuw <= log2_ctu_size - MIN_CU_LOG2;
+}
 
-static EVEYE_CORE * core_alloc(int chroma_format_idc)
+static EVEYE_CORE * core_alloc(EVEY_ARENA * arena, int log2_ctu_size)
 {
     EVEYE_CORE * core;
     int i, j;
 
-    core = (EVEYE_CORE*)evey_malloc_fast(sizeof(EVEYE_CORE));
+    core = (EVEYE_CORE*)evey_arena_alloc(arena, sizeof(EVEYE_CORE));
 
     evey_assert_rv(core, NULL);
     evey_mset_x64a(core, 0, sizeof(EVEYE_CORE));
@@ -243,30 +212,18 @@ static EVEYE_CORE * core_alloc(int chroma_format_idc)
     {
         for(j = 0; j < MAX_CU_DEPTH; j++)
         {
-            eveye_create_cu_data(&core->cu_data_best[i][j], i, j, chroma_format_idc);
-            eveye_create_cu_data(&core->cu_data_temp[i][j], i, j, chroma_format_idc);
+            if(core_cu_shape_used(i, j, log2_ctu_size))
+            {
+                core->cu_data_best[i][j] = eveye_create_cu_data(arena, i, j);
+                core->cu_data_temp[i][j] = eveye_create_cu_data(arena, i, j);
+                evey_assert_rv(core->cu_data_best[i][j] && core->cu_data_temp[i][j], NULL);
+            }
         }
     }
 
     return core;
 }
 
-static void core_free(EVEYE_CORE * core)
-{
-    int i, j;
-
-    for(i = 0; i < MAX_CU_DEPTH; i++)
-    {
-        for(j = 0; j < MAX_CU_DEPTH; j++)
-        {
-            eveye_delete_cu_data(&core->cu_data_best[i][j], i, j);
-            eveye_delete_cu_data(&core->cu_data_temp[i][j], i, j);
-        }
-    }
-
-    evey_mfree_fast(core);
-}
-
 void eveye_copy_chroma_qp_mapping_params(EVEY_CHROMA_TABLE * dst, EVEY_CHROMA_TABLE * src)
 {
     dst->chroma_qp_table_present_flag = src->chroma_qp_table_present_flag;
@@ -390,8 +347,6 @@ static int set_init_param(EVEYE_CDSC * cdsc, EVEYE_PARAM * param)
     param->use_dqp             = cdsc->use_dqp;
     param->chroma_format_idc   = cdsc->chroma_format_idc;
 
-    evey_set_chroma_qp_tbl_loc(cdsc->codec_bit_depth);
-
     EVEY_CHROMA_TABLE chroma_qp_table_struct;    
 
     chroma_qp_table_struct.chroma_qp_table_present_flag = cdsc->chroma_qp_table_present_flag;
@@ -402,17 +357,8 @@ static int set_init_param(EVEYE_CDSC * cdsc, EVEYE_PARAM * param)
     evey_mcpy(chroma_qp_table_struct.delta_qp_out_val, cdsc->delta_qp_out_val, sizeof(cdsc->delta_qp_out_val));
 
     eveye_parse_chroma_qp_mapping_params(&(param->chroma_qp_table_struct), &chroma_qp_table_struct, cdsc->codec_bit_depth);  /* parse input params and create chroma_qp_table_struct structure */
-    evey_derived_chroma_qp_mapping_tables(&(param->chroma_qp_table_struct), cdsc->codec_bit_depth);
-
-    if (param->chroma_qp_table_struct.chroma_qp_table_present_flag)
-    {
-        evey_derived_chroma_qp_mapping_tables(&(param->chroma_qp_table_struct), cdsc->codec_bit_depth);
-    }
-    else 
-    {
-        evey_mcpy(&(evey_tbl_qp_chroma_dynamic_ext[0][6 *( cdsc->codec_bit_depth - 8)]), evey_tbl_qp_chroma_ajudst, MAX_QP_TABLE_SIZE * sizeof(int));
-        evey_mcpy(&(evey_tbl_qp_chroma_dynamic_ext[1][6 * (cdsc->codec_bit_depth - 8)]), evey_tbl_qp_chroma_ajudst, MAX_QP_TABLE_SIZE * sizeof(int));
-    }
+    /* the tables are shared with the other encoders and decoders */
+    evey_set_chroma_qp_tbl(&(param->chroma_qp_table_struct), cdsc->codec_bit_depth, cdsc->codec_bit_depth);
 
     return EVEY_OK;
 }
@@ -434,6 +380,36 @@ static void set_nalu(EVEY_NALU * nalu, int nalu_type, int nuh_temporal_id)
     nalu->nuh_extension_flag = 0;
 }
 
+/* start a NAL unit for the NAL sink at the writing position, where its
+   size field is written first */
+static void nal_out_begin(EVEYE_CTX * ctx, EVEYE_BSW * bs, int nalu_type)
+{
+    EVEYE_NAL_OUT * out = &ctx->nal_out;
+
+    out->beg = out->pos = bs->cur + 4;
+    out->nalu_type = nalu_type;
+}
+
+/* give the bytes of the NAL unit written since the last call to the NAL
+   sink; end is set once the NAL unit is complete */
+static void nal_out_put(EVEYE_CTX * ctx, EVEYE_BSW * bs, int end)
+{
+    EVEYE_NAL_OUT * out = &ctx->nal_out;
+    int             flag, ret;
+
+    if(out->sink.fn_sink == NULL || out->err < 0 || (bs->cur == out->pos && !end))
+    {
+        return;
+    }
+    flag = (out->pos == out->beg ? EVEYE_NAL_BEGIN : 0) | (end ? EVEYE_NAL_END : 0);
+    ret = out->sink.fn_sink(out->sink.opaque, out->pos, (int)(bs->cur - out->pos), out->nalu_type, flag);
+    if(ret < 0)
+    {
+        out->err = ret;
+    }
+    out->pos = bs->cur;
+}
+
 // Dummy VUI initialization 
 static void set_vui(EVEYE_CTX * ctx, EVEY_VUI * vui) 
 {
@@ -532,6 +508,8 @@ static void set_sps(EVEYE_CTX * ctx, EVEY_SPS * sps)
 
 static void set_pps(EVEYE_CTX * ctx, EVEY_PPS * pps)
 {
+    int rows, num, i;
+
     pps->single_tile_in_pic_flag = 1;
     pps->constrained_intra_pred_flag = ctx->cdsc.constrained_intra_pred;
     pps->cu_qp_delta_enabled_flag = EVEY_ABS(ctx->cdsc.use_dqp);
@@ -542,6 +520,31 @@ static void set_pps(EVEYE_CTX * ctx, EVEY_PPS * pps)
     pps->tile_offset_lens_minus1 = 31;
     pps->arbitrary_slice_present_flag = 0;
     pps->tile_id_len_minus1 = 0;
+    pps->loop_filter_across_tiles_enabled_flag = 1;
+
+    /* a tile of one column for each slice */
+    rows = ctx->cdsc.slice_ctu_rows;
+    if(rows > 0 && rows < ctx->h_ctu)
+    {
+        rows = EVEY_MAX(rows, (ctx->h_ctu + MAX_NUM_TILES_ROW - 1) / MAX_NUM_TILES_ROW);
+        num = (ctx->h_ctu + rows - 1) / rows;
+        if(num > 1)
+        {
+            pps->single_tile_in_pic_flag = 0;
+            pps->num_tile_rows_minus1 = num - 1;
+            pps->uniform_tile_spacing_flag = 0;
+            pps->tile_column_width_minus1[0] = ctx->w_ctu - 1;
+            for(i = 0; i < num - 1; i++)
+            {
+                pps->tile_row_height_minus1[i] = rows - 1;
+            }
+            pps->tile_row_height_minus1[num - 1] = ctx->h_ctu - rows * (num - 1) - 1;
+            while((1 << (pps->tile_id_len_minus1 + 1)) < num)
+            {
+                pps->tile_id_len_minus1++;
+            }
+        }
+    }
     pps->num_ref_idx_default_active_minus1[LIST_0] = 0;
     pps->num_ref_idx_default_active_minus1[LIST_1] = 0;
 }
@@ -656,7 +659,7 @@ static int eveye_eco_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y0, in
     EVEYE_BSW * bs;
     s8  split_mode;
 
-    evey_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctx->ctu_size, ctx->map_cu_data[core->ctu_num].split_mode);
+    evey_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctx->ctu_size, ctx->map_cu_data[core->ctu_num]->split_mode);
     
     bs = &ctx->bs;
     
@@ -702,6 +705,262 @@ ERR:
     return ret;
 }
 
+/* copy SCU map of a CTU with the coded flags cleared (set_cod: 0), or set
+   the coded flags of a CTU in place (set_cod: 1) */
+static void ctu_map_scu_cod(EVEYE_CTX * ctx, EVEYE_CORE * core, u32 * dst, u32 * src, int set_cod)
+{
+    int i, j, w, h, idx;
+
+    idx = SCU_IDX(core->x_scu, core->y_scu, ctx->w_scu);
+    w = EVEY_MIN(1 << (ctx->log2_ctu_size - MIN_CU_LOG2), ctx->w_scu - core->x_scu);
+    h = EVEY_MIN(1 << (ctx->log2_ctu_size - MIN_CU_LOG2), ctx->h_scu - core->y_scu);
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            dst[idx + j] = src[idx + j];
+            if(set_cod)
+            {
+                MCU_SET_COD(dst[idx + j]);
+            }
+            else
+            {
+                MCU_CLR_COD(dst[idx + j]);
+            }
+        }
+        idx += SCU_STRIDE(ctx->w_scu);
+    }
+}
+
+/* start the slice of a tile at the writing position of the bitstream:
+   NAL unit header, slice header and arithmetic coder */
+static int slice_begin(EVEYE_CTX * ctx, EVEYE_BSW * bs, int tile)
+{
+    int ret;
+
+    ctx->sh.first_tile_id = tile;
+    ctx->sh.single_tile_in_slice_flag = 1;
+    ctx->sh.qp_prev_eco = ctx->sh.qp;
+    ctx->slice_num = tile;
+
+    /* nothing is predicted from the slices above */
+    evey_clr_cod_above(ctx, ctx->map_scu, evey_tile_row_ctu(&ctx->pps, ctx->h_ctu, tile));
+
+    eveye_bsw_init_slice(bs, bs->cur, (int)(bs->end - bs->cur) + 1, NULL);
+    ctx->slice_beg = bs->cur;
+
+    /* encode nalu header */
+    nal_out_begin(ctx, bs, ctx->nalu.nal_unit_type_plus1 - 1);
+    ret = eveye_eco_nalu(bs, &ctx->nalu);
+    evey_assert_rv(ret == EVEY_OK, ret);
+
+    /* encode slice header */
+    ret = eveye_eco_sh(bs, &ctx->sps, &ctx->pps, &ctx->sh, ctx->nalu.nal_unit_type_plus1 - 1);
+    evey_assert_rv(ret == EVEY_OK, ret);
+
+    /* Initialization of arithmetic encoder  */
+    eveye_sbac_reset(ctx, GET_SBAC_ENC(bs));
+
+    return EVEY_OK;
+}
+
+/* finish the slice started by slice_begin() and hand it to the NAL sink */
+static void slice_end(EVEYE_CTX * ctx, EVEYE_BSW * bs)
+{
+    /* write tile_end_flag */
+    eveye_eco_tile_end_flag(bs, 1);
+    eveye_sbac_finish(bs);
+
+    /* cabac_zero_word coding */
+    {
+        unsigned int bin_counts_in_units = 0;
+        unsigned int num_bytes_in_units = (int)(bs->cur - ctx->slice_beg) - 4;
+        int log2_sub_widthC_subHeightC = 2;
+        int min_cu_w = ctx->min_cu_size;
+        int min_cu_h = ctx->min_cu_size;
+        int padded_w = ((ctx->w + min_cu_w - 1) / min_cu_w) * min_cu_w;
+        int padded_h = ((ctx->h + min_cu_h - 1) / min_cu_h) * min_cu_h;
+        int raw_bits = padded_w * padded_h * ((ctx->sps.bit_depth_luma_minus8 + 8) + (ctx->sps.chroma_format_idc != 0 ? 2 * ((ctx->sps.bit_depth_chroma_minus8 + 8) >> log2_sub_widthC_subHeightC) : 0));
+        unsigned int threshold = (CABAC_ZERO_PARAM / 3) * num_bytes_in_units + (raw_bits / 32);
+        if(bin_counts_in_units >= threshold)
+        {
+            unsigned int target_num_bytes_in_units = ((bin_counts_in_units - (raw_bits / 32)) * 3 + (CABAC_ZERO_PARAM - 1)) / CABAC_ZERO_PARAM;
+            if(target_num_bytes_in_units > num_bytes_in_units)
+            {
+                unsigned int num_add_bytes_needed = target_num_bytes_in_units - num_bytes_in_units;
+                unsigned int num_add_cabac_zero_words = (num_add_bytes_needed + 2) / 3;
+                unsigned int num_add_cabac_zero_bytes = num_add_cabac_zero_words * 3;
+                for(unsigned int i = 0; i < num_add_cabac_zero_words; i++)
+                {
+                    eveye_bsw_write(bs, 0, 16);
+                }
+            }
+        }
+    }
+
+    eveye_bsw_deinit(bs);
+    *(int*)ctx->slice_beg = (int)(bs->cur - ctx->slice_beg) - 4; /* set nal_unit_size field */
+    nal_out_put(ctx, bs, 1);
+}
+
+/* entropy coding thread: codes the CTUs of a picture as mode decision
+   hands them over */
+static int eco_pipe_run(void * arg)
+{
+    EVEYE_ECO_PIPE * pipe = (EVEYE_ECO_PIPE *)arg;
+    EVEYE_CTX      * ctx = pipe->ctx;
+    EVEYE_CORE     * core = pipe->core;
+    int              ctu_num, spin, tile, tile_end, ret = EVEY_OK;
+    s64              t0;
+
+    tile = 0;
+    tile_end = 0;
+
+    for(ctu_num = 0; ctu_num < (int)ctx->f_ctu; ctu_num++)
+    {
+        spin = 0;
+        while(evey_atomic_load(&pipe->ctu_ready) <= ctu_num)
+        {
+            if(evey_atomic_load(&pipe->abort))
+            {
+                return EVEY_OK;
+            }
+            evey_thread_wait(spin++);
+        }
+
+        t0 = evey_time_ns();
+        if(ctu_num == tile_end)
+        {
+            ret = slice_begin(ctx, &ctx->bs, tile);
+            evey_assert_g(ret == EVEY_OK, ERR);
+            tile_end = evey_tile_row_ctu(&ctx->pps, ctx->h_ctu, tile + 1) * ctx->w_ctu;
+        }
+
+        core->x_ctu = ctu_num % ctx->w_ctu;
+        core->y_ctu = ctu_num / ctx->w_ctu;
+        evey_update_core_loc_param(ctx, core);
+
+        /* the CTU is coded as if none of its CUs was coded yet, as in the
+           single thread case where mode decision clears the coded flags */
+        ctu_map_scu_cod(ctx, core, ctx->map_scu, pipe->map_scu_mode, 0);
+
+        ret = eveye_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->ctu_size, ctx->ctu_size, 0);
+        evey_assert_g(ret == EVEY_OK, ERR);
+
+        if(ctx->nal_out.sink.row && core->x_ctu == ctx->w_ctu - 1)
+        {
+            nal_out_put(ctx, &ctx->bs, 0);
+        }
+        if(ctu_num + 1 == tile_end)
+        {
+            slice_end(ctx, &ctx->bs);
+            tile++;
+        }
+        pipe->eco_ns += evey_time_ns() - t0;
+
+        evey_atomic_store(&pipe->ctu_done, ctu_num + 1);
+    }
+    return EVEY_OK;
+ERR:
+    /* mode decision may be waiting for a slice boundary */
+    evey_atomic_store(&pipe->ctu_done, (int)ctx->f_ctu);
+    return ret;
+}
+
+static EVEYE_ECO_PIPE * eco_pipe_create(EVEYE_CTX * ctx)
+{
+    EVEYE_ECO_PIPE * pipe;
+
+    /* released with the arena; map_scu is swapped with the one of ctx */
+    pipe = (EVEYE_ECO_PIPE *)evey_arena_alloc(&ctx->arena, sizeof(EVEYE_ECO_PIPE));
+    evey_assert_rv(pipe != NULL, NULL);
+    evey_mset(pipe, 0, sizeof(EVEYE_ECO_PIPE));
+
+    /* entropy coding uses no CU data buffers of the core */
+    pipe->ctx = (EVEYE_CTX *)evey_arena_alloc(&ctx->arena, sizeof(EVEYE_CTX));
+    pipe->core = (EVEYE_CORE *)evey_arena_alloc(&ctx->arena, sizeof(EVEYE_CORE));
+    pipe->map_scu = (u32 *)evey_arena_alloc(&ctx->arena, sizeof(u32) * ctx->f_scu);
+    evey_assert_rv(pipe->ctx != NULL && pipe->core != NULL && pipe->map_scu != NULL, NULL);
+    evey_mset_x64a(pipe->core, 0, sizeof(EVEYE_CORE));
+
+    return pipe;
+}
+
+/* start the entropy coding thread for the current picture. ctx->bs is owned
+   by the thread until eco_pipe_finish() */
+static int eco_pipe_start(EVEYE_CTX * ctx)
+{
+    EVEYE_ECO_PIPE * pipe = ctx->eco_pipe;
+
+    evey_mset_x64a(pipe->map_scu, 0, sizeof(u32) * ctx->f_scu);
+    evey_mcpy(pipe->ctx, ctx, sizeof(EVEYE_CTX));
+    pipe->ctx->core = pipe->core;
+    pipe->ctx->map_scu = pipe->map_scu;
+    pipe->map_scu_mode = ctx->map_scu;
+    pipe->ctu_ready = 0;
+    pipe->ctu_done = 0;
+    pipe->abort = 0;
+    pipe->eco_ns = 0;
+
+    pipe->thread = evey_thread_create(eco_pipe_run, pipe);
+    evey_assert_rv(pipe->thread != NULL, EVEY_ERR_UNKNOWN);
+
+    return EVEY_OK;
+}
+
+/* hand a decided CTU over to the entropy coding thread */
+static void eco_pipe_push(EVEYE_CTX * ctx, EVEYE_CORE * core)
+{
+    EVEYE_ECO_PIPE * pipe = ctx->eco_pipe;
+
+    /* later CTUs are decided with this CTU available */
+    ctu_map_scu_cod(ctx, core, ctx->map_scu, ctx->map_scu, 1);
+
+    evey_atomic_store(&pipe->ctu_ready, core->ctu_num + 1);
+}
+
+/* wait until the entropy coding thread is done with the first ctu_num
+   CTUs of the picture */
+static void eco_pipe_wait(EVEYE_CTX * ctx, int ctu_num)
+{
+    EVEYE_ECO_PIPE * pipe = ctx->eco_pipe;
+    int              spin = 0;
+
+    while(evey_atomic_load(&pipe->ctu_done) < ctu_num)
+    {
+        evey_thread_wait(spin++);
+    }
+}
+
+/* wait for the entropy coding of the picture and take back the bitstream
+   and the SCU map updated by the entropy coding */
+static int eco_pipe_finish(EVEYE_CTX * ctx, int abort)
+{
+    EVEYE_ECO_PIPE * pipe = ctx->eco_pipe;
+    u32            * map_scu;
+    int              ret;
+
+    if(abort)
+    {
+        evey_atomic_store(&pipe->abort, 1);
+    }
+    ret = evey_thread_join(pipe->thread);
+    pipe->thread = NULL;
+    evey_assert_rv(ret == EVEY_OK, ret);
+
+    if(!abort)
+    {
+        evey_mcpy(&ctx->bs, &pipe->ctx->bs, sizeof(EVEYE_BSW));
+        evey_mcpy(&ctx->nal_out, &pipe->ctx->nal_out, sizeof(EVEYE_NAL_OUT));
+        map_scu = ctx->map_scu;
+        ctx->map_scu = pipe->map_scu;
+        pipe->map_scu = map_scu;
+        ctx->stage_ns[EVEYE_STAGE_ECO] += pipe->eco_ns;
+    }
+    return EVEY_OK;
+}
+
 static int eveye_ready(EVEYE_CTX * ctx)
 {
     EVEYE_CORE * core = NULL;
@@ -709,12 +968,8 @@ static int eveye_ready(EVEYE_CTX * ctx)
     s64          size;
 
     evey_assert(ctx);
-    core = core_alloc(ctx->param.chroma_format_idc);
-    evey_assert_gv(core != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
 
     /* set various value */
-    ctx->core = core;
-
     w = ctx->w = ctx->param.w;
     h = ctx->h = ctx->param.h;
 
@@ -729,19 +984,24 @@ static int eveye_ready(EVEYE_CTX * ctx)
     ctx->f_ctu = ctx->w_ctu * ctx->h_ctu;
     ctx->w_scu = (w + ((1 << MIN_CU_LOG2) - 1)) >> MIN_CU_LOG2;
     ctx->h_scu = (h + ((1 << MIN_CU_LOG2) - 1)) >> MIN_CU_LOG2;
-    ctx->f_scu = ctx->w_scu * ctx->h_scu;
+    ctx->f_scu = SCU_MAP_SIZE(ctx->w_scu, ctx->h_scu);
+
+    /* buffers below live until eveye_flush() */
+    core = core_alloc(&ctx->arena, ctx->log2_ctu_size);
+    evey_assert_gv(core != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
+    ctx->core = core;
 
     /*  allocate CU data map*/
     if(ctx->map_cu_data == NULL)
     {
-        size = sizeof(EVEYE_CU_DATA) * ctx->f_ctu;
-        ctx->map_cu_data = (EVEYE_CU_DATA*)evey_malloc_fast(size);
+        size = sizeof(EVEYE_CU_DATA *) * ctx->f_ctu;
+        ctx->map_cu_data = (EVEYE_CU_DATA **)evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_cu_data, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
-        evey_mset_x64a(ctx->map_cu_data, 0, size);
 
         for(i = 0; i < (int)ctx->f_ctu; i++)
         {
-            eveye_create_cu_data(ctx->map_cu_data + i, ctx->log2_ctu_size - MIN_CU_LOG2, ctx->log2_ctu_size - MIN_CU_LOG2, ctx->param.chroma_format_idc);
+            ctx->map_cu_data[i] = eveye_create_cu_data(&ctx->arena, ctx->log2_ctu_size - MIN_CU_LOG2, ctx->log2_ctu_size - MIN_CU_LOG2);
+            evey_assert_gv(ctx->map_cu_data[i], ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         }
     }
 
@@ -749,7 +1009,7 @@ static int eveye_ready(EVEYE_CTX * ctx)
     if(ctx->map_scu == NULL)
     {
         size = sizeof(u32) * ctx->f_scu;
-        ctx->map_scu = evey_malloc_fast(size);
+        ctx->map_scu = evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_scu, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset_x64a(ctx->map_scu, 0, size);
     }
@@ -758,7 +1018,7 @@ static int eveye_ready(EVEYE_CTX * ctx)
     if(ctx->map_split == NULL)
     {
         size = sizeof(s8) * ctx->f_ctu * NUM_CU_DEPTH * NUM_BLOCK_SHAPE * MAX_CU_CNT_IN_CTU;
-        ctx->map_split = evey_malloc(size);
+        ctx->map_split = evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_split, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset_x64a(ctx->map_split, 0, size);
     }
@@ -767,11 +1027,23 @@ static int eveye_ready(EVEYE_CTX * ctx)
     if(ctx->map_ipm == NULL)
     {
         size = sizeof(s8) * ctx->f_scu;
-        ctx->map_ipm = evey_malloc_fast(size);
+        ctx->map_ipm = evey_arena_alloc(&ctx->arena, size);
         evey_assert_gv(ctx->map_ipm, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset(ctx->map_ipm, -1, size);
     }
 
+    if(ctx->cdsc.eco_thread && ctx->eco_pipe == NULL)
+    {
+        ctx->eco_pipe = eco_pipe_create(ctx);
+        evey_assert_gv(ctx->eco_pipe, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
+    }
+
+    if(ctx->cdsc.quality_metric && ctx->qm_job == NULL)
+    {
+        ret = eveye_qm_create(ctx);
+        evey_assert_g(ret == EVEY_OK, ERR);
+    }
+
     /* initialize reference picture manager */
     EVEY_PICBUF_ALLOCATOR pa;
     pa.fn_alloc          = evey_pic_alloc;
@@ -795,58 +1067,69 @@ static int eveye_ready(EVEYE_CTX * ctx)
 
     for(i = 0; i < ctx->pico_max_cnt; i++)
     {
-        ctx->pico_buf[i] = (EVEYE_PICO*)evey_malloc(sizeof(EVEYE_PICO));
+        ctx->pico_buf[i] = (EVEYE_PICO*)evey_arena_alloc(&ctx->arena, sizeof(EVEYE_PICO));
         evey_assert_gv(ctx->pico_buf[i], ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
         evey_mset(ctx->pico_buf[i], 0, sizeof(EVEYE_PICO));
     }
 
     return EVEY_OK;
 ERR:
-    for (i = 0; i < (int)ctx->f_ctu; i++)
-    {
-        eveye_delete_cu_data(ctx->map_cu_data + i, ctx->log2_ctu_size - MIN_CU_LOG2, ctx->log2_ctu_size - MIN_CU_LOG2);
-    }
-
-    evey_mfree_fast(ctx->map_cu_data);
-    evey_mfree_fast(ctx->map_ipm);
-
+    evey_arena_release(&ctx->arena);
+    ctx->core = NULL;
+    ctx->map_cu_data = NULL;
+    ctx->map_scu = NULL;
+    ctx->map_split = NULL;
+    ctx->map_ipm = NULL;
+    ctx->eco_pipe = NULL;
+    ctx->qm_job = NULL;
     for(i = 0; i < ctx->pico_max_cnt; i++)
     {
-        evey_mfree_fast(ctx->pico_buf[i]);
-    }
-
-    if(core)
-    {
-        core_free(core);
+        ctx->pico_buf[i] = NULL;
     }
     return ret;
 }
 
 static void eveye_flush(EVEYE_CTX * ctx)
 {
-    int i;
+    EVEY_IMGB * imgb;
+    int         i;
     evey_assert(ctx);
 
-    evey_mfree_fast(ctx->map_scu);
-    evey_mfree_fast(ctx->map_split);
-    for(i = 0; i < (int)ctx->f_ctu; i++)
+    if(ctx->qm_job)
     {
-        eveye_delete_cu_data(ctx->map_cu_data + i, ctx->log2_ctu_size - MIN_CU_LOG2, ctx->log2_ctu_size - MIN_CU_LOG2);
+        eveye_qm_wait(ctx);
     }
-    evey_mfree_fast(ctx->map_cu_data);
-    evey_mfree_fast(ctx->map_ipm);
-    
+
+    /* pushed pictures left unencoded */
+    for(i = 0; i < ctx->pico_max_cnt; i++)
+    {
+        if(ctx->pico_buf[i] && ctx->pico_buf[i]->is_used)
+        {
+            imgb = ctx->pico_buf[i]->pic.imgb;
+            if(imgb && imgb->release) imgb->release(imgb);
+            ctx->pico_buf[i]->is_used = 0;
+        }
+    }
+
     if(ctx->cdsc.rdo_dbk_switch)
     {
         evey_picbuf_free(ctx->pic_dbk);
     }
 
     evey_picman_deinit(&ctx->dpbm);
-    core_free(ctx->core);
 
+    /* core, maps, entropy coding pipe and picture orders */
+    evey_arena_release(&ctx->arena);
+    ctx->core = NULL;
+    ctx->map_cu_data = NULL;
+    ctx->map_scu = NULL;
+    ctx->map_split = NULL;
+    ctx->map_ipm = NULL;
+    ctx->eco_pipe = NULL;
+    ctx->qm_job = NULL;
     for(i = 0; i < ctx->pico_max_cnt; i++)
     {
-        evey_mfree_fast(ctx->pico_buf[i]);
+        ctx->pico_buf[i] = NULL;
     }
     for(i = 0; i < EVEYE_MAX_INBUF_CNT; i++)
     {
@@ -874,7 +1157,7 @@ static int eveye_picbuf_get_inbuf(EVEYE_CTX * ctx, EVEY_IMGB ** imgb)
             pad[1] = 0;
             pad[2] = 0;
 
-            int cs = EVEY_CS_SET(CF_FROM_CFI(ctx->param.chroma_format_idc), ctx->param.bit_depth, 0);
+            int cs = EVEY_CS_SET(CF_FROM_CFI(ctx->param.chroma_format_idc), ctx->cdsc.codec_bit_depth, 0);
             *imgb = evey_imgb_create(ctx->param.w, ctx->param.h, cs, opt, pad, align);
             evey_assert_rv(*imgb != NULL, EVEY_ERR_OUT_OF_MEMORY);
 
@@ -1097,6 +1380,7 @@ static int eveye_encode_sps(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat
     int* size_field = (int*)(*(&bs->cur));
     u8* cur_tmp = bs->cur;
 
+    nal_out_begin(ctx, bs, EVEY_SPS_NUT);
     eveye_eco_nalu(bs, &nalu);
 
     /* sequence parameter set*/
@@ -1108,6 +1392,7 @@ static int eveye_encode_sps(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat
 
     /* write the bitstream size */
     *size_field = (int)(bs->cur - cur_tmp) - 4;
+    nal_out_put(ctx, bs, 1);
 
     return EVEY_OK;
 }
@@ -1145,6 +1430,7 @@ static int eveye_encode_pps(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat
     int* size_field = (int*)(*(&bs->cur));
     u8* cur_tmp = bs->cur;
 
+    nal_out_begin(ctx, bs, EVEY_PPS_NUT);
     eveye_eco_nalu(bs, &nalu);
 
     /* sequence parameter set*/
@@ -1156,6 +1442,7 @@ static int eveye_encode_pps(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat
 
     /* write the bitstream size */
     *size_field = (int)(bs->cur - cur_tmp) - 4;
+    nal_out_put(ctx, bs, 1);
 
     return EVEY_OK;
 }
@@ -1165,15 +1452,25 @@ static int eveye_enc_pic_prepare(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
     EVEYE_PARAM * param;
     int           ret;
     int           size;
+    s64           t0;
 
     evey_assert_rv(PIC_ORIG(ctx) != NULL, EVEY_ERR_UNEXPECTED);
 
+    evey_mset(ctx->stage_ns, 0, sizeof(ctx->stage_ns));
+
     param = &ctx->param;
     ret = set_enc_param(ctx, param);
     evey_assert_rv(ret == EVEY_OK, ret);
 
+    t0 = evey_time_ns();
+    /* the picture being measured may hold the last free picture buffer */
+    if(ctx->qm_job && !evey_picman_has_empty_pic(&ctx->dpbm))
+    {
+        eveye_qm_wait(ctx);
+    }
     PIC_CURR(ctx) = evey_picman_get_empty_pic(&ctx->dpbm, &ret);
     evey_assert_rv(PIC_CURR(ctx) != NULL, ret);
+    ctx->stage_ns[EVEYE_STAGE_PICMAN] += evey_time_ns() - t0;
 
     ctx->pic = PIC_CURR(ctx);
     ctx->map_refi = PIC_CURR(ctx)->map_refi;
@@ -1203,6 +1500,7 @@ static int eveye_enc_pic_prepare(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
 
     /* initialize bitstream container */
     eveye_bsw_init(&ctx->bs, bitb->addr, bitb->bsize, NULL);
+    ctx->nal_out.err = 0;
 
     /* clear map */
     evey_mset_x64a(ctx->map_scu, 0, sizeof(u32) * ctx->f_scu);
@@ -1224,9 +1522,10 @@ static int eveye_enc_pic_prepare(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
         }
     }
 
-    ctx->sh.slice_pic_parameter_set_id = ctx->pico->pic.imgb->imgb_active_pps_id;
+    /* a single PPS is generated; pushed buffers may carry any id */
+    ctx->sh.slice_pic_parameter_set_id = 0;
     set_active_pps_info(ctx);
-    PIC_CURR(ctx)->imgb->imgb_active_pps_id = ctx->pico->pic.imgb->imgb_active_pps_id;
+    PIC_CURR(ctx)->imgb->imgb_active_pps_id = 0;
 
     return EVEY_OK;
 }
@@ -1236,6 +1535,7 @@ static int eveye_enc_pic_finish(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
     EVEY_IMGB * imgb_o, * imgb_c;
     int         ret;
     int         i, j;
+    s64         t0;
 
     evey_mset(stat, 0, sizeof(EVEYE_STAT));
 
@@ -1250,6 +1550,7 @@ static int eveye_enc_pic_finish(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
         int* size_field = (int*)(*(&bs->cur));
         u8* cur_tmp = bs->cur;
 
+        nal_out_begin(ctx, bs, EVEY_SEI_NUT);
         eveye_eco_nalu(bs, &sei_nalu);
 
         ret = eveye_eco_sei(ctx, bs);
@@ -1258,8 +1559,11 @@ static int eveye_enc_pic_finish(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
         eveye_bsw_deinit(bs);
         stat->sei_size = (int)(bs->cur - cur_tmp);
         *size_field = stat->sei_size - 4;
+        nal_out_put(ctx, bs, 1);
     }
 
+    t0 = evey_time_ns();
+
     /* expand current encoding picture, if needs */
     ctx->dpbm.pa.fn_expand(PIC_CURR(ctx));
 
@@ -1267,6 +1571,7 @@ static int eveye_enc_pic_finish(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
     ret = evey_picman_put_pic(ctx, PIC_CURR(ctx), 0);
 
     evey_assert_rv(ret == EVEY_OK, ret);
+    ctx->stage_ns[EVEYE_STAGE_PICMAN] += evey_time_ns() - t0;
 
     imgb_o = PIC_ORIG(ctx)->imgb;
     evey_assert(imgb_o != NULL);
@@ -1291,6 +1596,19 @@ static int eveye_enc_pic_finish(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
             stat->refpic[i][j] = ctx->refp[j][i].poc;
         }
     }
+    for(i = 0; i < EVEYE_STAGE_NUM; i++)
+    {
+        stat->stage_ns[i] = ctx->stage_ns[i];
+        ctx->stats.stage_ns[i] += ctx->stage_ns[i];
+    }
+    ctx->stats.frames++;
+
+    evey_mset(&stat->qm, 0, sizeof(EVEYE_QM));
+    if(ctx->qm_job)
+    {
+        eveye_qm_take(ctx, &stat->qm);
+        eveye_qm_start(ctx, stat);
+    }
 
     ctx->pic_cnt++; /* increase picture count */
     ctx->param.f_ifrm = 0; /* clear force-IDR flag */
@@ -1301,7 +1619,7 @@ static int eveye_enc_pic_finish(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT *
     imgb_c->ts[2] = bitb->ts[2] = imgb_o->ts[2];
     imgb_c->ts[3] = bitb->ts[3] = imgb_o->ts[3];
 
-    if(imgb_o)
+    if(imgb_o->release)
     {
         imgb_o->release(imgb_o);
     }
@@ -1315,12 +1633,17 @@ static int eveye_enc_pic(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat)
     EVEYE_CORE * core;
     EVEYE_BSW  * bs;
     EVEY_SH    * sh;
-    int          ret;
-    u8         * curr_temp = ctx->bs.cur;
+    EVEYE_SBAC   sbac_init;
+    int          ret, tile, num_tiles, y_ctu, bef_cu_qp;
+    s64          t0;
 
     /* initialize reference pictures */
+    t0 = evey_time_ns();
     ret = evey_picman_refp_init(ctx);
     evey_assert_rv(ret == EVEY_OK, ret);
+    ctx->stage_ns[EVEYE_STAGE_PICMAN] += evey_time_ns() - t0;
+
+    t0 = evey_time_ns();
 
     /* initialize mode decision for frame encoding */
     ret = ctx->fn_mode_init_frame(ctx);
@@ -1329,6 +1652,7 @@ static int eveye_enc_pic(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat)
     /* frame level processing */
     ret = ctx->fn_mode_analyze_frame(ctx);
     evey_assert_rv(ret == EVEY_OK, ret);
+    ctx->stage_ns[EVEYE_STAGE_MODE] += evey_time_ns() - t0;
 
     bs = &ctx->bs;
     core = ctx->core;
@@ -1343,11 +1667,6 @@ static int eveye_enc_pic(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat)
         last_intra_poc = ctx->poc.poc_val;
     }
 
-    core->x_ctu = core->y_ctu = 0;
-    core->x_pel = core->y_pel = 0;
-    core->ctu_num = 0;
-    ctx->ctu_cnt = ctx->f_ctu;
-
     /* set nalu header */
     set_nalu(&ctx->nalu, (ctx->pic_cnt == 0 || (ctx->sh.slice_type == SLICE_I && ctx->param.use_closed_gop)) ? EVEY_IDR_NUT : EVEY_NONIDR_NUT, ctx->nalu.nuh_temporal_id);
 
@@ -1367,115 +1686,127 @@ static int eveye_enc_pic(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat)
 #if TRACE_RDO_EXCLUDE_I
     }
 #endif
-    ctx->sh.qp_prev_eco = ctx->sh.qp;
-    ctx->sh.qp_prev_mode = ctx->sh.qp;
-    core->dqp_data[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].prev_qp = ctx->sh.qp_prev_mode;
-    core->dqp_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].curr_qp = ctx->sh.qp;
-    core->dqp_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].prev_qp = ctx->sh.qp;
-
-    if(ctx->slice_num == 0 && !(ctx->pic_cnt == 0 || (ctx->sh.slice_type == SLICE_I && ctx->param.use_closed_gop))) /* first slice and not IDR picture */
-    {
-        eveye_bsw_init(&ctx->bs, (u8*)bitb->addr, bitb->bsize, NULL);
-    }
-    else
-    {
-        eveye_bsw_init_slice(&ctx->bs, (u8*)curr_temp, bitb->bsize, NULL);
-    }
-    
-    int* size_field = (int*)(*(&bs->cur));
-    u8* cur_tmp = bs->cur;
-
-    /* encode nalu header */
-    ret = eveye_eco_nalu(bs, &ctx->nalu);
-    evey_assert_rv(ret == EVEY_OK, ret);
-
-    /* encode slice header */
-    EVEYE_BSW bs_sh;
-    evey_mcpy(&bs_sh, bs, sizeof(EVEYE_BSW));
-#if TRACE_HLS
-    s32 tmp_fp_point = ftell(fp_trace);
-#endif
-    ret = eveye_eco_sh(bs, &ctx->sps, &ctx->pps, sh, ctx->nalu.nal_unit_type_plus1 - 1);
-    evey_assert_rv(ret == EVEY_OK, ret);
-
     ctx->sh.qp_prev_eco = ctx->sh.qp;
 
     /* Initialization of arithmetic encoder  */
     eveye_sbac_reset(ctx, GET_SBAC_ENC(bs));
     eveye_sbac_reset(ctx, &core->s_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2]);
+    SBAC_STORE(sbac_init, *GET_SBAC_ENC(bs));
 
-    /* set entry point */
-    core->x_ctu = 0;
-    core->y_ctu = 0;
-
-    int bef_cu_qp = ctx->sh.qp_prev_eco;
+    /* the entropy coding runs on its own thread if it does not have to
+       follow the QP of mode decision */
+    int use_eco_pipe = ctx->eco_pipe != NULL && !ctx->pps.cu_qp_delta_enabled_flag;
 
-    /* CTU encoding loop */
-    while(ctx->ctu_cnt > 0)
+    if(use_eco_pipe)
     {
-        evey_update_core_loc_param(ctx, core);
-
-        /* initialize structures for mode decision */
-        ret = ctx->fn_mode_init_ctu(ctx, core);
-        evey_assert_rv(ret == EVEY_OK, ret);
-
-        SBAC_LOAD(core->s_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], *GET_SBAC_ENC(bs));
-        core->s_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].is_bit_count = 1;
-
-        /* mode decision for a CTU */
-        ret = ctx->fn_mode_analyze_ctu(ctx, core);
+        ret = eco_pipe_start(ctx);
         evey_assert_rv(ret == EVEY_OK, ret);
+    }
 
-        ctx->sh.qp_prev_eco = bef_cu_qp;
+    num_tiles = ctx->pps.single_tile_in_pic_flag ? 1 : ctx->pps.num_tile_rows_minus1 + 1;
 
-        /* entropy coding for a CTU */
-        ret = eveye_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->ctu_size, ctx->ctu_size, 0);
-        evey_assert_rv(ret == EVEY_OK, ret);
+    /* a slice for each tile */
+    for(tile = 0; tile < num_tiles; tile++)
+    {
+        y_ctu = evey_tile_row_ctu(&ctx->pps, ctx->h_ctu, tile);
+        ctx->ctu_cnt = (evey_tile_row_ctu(&ctx->pps, ctx->h_ctu, tile + 1) - y_ctu) * ctx->w_ctu;
 
-        bef_cu_qp = ctx->sh.qp_prev_eco;
-        core->x_ctu++;
-        if(core->x_ctu >= ctx->w_ctu)
+        if(use_eco_pipe)
+        {
+            /* the entropy coding thread writes the slice header; mode
+               decision does not wait for the entropy coding, so each CTU
+               starts from the contexts at the end of mode decision of the
+               previous CTU instead of the ones of the entropy coder. the
+               CTUs above are no more read by the thread once it is done
+               with them */
+            eco_pipe_wait(ctx, y_ctu * ctx->w_ctu);
+            ctx->slice_num = tile;
+            evey_clr_cod_above(ctx, ctx->map_scu, y_ctu);
+            SBAC_STORE(core->s_next_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], sbac_init);
+        }
+        else
         {
-            core->x_ctu = 0;
-            core->y_ctu++;
+            ret = slice_begin(ctx, bs, tile);
+            evey_assert_rv(ret == EVEY_OK, ret);
         }
-        ctx->ctu_cnt--;
-    } /* end of CTU processing loop */
 
-    /* write tile_end_flag */
-    eveye_eco_tile_end_flag(bs, 1);
-    eveye_sbac_finish(bs);
+        ctx->sh.qp_prev_mode = ctx->sh.qp;
+        core->dqp_data[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].prev_qp = ctx->sh.qp_prev_mode;
+        core->dqp_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].curr_qp = ctx->sh.qp;
+        core->dqp_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].prev_qp = ctx->sh.qp;
+        bef_cu_qp = ctx->sh.qp;
 
-    /* cabac_zero_word coding */
-    {
-        unsigned int bin_counts_in_units = 0;
-        unsigned int num_bytes_in_units = (int)(bs->cur - cur_tmp) - 4;
-        int log2_sub_widthC_subHeightC = 2;
-        int min_cu_w = ctx->min_cu_size;
-        int min_cu_h = ctx->min_cu_size;
-        int padded_w = ((ctx->w + min_cu_w - 1) / min_cu_w) * min_cu_w;
-        int padded_h = ((ctx->h + min_cu_h - 1) / min_cu_h) * min_cu_h;
-        int raw_bits = padded_w * padded_h * ((ctx->sps.bit_depth_luma_minus8 + 8) + (ctx->sps.chroma_format_idc != 0 ? 2 * ((ctx->sps.bit_depth_chroma_minus8 + 8) >> log2_sub_widthC_subHeightC) : 0));
-        unsigned int threshold = (CABAC_ZERO_PARAM / 3) * num_bytes_in_units + (raw_bits / 32);
-        if(bin_counts_in_units >= threshold)
+        core->x_ctu = 0;
+        core->y_ctu = y_ctu;
+
+        /* CTU encoding loop */
+        while(ctx->ctu_cnt > 0)
         {
-            unsigned int target_num_bytes_in_units = ((bin_counts_in_units - (raw_bits / 32)) * 3 + (CABAC_ZERO_PARAM - 1)) / CABAC_ZERO_PARAM;
-            if(target_num_bytes_in_units > num_bytes_in_units)
+            evey_update_core_loc_param(ctx, core);
+
+            t0 = evey_time_ns();
+
+            /* initialize structures for mode decision */
+            ret = ctx->fn_mode_init_ctu(ctx, core);
+            evey_assert_g(ret == EVEY_OK, ERR);
+
+            if(use_eco_pipe)
             {
-                unsigned int num_add_bytes_needed = target_num_bytes_in_units - num_bytes_in_units;
-                unsigned int num_add_cabac_zero_words = (num_add_bytes_needed + 2) / 3;
-                unsigned int num_add_cabac_zero_bytes = num_add_cabac_zero_words * 3;
-                for(unsigned int i = 0; i < num_add_cabac_zero_words; i++)
+                SBAC_LOAD(core->s_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], core->s_next_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2]);
+            }
+            else
+            {
+                SBAC_LOAD(core->s_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], *GET_SBAC_ENC(bs));
+            }
+            core->s_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].is_bit_count = 1;
+            core->s_curr_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].is_bit_est = ctx->mode.rate_est == RATE_EST_TABLE;
+
+            /* mode decision for a CTU */
+            ret = ctx->fn_mode_analyze_ctu(ctx, core);
+            evey_assert_g(ret == EVEY_OK, ERR);
+            ctx->stage_ns[EVEYE_STAGE_MODE] += evey_time_ns() - t0;
+
+            ctx->sh.qp_prev_eco = bef_cu_qp;
+
+            /* entropy coding for a CTU */
+            if(use_eco_pipe)
+            {
+                eco_pipe_push(ctx, core);
+            }
+            else
+            {
+                t0 = evey_time_ns();
+                ret = eveye_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->ctu_size, ctx->ctu_size, 0);
+                evey_assert_rv(ret == EVEY_OK, ret);
+                ctx->stage_ns[EVEYE_STAGE_ECO] += evey_time_ns() - t0;
+
+                if(ctx->nal_out.sink.row && core->x_ctu == ctx->w_ctu - 1)
                 {
-                    eveye_bsw_write(bs, 0, 16);
+                    nal_out_put(ctx, bs, 0);
                 }
             }
+
+            bef_cu_qp = ctx->sh.qp_prev_eco;
+            core->x_ctu++;
+            if(core->x_ctu >= ctx->w_ctu)
+            {
+                core->x_ctu = 0;
+                core->y_ctu++;
+            }
+            ctx->ctu_cnt--;
+        } /* end of CTU processing loop */
+
+        if(!use_eco_pipe)
+        {
+            slice_end(ctx, bs);
         }
     }
 
-    eveye_bsw_deinit(bs);
-    *size_field = (int)(bs->cur - cur_tmp) - 4; /* set nal_unit_size field */
-    curr_temp = bs->cur;
+    if(use_eco_pipe)
+    {
+        ret = eco_pipe_finish(ctx, 0);
+        evey_assert_rv(ret == EVEY_OK, ret);
+    }
 
     /* deblocking filter */
     if(sh->slice_deblocking_filter_flag)
@@ -1483,14 +1814,22 @@ static int eveye_enc_pic(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat)
 #if TRACE_DBF
         EVEY_TRACE_SET(1);
 #endif
+        t0 = evey_time_ns();
         ret = ctx->fn_deblock(ctx);
         evey_assert_rv(ret == EVEY_OK, ret);
+        ctx->stage_ns[EVEYE_STAGE_DBK] += evey_time_ns() - t0;
 #if TRACE_DBF
         EVEY_TRACE_SET(0);
 #endif
     }
 
     return EVEY_OK;
+ERR:
+    if(use_eco_pipe)
+    {
+        eco_pipe_finish(ctx, 1);
+    }
+    return ret;
 }
 
 static int eveye_enc(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat)
@@ -1517,20 +1856,49 @@ static int eveye_enc(EVEYE_CTX * ctx, EVEY_BITB * bitb, EVEYE_STAT * stat)
     ctx->fn_enc_pic_finish(ctx, bitb, stat);
     evey_assert_rv(ret == EVEY_OK, ret);
 
+    /* failure of the NAL sink */
+    evey_assert_rv(ctx->nal_out.err >= 0, ctx->nal_out.err);
+
     return EVEY_OK;
 }
 
+/* whether a pushed image can be encoded in place, converting its bit depth
+   at most */
+static int is_input_ref(EVEYE_CTX * ctx, EVEY_IMGB * img, int cs)
+{
+    return ctx->param.use_input_ref
+        && EVEY_CS_GET_FORMAT(img->cs) == EVEY_CS_GET_FORMAT(cs)
+        && EVEY_CS_GET_BYTE_DEPTH(img->cs) == 2 && EVEY_CS_GET_BYTE_DEPTH(cs) == 2
+        && img->w[0] == ctx->param.w && img->h[0] == ctx->param.h;
+}
+
 static int eveye_push_frm(EVEYE_CTX * ctx, EVEY_IMGB * img)
 {
     EVEY_PIC  * pic;
     EVEY_IMGB * imgb;
-    int         ret;
+    int         ret, cs;
 
-    ret = ctx->fn_get_inbuf(ctx, &imgb);
-    evey_assert_rv(EVEY_OK == ret, ret);
+    cs = EVEY_CS_SET(CF_FROM_CFI(ctx->cdsc.chroma_format_idc), ctx->cdsc.codec_bit_depth, 0);
+    if(is_input_ref(ctx, img, cs))
+    {
+        if(img->cs != cs)
+        {
+            evey_imgb_conv(img, cs);
+        }
+        imgb = img;
+        if(imgb->addref)
+        {
+            imgb->addref(imgb);
+        }
+    }
+    else
+    {
+        ret = ctx->fn_get_inbuf(ctx, &imgb);
+        evey_assert_rv(EVEY_OK == ret, ret);
 
-    imgb->cs = EVEY_CS_SET(CF_FROM_CFI(ctx->cdsc.chroma_format_idc), ctx->cdsc.codec_bit_depth, 0);
-    evey_imgb_cpy(imgb, img);
+        imgb->cs = cs;
+        evey_imgb_cpy(imgb, img);
+    }
 
     ctx->pic_icnt++;
     ctx->pico_idx = ctx->pic_icnt % ctx->pico_max_cnt;
@@ -1677,6 +2045,8 @@ EVEYE eveye_create(EVEYE_CDSC * cdsc, int * err)
     ctx = ctx_alloc();
     evey_assert_gv(ctx != NULL, ret, EVEY_ERR_OUT_OF_MEMORY, ERR);
     evey_mcpy(&ctx->cdsc, cdsc, sizeof(EVEYE_CDSC));
+    /* select kernels; keep the level actually used */
+    ctx->cdsc.isa = eveye_kfn_init(cdsc->isa);
 
     /* set default value for encoding parameter */
     ret = set_init_param(cdsc, &ctx->param);
@@ -1761,10 +2131,33 @@ int eveye_push(EVEYE id, EVEY_IMGB * img)
     return ctx->fn_push(ctx, img);
 }
 
+static void get_stats(EVEYE_CTX * ctx, EVEYE_STATS * stats)
+{
+    EVEYE_CNT * cnt = &ctx->core->cnt;
+    int         i;
+
+    *stats = ctx->stats;
+    stats->dbk_edge_cnt = ctx->dbk_edge_cnt;
+
+    /* add up the counters of the cores */
+    for(i = 0; i < EVEYE_STATS_CU_DEPTH_NUM; i++)
+    {
+        stats->cu_cnt[i] += cnt->cu[i];
+    }
+    for(i = 0; i < EVEYE_STATS_IPD_NUM; i++)
+    {
+        stats->intra_rdo_cnt[i] += cnt->intra_rdo[i];
+    }
+    stats->me_cnt += cnt->me;
+    stats->me_pts += cnt->me_pts;
+    stats->sbac_est_cnt += cnt->sbac_est;
+    stats->sbac_est_bits += cnt->sbac_est_bits;
+}
+
 int eveye_config(EVEYE id, int cfg, void * buf, int * size)
 {
     EVEYE_CTX * ctx;
-    int         t0;
+    int         t0, ret;
     EVEY_IMGB * imgb;
 
     EVEYE_ID_TO_CTX_RV(id, ctx, EVEY_ERR_INVALID_ARGUMENT);
@@ -1779,6 +2172,26 @@ int eveye_config(EVEYE id, int cfg, void * buf, int * size)
             /* store total input picture count at this time */
             ctx->pic_ticnt = ctx->pic_icnt;
             break;
+        case EVEYE_CFG_SET_INPUT_REF:
+            evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
+            t0 = *((int *)buf);
+            ctx->param.use_input_ref = (t0) ? 1 : 0;
+            break;
+        case EVEYE_CFG_SET_NAL_SINK:
+            evey_assert_rv(*size == sizeof(EVEYE_NAL_SINK), EVEY_ERR_INVALID_ARGUMENT);
+            evey_mcpy(&ctx->nal_out.sink, buf, sizeof(EVEYE_NAL_SINK));
+            break;
+        case EVEYE_CFG_SET_COMPLEXITY:
+            evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
+            t0 = *((int *)buf);
+            evey_assert_rv(t0 >= 0, EVEY_ERR_INVALID_ARGUMENT);
+            ret = ctx->fn_mode_set_complexity(ctx, t0);
+            evey_assert_rv(ret == EVEY_OK, ret);
+            ret = ctx->fn_pintra_set_complexity(ctx, t0);
+            evey_assert_rv(ret == EVEY_OK, ret);
+            ret = ctx->fn_pinter_set_complexity(ctx, t0);
+            evey_assert_rv(ret == EVEY_OK, ret);
+            break;
         case EVEYE_CFG_SET_FINTRA:
             evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
             t0 = *((int *)buf);
@@ -1824,6 +2237,10 @@ int eveye_config(EVEYE id, int cfg, void * buf, int * size)
             ctx->param.use_pic_sign = (*((int *)buf)) ? 1 : 0;
             break;
             /* get config *******************************************************/
+        case EVEYE_CFG_GET_COMPLEXITY:
+            evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
+            *((int *)buf) = ctx->mode.complexity;
+            break;
         case EVEYE_CFG_GET_QP:
             evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
             *((int *)buf) = ctx->param.qp;
@@ -1873,6 +2290,22 @@ int eveye_config(EVEYE id, int cfg, void * buf, int * size)
             evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
             *((int *)buf) = ctx->param.use_hgop;
             break;
+        case EVEYE_CFG_GET_ISA:
+            evey_assert_rv(*size == sizeof(int), EVEY_ERR_INVALID_ARGUMENT);
+            *((int *)buf) = ctx->cdsc.isa;
+            break;
+        case EVEYE_CFG_GET_STATS:
+            evey_assert_rv(*size == sizeof(EVEYE_STATS), EVEY_ERR_INVALID_ARGUMENT);
+            get_stats(ctx, (EVEYE_STATS *)buf);
+            break;
+        case EVEYE_CFG_GET_QM:
+            evey_assert_rv(*size == sizeof(EVEYE_QM), EVEY_ERR_INVALID_ARGUMENT);
+            evey_mset(buf, 0, sizeof(EVEYE_QM));
+            if(ctx->qm_job)
+            {
+                eveye_qm_take(ctx, (EVEYE_QM *)buf);
+            }
+            break;
         default:
             evey_trace("unknown config value (%d)\n", cfg);
             evey_assert_rv(0, EVEY_ERR_UNSUPPORTED);
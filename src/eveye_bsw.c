@@ -33,7 +33,7 @@
 
 
 /* number of bytes to be sunk */
-#define EVEYE_BSW_GET_SINK_BYTE(bs)     ((32 - (bs)->leftbits + 7) >> 3)
+#define EVEYE_BSW_GET_SINK_BYTE(bs)     ((64 - (bs)->leftbits + 7) >> 3)
 
 
 static int eveye_bsw_flush(EVEYE_BSW * bs)
@@ -42,11 +42,29 @@ static int eveye_bsw_flush(EVEYE_BSW * bs)
 
     while(bytes--)
     {
-        *bs->cur++ = (bs->code >> 24) & 0xFF;
+        *bs->cur++ = (bs->code >> 56) & 0xFF;
         bs->code <<= 8;
     }
 
-    bs->leftbits = 32;
+    bs->leftbits = 64;
+
+    return 0;
+}
+
+/* write out the upper 32 bits of the buffer at once */
+static __inline int bsw_sink_32b(EVEYE_BSW * bs)
+{
+    u8 * cur = bs->cur;
+
+    evey_assert_rv(cur + 4 <= bs->end, -1);
+
+    cur[0] = (u8)(bs->code >> 56);
+    cur[1] = (u8)(bs->code >> 48);
+    cur[2] = (u8)(bs->code >> 40);
+    cur[3] = (u8)(bs->code >> 32);
+    bs->cur = cur + 4;
+    bs->code <<= 32;
+    bs->leftbits += 32;
 
     return 0;
 }
@@ -59,7 +77,7 @@ void eveye_bsw_init(EVEYE_BSW * bs, u8 * buf, int size,
     bs->cur = buf;
     bs->end = buf + size - 1;
     bs->code = 0;
-    bs->leftbits = 32;
+    bs->leftbits = 64;
     bs->fn_flush = (fn_flush == NULL ? eveye_bsw_flush : fn_flush);
 }
 
@@ -70,7 +88,7 @@ void eveye_bsw_init_slice(EVEYE_BSW * bs, u8 * buf, int size,
     bs->cur = buf;
     bs->end = buf + size - 1;
     bs->code = 0;
-    bs->leftbits = 32;
+    bs->leftbits = 64;
     bs->fn_flush = (fn_flush == NULL ? eveye_bsw_flush : fn_flush);
 }
 
@@ -122,21 +140,13 @@ int eveye_bsw_write_trace(EVEYE_BSW * bs, u32 val, char * name, int len) /* len(
     }
 
     leftbits = bs->leftbits;
-    val <<= (32 - len);
-    bs->code |= (val >> (32 - leftbits));
+    /* bits of val above len are shifted out of the 64-bit buffer */
+    bs->code |= ((u64)val << (64 - len)) >> (64 - leftbits);
+    bs->leftbits = leftbits - len;
 
-    if (len < leftbits)
+    if(bs->leftbits <= 32)
     {
-        bs->leftbits -= len;
-    }
-    else
-    {
-        evey_assert_rv(bs->cur + 4 <= bs->end, -1);
-
-        bs->leftbits = 0;
-        bs->fn_flush(bs);
-        bs->code = (leftbits < 32 ? val << leftbits : 0);
-        bs->leftbits = 32 - (len - leftbits);
+        return bsw_sink_32b(bs);
     }
 
     return 0;
@@ -155,15 +165,11 @@ int eveye_bsw_write1_trace(EVEYE_BSW * bs, int val, char * name)
     }
 
     bs->leftbits--;
-    bs->code |= ((val & 0x1) << bs->leftbits);
+    bs->code |= ((u64)(val & 0x1) << bs->leftbits);
 
-    if (bs->leftbits == 0)
+    if(bs->leftbits == 32)
     {
-        evey_assert_rv(bs->cur <= bs->end, -1);
-        bs->fn_flush(bs);
-
-        bs->code = 0;
-        bs->leftbits = 32;
+        return bsw_sink_32b(bs);
     }
 
     return 0;
@@ -187,15 +193,11 @@ int eveye_bsw_write1(EVEYE_BSW * bs, int val)
     evey_assert(bs);
 
     bs->leftbits--;
-    bs->code |= ((val & 0x1) << bs->leftbits);
+    bs->code |= ((u64)(val & 0x1) << bs->leftbits);
 
-    if (bs->leftbits == 0)
+    if(bs->leftbits == 32)
     {
-        evey_assert_rv(bs->cur <= bs->end, -1);
-        bs->fn_flush(bs);
-
-        bs->code = 0;
-        bs->leftbits = 32;
+        return bsw_sink_32b(bs);
     }
 
     return 0;
@@ -208,21 +210,13 @@ int eveye_bsw_write(EVEYE_BSW * bs, u32 val, int len) /* len(1 ~ 32) */
     evey_assert(bs);
 
     leftbits = bs->leftbits;
-    val <<= (32 - len);
-    bs->code |= (val >> (32 - leftbits));
+    /* bits of val above len are shifted out of the 64-bit buffer */
+    bs->code |= ((u64)val << (64 - len)) >> (64 - leftbits);
+    bs->leftbits = leftbits - len;
 
-    if(len < leftbits)
+    if(bs->leftbits <= 32)
     {
-        bs->leftbits -= len;
-    }
-    else
-    {
-        evey_assert_rv(bs->cur + 4 <= bs->end, -1);
-
-        bs->leftbits = 0;
-        bs->fn_flush(bs);        
-        bs->code = (leftbits < 32 ? val << leftbits : 0);
-        bs->leftbits = 32 - (len - leftbits);
+        return bsw_sink_32b(bs);
     }
 
     return 0;
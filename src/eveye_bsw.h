@@ -46,9 +46,9 @@ typedef int (*EVEYE_BSW_FN_FLUSH)(EVEYE_BSW *bs);
 /*! Bitstream structure for encoder */
 struct _EVEYE_BSW
 {
-    /* buffer */
-    u32                 code;
-    /* bits left in buffer */
+    /* buffer, written out 32 bits at a time once the upper half is full */
+    u64                 code;
+    /* bits left in buffer (33 ~ 64 between calls) */
     int                 leftbits;
     /*! address of current writing position */
     u8                * cur;
@@ -38,6 +38,9 @@
 
 /* support RDOQ */
 #define SCALE_BITS               15    /* Inherited from TMuC, pressumably for fractional bit estimates in RDOQ */
+/* rate estimation of RDO */
+#define RATE_EST_SBAC            0     /* run the arithmetic coder and count the written bits */
+#define RATE_EST_TABLE           1     /* add up the fractional bits of each bin from the context states */
 #define ERR_SCALE_PRECISION_BITS 20
 
 /* EVEY encoder magic code */
@@ -93,6 +96,10 @@ typedef struct _EVEYE_MODE
     s16                  (* mvd)[MV_D];    
     /* address of best mv */
     s16                  (* mv)[MV_D];
+    /* complexity level */
+    int                     complexity;
+    /* rate estimation of RDO (RATE_EST_XXX) */
+    int                     rate_est;
 #if TRACE_ENC_CU_DATA
     u64                     trace_cu_idx;
 #endif
@@ -162,6 +169,22 @@ typedef struct _EVEYE_PINTRA
 #define MV_RANGE_MAX             1
 #define MV_RANGE_DIM             2
 
+/*****************************************************************************
+ * statistics counters
+ *****************************************************************************/
+/* counters of the analysis hot paths.
+   each core owns one block, which is added up when the statistics are read */
+typedef struct _EVEYE_CNT
+{
+    u64                     cu[NUM_CU_DEPTH];
+    u64                     intra_rdo[IPD_CNT];
+    u64                     me;
+    u64                     me_pts;
+    u64                     sbac_est;
+    u64                     sbac_est_bits;
+
+} EVEYE_CNT;
+
 typedef struct _EVEYE_PINTER EVEYE_PINTER;
 struct _EVEYE_PINTER
 {
@@ -217,6 +240,8 @@ struct _EVEYE_PINTER
     pel                   * pred_y_best;
     /* ME function (Full-ME or Fast-ME) */
     u32  (*fn_me)(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh, s8 *refi, int lidx, s16 mvp[MV_D], s16 mv[MV_D], int bi, int bit_depth_luma);
+    /* counters of the core being analyzed */
+    EVEYE_CNT             * cnt;
 
     int                     complexity;
     void                  * pdata[4];
@@ -259,6 +284,8 @@ typedef struct _EVEYE_PARAM
     int                     ref_pic_gap_length;
     /* start bumping process if force_output is on */
     int                     force_output;
+    /* encode pushed image buffers in place (EVEYE_CFG_SET_INPUT_REF) */
+    int                     use_input_ref;
     int                     gop_size;
     int                     use_dqp;
     int                     use_closed_gop;
@@ -269,8 +296,12 @@ typedef struct _EVEYE_PARAM
 
 } EVEYE_PARAM;
 
+/* RDO copies this structure for every candidate, so the members are
+   ordered to leave no padding */
 typedef struct _EVEYE_SBAC
 {
+    /* estimated rate in 1/(1 << SCALE_BITS) bit unit */
+    s64                     frac_bits;
     u32                     range;
     u32                     code;
     u32                     code_bits;
@@ -278,10 +309,12 @@ typedef struct _EVEYE_SBAC
     u32                     stacked_zero;
     u32                     pending_byte;
     u32                     is_pending_byte;
-    EVEY_SBAC_CTX           ctx;
     u32                     bit_counter;
-    u8                      is_bit_count;
     u32                     bin_counter;
+    EVEY_SBAC_CTX           ctx;
+    u8                      is_bit_count;
+    /* estimate the rate from the context states instead of coding */
+    u8                      is_bit_est;
 
 } EVEYE_SBAC;
 
@@ -325,9 +358,10 @@ typedef struct _EVEYE_CORE
 {
     EVEY_CORE; /* should be first */
        
-    /* CU data for RDO */
-    EVEYE_CU_DATA           cu_data_best[MAX_CU_DEPTH][MAX_CU_DEPTH];
-    EVEYE_CU_DATA           cu_data_temp[MAX_CU_DEPTH][MAX_CU_DEPTH];
+    /* CU data for RDO. the best and temporary data of a CU size are
+       exchanged instead of copied when the temporary one wins */
+    EVEYE_CU_DATA         * cu_data_best[MAX_CU_DEPTH][MAX_CU_DEPTH];
+    EVEYE_CU_DATA         * cu_data_temp[MAX_CU_DEPTH][MAX_CU_DEPTH];
     EVEYE_DQP               dqp_data[MAX_CU_DEPTH][MAX_CU_DEPTH];
     /* temporary coefficient buffer */
     EVEYE_DQP               dqp_curr_best[MAX_CU_DEPTH][MAX_CU_DEPTH];
@@ -364,6 +398,8 @@ typedef struct _EVEYE_CORE
 #if TRACE_ENC_CU_DATA
     u64                     trace_idx;
 #endif
+    /* hot path counters */
+    EVEYE_CNT               cnt;
     /* platform specific data, if needed */
     void                  * pf;
 
@@ -376,6 +412,70 @@ typedef struct _EVEYE_CORE
  *****************************************************************************/
  typedef struct _EVEYE_CTX EVEYE_CTX;
 
+/* entropy coding pipeline. mode decision hands over the decided CTUs in
+   raster order by increasing ctu_ready, and the entropy coding thread
+   codes them from its own copy of the context */
+typedef struct _EVEYE_ECO_PIPE
+{
+    /* thread entropy coding the current picture */
+    EVEY_THREAD             thread;
+    /* copy of the encoder context for the entropy coding thread */
+    EVEYE_CTX             * ctx;
+    /* core for the entropy coding thread */
+    EVEYE_CORE            * core;
+    /* SCU map updated by the entropy coding; it is swapped with the map
+       of mode decision after each picture */
+    u32                   * map_scu;
+    /* SCU map of mode decision */
+    u32                   * map_scu_mode;
+    /* number of CTUs decided by mode decision */
+    volatile int            ctu_ready;
+    /* number of CTUs entropy coded */
+    volatile int            ctu_done;
+    /* set when mode decision stops in the middle of a picture */
+    volatile int            abort;
+    /* wall time of the entropy coding for the current picture */
+    s64                     eco_ns;
+} EVEYE_ECO_PIPE;
+
+/* quality metrics of a picture, measured by a helper thread while the next
+   picture is encoded. the original and the reconstruction stay referenced
+   until eveye_qm_wait() */
+typedef struct _EVEYE_QM_JOB
+{
+    /* thread measuring the picture, NULL once joined */
+    EVEY_THREAD             thread;
+    /* set from eveye_qm_start() to eveye_qm_wait() */
+    int                     busy;
+    EVEY_IMGB             * imgb_org;
+    EVEY_IMGB             * imgb_rec;
+    EVEY_PIC                org;
+    EVEY_PIC                rec;
+    int                     bit_depth;
+    /* number of planes */
+    int                     np;
+    EVEYE_QM                qm;
+    /* 4x4 block sums of two block rows for SSIM, ssim_sum_w per row */
+    int                  (* ssim_sum)[4];
+    int                     ssim_sum_w;
+    /* downscaled luma planes for MS-SSIM */
+    pel                   * ms_org;
+    pel                   * ms_rec;
+} EVEYE_QM_JOB;
+
+/* NAL unit being given to the NAL sink as it is written */
+typedef struct _EVEYE_NAL_OUT
+{
+    EVEYE_NAL_SINK          sink;
+    /* NAL unit after its size field, and the end of the part given to the
+       sink */
+    u8                    * beg;
+    u8                    * pos;
+    int                     nalu_type;
+    /* first error returned by the sink for the current picture */
+    int                     err;
+} EVEYE_NAL_OUT;
+
 struct _EVEYE_CTX
 {
     EVEY_CTX; /* should be first */
@@ -425,10 +525,23 @@ struct _EVEYE_CTX
     /* inter prediction analysis */
     EVEYE_PINTER            pinter;
     /* cu data for current CTU */
-    EVEYE_CU_DATA         * map_cu_data;
+    EVEYE_CU_DATA        ** map_cu_data;
     double                  lambda[3];
     double                  sqrt_lambda[3];
     double                  dist_chroma_weight[2];
+    /* wall time of each stage (EVEYE_STAGE_XXX) for the current picture */
+    s64                     stage_ns[EVEYE_STAGE_NUM];
+    /* picture level statistics; the core counters are added on read */
+    EVEYE_STATS             stats;
+    /* entropy coding pipeline, NULL if not used */
+    EVEYE_ECO_PIPE        * eco_pipe;
+    /* quality metrics, NULL if not used */
+    EVEYE_QM_JOB          * qm_job;
+    /* NAL sink; the entropy coding thread works on a copy taken back
+       with the bitstream */
+    EVEYE_NAL_OUT           nal_out;
+    /* size field of the slice NAL unit being written */
+    u8                    * slice_beg;
 
     int    (*fn_ready)(EVEYE_CTX * ctx);
     void   (*fn_flush)(EVEYE_CTX * ctx);
@@ -470,5 +583,7 @@ struct _EVEYE_CTX
 #include "eveye_pintra.h"
 #include "eveye_pinter.h"
 #include "eveye_tbl.h"
+#include "eveye_qm.h"
+#include "eveye_dispatch.h"
 
 #endif /* _EVEYE_DEF_H_ */
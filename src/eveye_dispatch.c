@@ -0,0 +1,85 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "eveye_def.h"
+
+/* filled by eveye_kfn_init() when an encoder is created */
+EVEYE_KFN eveye_kfn;
+
+void eveye_kfn_init_c(EVEYE_KFN * kfn)
+{
+    int i, j;
+
+    for(i = 0; i < 8; i++)
+    {
+        for(j = 0; j < 8; j++)
+        {
+            kfn->sad[i][j] = eveye_sad_16b_c;
+            kfn->ssd[i][j] = eveye_ssd_16b_c;
+            kfn->satd[i][j] = evey_had;
+            kfn->diff[i][j] = eveye_diff_16b_c;
+        }
+    }
+    kfn->had_4x4 = evey_had_4x4;
+    kfn->had_8x8 = evey_had_8x8;
+    kfn->had_16x8 = evey_had_16x8;
+    kfn->had_8x16 = evey_had_8x16;
+    kfn->had_8x4 = evey_had_8x4;
+    kfn->had_4x8 = evey_had_4x8;
+    kfn->rdoq_prepass = eveye_rdoq_prepass_c;
+    kfn->quant_block = eveye_quant_block_c;
+    kfn->get_max_abs_coef = eveye_get_max_abs_coef_c;
+    kfn->sse_plane = eveye_sse_plane_c;
+    kfn->ssim_4x4 = eveye_ssim_4x4_c;
+}
+
+int eveye_kfn_init(int isa)
+{
+    EVEYE_KFN kfn;
+
+    isa = evey_kfn_init(isa);
+
+    eveye_kfn_init_c(&kfn);
+#if X86_SSE
+    if(isa >= EVEY_ISA_SSE4)
+    {
+        eveye_kfn_init_sse(&kfn);
+    }
+#endif
+
+    /* shared by all the encoder instances, like evey_kfn */
+    evey_global_lock();
+    if(memcmp(&eveye_kfn, &kfn, sizeof(EVEYE_KFN)))
+    {
+        eveye_kfn = kfn;
+    }
+    evey_global_unlock();
+    return isa;
+}
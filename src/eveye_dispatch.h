@@ -0,0 +1,79 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _EVEYE_DISPATCH_H_
+#define _EVEYE_DISPATCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* kernel table of the encoder library; see EVEY_KFN for how it is filled */
+typedef struct _EVEYE_KFN
+{
+    /* index: [log2 of width][log2 of height] */
+    EVEYE_FN_SAD            sad[8][8];
+    EVEYE_FN_SSD            ssd[8][8];
+    EVEYE_FN_SATD           satd[8][8];
+    EVEYE_FN_DIFF           diff[8][8];
+    /* hadamard blocks of evey_had() */
+    EVEYE_FN_HAD            had_4x4;
+    EVEYE_FN_HAD            had_8x8;
+    EVEYE_FN_HAD            had_16x8;
+    EVEYE_FN_HAD            had_8x16;
+    EVEYE_FN_HAD            had_8x4;
+    EVEYE_FN_HAD            had_4x8;
+    /* quantization */
+    EVEYE_FN_RDOQ_PREPASS   rdoq_prepass;
+    EVEYE_FN_QUANT_BLOCK    quant_block;
+    EVEYE_FN_MAX_ABS_COEF   get_max_abs_coef;
+    /* quality metrics */
+    EVEYE_FN_SSE_PLANE      sse_plane;
+    EVEYE_FN_SSIM_4X4       ssim_4x4;
+
+} EVEYE_KFN;
+
+extern EVEYE_KFN eveye_kfn;
+
+/* fill both evey_kfn and eveye_kfn for the requested ISA level
+   (EVEY_ISA_XXX); returns the selected level */
+int eveye_kfn_init(int isa);
+
+void eveye_kfn_init_c(EVEYE_KFN * kfn);
+#if X86_SSE
+void eveye_kfn_init_sse(EVEYE_KFN * kfn);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _EVEYE_DISPATCH_H_ */
@@ -245,8 +245,27 @@ int eveye_eco_pps(EVEYE_BSW * bs, EVEY_SPS * sps, EVEY_PPS * pps)
     eveye_bsw_write_ue(bs, 0);                               /* Should be 0 (pps->num_ref_idx_default_active_minus1[1]) */
     eveye_bsw_write_ue(bs, 0);                               /* Should be 0 (pps->additional_lt_poc_lsb_len) */
     eveye_bsw_write1(bs, 0);                                 /* Should be 0 (pps->rpl1_idx_present_flag) */
-    eveye_bsw_write1(bs, 1);                                 /* Should be 1 (pps->single_tile_in_pic_flag) */
-    eveye_bsw_write_ue(bs, 0);                               /* Should be sent, but not used (pps->tile_id_len_minus1) */
+    eveye_bsw_write1(bs, pps->single_tile_in_pic_flag);
+    if(!pps->single_tile_in_pic_flag)
+    {
+        eveye_bsw_write_ue(bs, pps->num_tile_columns_minus1);
+        eveye_bsw_write_ue(bs, pps->num_tile_rows_minus1);
+        eveye_bsw_write1(bs, pps->uniform_tile_spacing_flag);
+        if(!pps->uniform_tile_spacing_flag)
+        {
+            for(int i = 0; i < pps->num_tile_columns_minus1; i++)
+            {
+                eveye_bsw_write_ue(bs, pps->tile_column_width_minus1[i]);
+            }
+            for(int i = 0; i < pps->num_tile_rows_minus1; i++)
+            {
+                eveye_bsw_write_ue(bs, pps->tile_row_height_minus1[i]);
+            }
+        }
+        eveye_bsw_write1(bs, pps->loop_filter_across_tiles_enabled_flag);
+        eveye_bsw_write_ue(bs, pps->tile_offset_lens_minus1);
+    }
+    eveye_bsw_write_ue(bs, pps->tile_id_len_minus1);
     eveye_bsw_write1(bs, 0);                                 /* Should be sent, but not used (pps->explicit_tile_id_flag) */
     eveye_bsw_write1(bs, 0);                                 /* Should be 0 (pps->pic_dra_enabled_flag) */
     eveye_bsw_write1(bs, 0);                                 /* Should be 0 (pps->arbitrary_slice_present_flag) */
@@ -280,6 +299,11 @@ int eveye_eco_sh(EVEYE_BSW * bs, EVEY_SPS * sps, EVEY_PPS * pps, EVEY_SH * sh, i
 #endif
 
     eveye_bsw_write_ue(bs, sh->slice_pic_parameter_set_id);
+    if(!pps->single_tile_in_pic_flag)
+    {
+        eveye_bsw_write1(bs, sh->single_tile_in_slice_flag);
+        eveye_bsw_write(bs, sh->first_tile_id, pps->tile_id_len_minus1 + 1);
+    }
     eveye_bsw_write_ue(bs, sh->slice_type);
 
     if(nut == EVEY_IDR_NUT)
@@ -370,21 +394,24 @@ static void sbac_put_byte(u8 writing_byte, EVEYE_SBAC * sbac, EVEYE_BSW * bs)
         }
         else
         {
+            /* stacked zero bytes are written up to four at a time */
             while(sbac->stacked_zero > 0)
             {
+                int zero_bytes = EVEY_MIN(sbac->stacked_zero, 4);
+
                 if(sbac->is_bit_count)
                 {
-                    eveye_bsw_write_est(sbac, 0x00, 8);
+                    eveye_bsw_write_est(sbac, 0x00, zero_bytes << 3);
                 }
                 else
                 {
 #if TRACE_HLS
-                    eveye_bsw_write_trace(bs, 0x00, 0, 8);
+                    eveye_bsw_write_trace(bs, 0x00, 0, zero_bytes << 3);
 #else
-                    eveye_bsw_write(bs, 0x00, 8);
+                    eveye_bsw_write(bs, 0x00, zero_bytes << 3);
 #endif
                 }
-                sbac->stacked_zero--;
+                sbac->stacked_zero -= zero_bytes;
             }
 
             if(sbac->is_bit_count)
@@ -440,6 +467,12 @@ static void sbac_encode_bin_ep(u32 bin, EVEYE_SBAC * sbac, EVEYE_BSW * bs)
 {
     sbac->bin_counter++;
 
+    if(sbac->is_bit_est)
+    {
+        sbac->frac_bits += 1 << SCALE_BITS;
+        return;
+    }
+
     (sbac->range) >>= 1;
 
     if(bin != 0)
@@ -516,13 +549,67 @@ static void sbac_write_truncate_unary_sym(u32 sym, u32 num_ctx, u32 max_num, EVE
     }
 }
 
+/* encode num_bin bypass bins of value, MSB first (num_bin: 0 ~ 32).
+   A bypass bin doubles the code and adds the even part of the range, so
+   all bins up to the next output byte are added with one multiply */
 static void sbac_encode_bins_ep(u32 value, int num_bin, EVEYE_SBAC * sbac, EVEYE_BSW * bs)
 {
-    int bin = 0;
-    for(bin = num_bin - 1; bin >= 0; bin--)
+    u32 range, pattern;
+    int bins;
+
+    sbac->bin_counter += num_bin;
+
+    if(sbac->is_bit_est)
+    {
+        sbac->frac_bits += (s64)num_bin << SCALE_BITS;
+        return;
+    }
+
+    range = sbac->range & ~1u;
+    sbac->range = range;
+
+    while(num_bin > 0)
+    {
+        bins = EVEY_MIN(num_bin, (int)sbac->code_bits);
+        num_bin -= bins;
+        pattern = (value >> num_bin) & ((1u << bins) - 1);
+
+        sbac->code = (sbac->code << bins) + range * pattern;
+        sbac->code_bits -= bins;
+
+        if(sbac->code_bits == 0)
+        {
+            sbac_carry_propagate(sbac, bs);
+            sbac->code_bits = 8;
+        }
+    }
+}
+
+static void sbac_est_bin(u32 bin, EVEYE_SBAC * sbac, SBAC_CTX_MODEL * model)
+{
+    u16 mps, state;
+
+    state = (*model) >> 1;
+    mps = (*model) & 1;
+
+    if(bin != mps)
     {
-        sbac_encode_bin_ep(value & (1 << (u32)bin), sbac, bs);
+        sbac->frac_bits += eveye_entropy_bits[state << 1];
+
+        state = state + ((512 - state + 16) >> 5);
+        if(state > 256)
+        {
+            mps = 1 - mps;
+            state = 512 - state;
+        }
     }
+    else
+    {
+        sbac->frac_bits += eveye_entropy_bits[(512 - state) << 1];
+
+        state = state - ((state + 16) >> 5);
+    }
+    *model = (state << 1) + mps;
 }
 
 void eveye_sbac_encode_bin(u32 bin, EVEYE_SBAC * sbac, SBAC_CTX_MODEL * model, EVEYE_BSW * bs)
@@ -532,6 +619,12 @@ void eveye_sbac_encode_bin(u32 bin, EVEYE_SBAC * sbac, SBAC_CTX_MODEL * model, E
 
     sbac->bin_counter++;
 
+    if(sbac->is_bit_est)
+    {
+        sbac_est_bin(bin, sbac, model);
+        return;
+    }
+
     state = (*model) >> 1;
     mps = (*model) & 1;
 
@@ -1188,17 +1281,14 @@ static int eveye_eco_abs_mvd(u32 sym, EVEYE_SBAC * sbac, SBAC_CTX_MODEL * model,
 
     len_c = (len_i << 1) + 1;
 
-    for(i = 0; i < len_c; i++)
+    /* use one context model for the first two bins */
+    for(i = 0; i < len_c && i <= 1; i++)
     {
-        int bin = (code >> (len_c - 1 - i)) & 0x01;
-        if(i <= 1)
-        {
-            eveye_sbac_encode_bin(bin, sbac, model, bs); /* use one context model for two bins */
-        }
-        else
-        {
-            sbac_encode_bin_ep(bin, sbac, bs);
-        }
+        eveye_sbac_encode_bin((code >> (len_c - 1 - i)) & 0x01, sbac, model, bs);
+    }
+    if(len_c > 2)
+    {
+        sbac_encode_bins_ep(code, len_c - 2, sbac, bs);
     }
 
     return EVEY_OK;
@@ -1253,13 +1343,13 @@ int eveye_eco_mvd(EVEYE_BSW * bs, s16 mvd[MV_D])
 
 static int eco_cu_init(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y, int cup, int cuw, int cuh)
 {
-    EVEYE_CU_DATA * cu_data = &ctx->map_cu_data[core->ctu_num];
+    EVEYE_CU_DATA * cu_data = ctx->map_cu_data[core->ctu_num];
 
     core->log2_cuw = EVEY_CONV_LOG2(cuw);
     core->log2_cuh = EVEY_CONV_LOG2(cuh);
     core->x_scu = PEL2SCU(x);
     core->y_scu = PEL2SCU(y);
-    core->scup = ((u32)core->y_scu * ctx->w_scu) + core->x_scu;
+    core->scup = SCU_IDX(core->x_scu, core->y_scu, ctx->w_scu);
     core->avail_cu = 0;
     core->nnz[Y_C] = core->nnz[U_C] = core->nnz[V_C] = 0;
     core->pred_mode = cu_data->pred_mode[cup];
@@ -1324,7 +1414,7 @@ static int eco_cu_deinit(EVEYE_CTX * ctx, EVEYE_CORE * core)
                 MCU_SET_QP(map_scu[j], ctx->sh.qp_prev_eco);
             }
         }
-        map_scu += ctx->w_scu;
+        map_scu += SCU_STRIDE(ctx->w_scu);
     }
 
 #if TRACE_ENC_CU_DATA
@@ -1369,9 +1459,9 @@ static int eco_cu_deinit(EVEYE_CTX * ctx, EVEYE_CORE * core)
                 EVEY_TRACE_STR("\n");
             }
 
-            map_refi += ctx->w_scu;
-            map_mv += ctx->w_scu;
-            map_scu += ctx->w_scu;
+            map_refi += SCU_STRIDE(ctx->w_scu);
+            map_mv += SCU_STRIDE(ctx->w_scu);
+            map_scu += SCU_STRIDE(ctx->w_scu);
         }
     }
 #endif
@@ -1435,11 +1525,11 @@ int eveye_eco_split_mode(EVEYE_BSW * bs, EVEYE_CTX * ctx, EVEYE_CORE * core, int
        
     if(sbac->is_bit_count)
     {
-        evey_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctu_s, core->cu_data_temp[EVEY_CONV_LOG2(cuw) - 2][EVEY_CONV_LOG2(cuh) - 2].split_mode);
+        evey_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctu_s, core->cu_data_temp[EVEY_CONV_LOG2(cuw) - 2][EVEY_CONV_LOG2(cuh) - 2]->split_mode);
     }
     else
     {
-        evey_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctu_s, ctx->map_cu_data[core->ctu_num].split_mode);
+        evey_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctu_s, ctx->map_cu_data[core->ctu_num]->split_mode);
     }
 
     eveye_sbac_encode_bin(split_mode != NO_SPLIT, sbac, sbac->ctx.split_cu_flag, bs); /* split_cu_flag */
@@ -1465,7 +1555,7 @@ int eveye_eco_split_mode(EVEYE_BSW * bs, EVEYE_CTX * ctx, EVEYE_CORE * core, int
 int eveye_eco_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y, int cup, int cuw, int cuh)
 {
     EVEYE_BSW     * bs = &ctx->bs;    
-    EVEYE_CU_DATA * cu_data = &ctx->map_cu_data[core->ctu_num];
+    EVEYE_CU_DATA * cu_data = ctx->map_cu_data[core->ctu_num];
     int             slice_type = ctx->sh.slice_type;
 
     /* initialization */
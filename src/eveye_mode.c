@@ -34,7 +34,7 @@
 #include <math.h>
 
 
-static s32 entropy_bits[1024];
+s32 eveye_entropy_bits[1024];
 
 void eveye_sbac_bit_reset(EVEYE_SBAC * sbac)
 {
@@ -46,11 +46,25 @@ void eveye_sbac_bit_reset(EVEYE_SBAC * sbac)
     sbac->stacked_zero    = 0;
     sbac->bit_counter     = 0;
     sbac->bin_counter     = 0;
+    sbac->frac_bits       = 0;
 }
 
-u32 eveye_get_bit_number(EVEYE_SBAC *sbac)
+u32 eveye_get_bit_number(EVEYE_CORE * core)
 {
-    return sbac->bit_counter + 8 * (sbac->stacked_zero + sbac->stacked_ff) + 8 * (sbac->is_pending_byte ? 1 : 0) + 8 - sbac->code_bits + 3;
+    EVEYE_SBAC * sbac = &core->s_temp_run;
+    u32          bits;
+
+    if(sbac->is_bit_est)
+    {
+        bits = (u32)((sbac->frac_bits + (1 << (SCALE_BITS - 1))) >> SCALE_BITS);
+    }
+    else
+    {
+        bits = sbac->bit_counter + 8 * (sbac->stacked_zero + sbac->stacked_ff) + 8 * (sbac->is_pending_byte ? 1 : 0) + 8 - sbac->code_bits + 3;
+    }
+    core->cnt.sbac_est++;
+    core->cnt.sbac_est_bits += bits;
+    return bits;
 }
 
 void eveye_rdo_bit_cnt_mvp(EVEYE_CTX * ctx, EVEYE_CORE * core, s8 refi[LIST_NUM], s16 mvd[LIST_NUM][MV_D], int pidx, int mvp_idx)
@@ -237,7 +251,7 @@ void eveye_init_bits_est()
     for(i = 0; i < 1024; i++)
     {
         p = (512 * (i + 0.5)) / 1024;
-        entropy_bits[i] = (s32)(-32768 * (log(p) / log(2.0) - 9));
+        eveye_entropy_bits[i] = (s32)(-32768 * (log(p) / log(2.0) - 9));
     }
 }
 
@@ -247,7 +261,7 @@ static s32 biari_no_bits(int symbol, SBAC_CTX_MODEL* cm)
     mps = (*cm) & 1;
     state = (*cm) >> 1;
     state = ((u16)(symbol != 0) != mps) ? state : (512 - state);
-    return entropy_bits[state << 1];
+    return eveye_entropy_bits[state << 1];
 }
 
 static void eveye_rdoq_bit_est(EVEYE_CORE * core, EVEYE_SBAC * sbac)
@@ -429,6 +443,16 @@ static int copy_cu_data(EVEYE_CU_DATA * dst, EVEYE_CU_DATA * src, int x, int y,
     return EVEY_OK;
 }
 
+/* the temporary buffers of a CU size become the best ones by exchanging
+   the two, which is valid only when the whole CU is taken over */
+static void swap_cu_data(EVEYE_CU_DATA ** best, EVEYE_CU_DATA ** temp)
+{
+    EVEYE_CU_DATA * t = *best;
+
+    *best = *temp;
+    *temp = t;
+}
+
 void get_min_max_qp(EVEYE_CTX * ctx, EVEYE_CORE * core, s8 * min_qp, s8 * max_qp, int * is_dqp_set, EVEY_SPLIT_MODE split_mode, int cuw, int cuh, u8 qp, int x0, int y0)
 {
     *is_dqp_set = 0;
@@ -462,7 +486,7 @@ static int mode_cu_init(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y, int lo
     core->log2_cuh = log2_cuh;
     core->x_scu = PEL2SCU(x);
     core->y_scu = PEL2SCU(y);
-    core->scup = ((u32)core->y_scu * ctx->w_scu) + core->x_scu;
+    core->scup = SCU_IDX(core->x_scu, core->y_scu, ctx->w_scu);
     core->avail_cu = 0;
     core->nnz[Y_C] = core->nnz[U_C] = core->nnz[V_C] = 0;
     evey_mset(core->nnz_sub, 0, sizeof(int) * N_C * MAX_SUB_TB_NUM);
@@ -520,7 +544,7 @@ static void copy_rec_to_pic(EVEYE_CORE * core, int x, int y, int w, int h, EVEY_
     log2_w = EVEY_CONV_LOG2(w);
     log2_h = EVEY_CONV_LOG2(h);
 
-    cu_data = &core->cu_data_best[log2_w - 2][log2_h - 2];
+    cu_data = core->cu_data_best[log2_w - 2][log2_h - 2];
 
     s_pic = pic->s_l;
 
@@ -589,7 +613,7 @@ static void copy_best_cu_data(EVEYE_CTX * ctx, EVEYE_CORE * core)
 
     cuw = 1 << core->log2_cuw;
     cuh = 1 << core->log2_cuh;
-    cu_data = &core->cu_data_temp[core->log2_cuw - 2][core->log2_cuh - 2];
+    cu_data = core->cu_data_temp[core->log2_cuw - 2][core->log2_cuh - 2];
 
     /* copy coef */
     size = cuw * cuh * sizeof(s16);
@@ -722,14 +746,14 @@ static void update_map_scu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y, int
     log2_src_cuw = EVEY_CONV_LOG2(src_cuw);
     log2_src_cuh = EVEY_CONV_LOG2(src_cuh);
 
-    map_scu = ctx->map_scu + scu_y * ctx->w_scu + scu_x;
-    src_map_scu = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2].map_scu;
-    map_ipm = ctx->map_ipm + scu_y * ctx->w_scu + scu_x;
-    src_map_ipm = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2].ipm[0];
-    map_mv = ctx->map_mv + scu_y * ctx->w_scu + scu_x;
-    src_map_mv = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2].mv;
-    map_refi = ctx->map_refi + scu_y * ctx->w_scu + scu_x;
-    src_map_refi = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2].refi;
+    map_scu = ctx->map_scu + SCU_IDX(scu_x, scu_y, ctx->w_scu);
+    src_map_scu = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2]->map_scu;
+    map_ipm = ctx->map_ipm + SCU_IDX(scu_x, scu_y, ctx->w_scu);
+    src_map_ipm = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2]->ipm[0];
+    map_mv = ctx->map_mv + SCU_IDX(scu_x, scu_y, ctx->w_scu);
+    src_map_mv = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2]->mv;
+    map_refi = ctx->map_refi + SCU_IDX(scu_x, scu_y, ctx->w_scu);
+    src_map_refi = core->cu_data_best[log2_src_cuw - 2][log2_src_cuh - 2]->refi;
 
     if(x + src_cuw > ctx->w)
     {
@@ -762,16 +786,16 @@ static void update_map_scu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y, int
         evey_mcpy(map_mv, src_map_mv, size_mv);
         evey_mcpy(map_refi, *(src_map_refi), size_refi);
 
-        map_scu += ctx->w_scu;
+        map_scu += SCU_STRIDE(ctx->w_scu);
         src_map_scu += (src_cuw >> MIN_CU_LOG2);
 
-        map_ipm += ctx->w_scu;
+        map_ipm += SCU_STRIDE(ctx->w_scu);
         src_map_ipm += (src_cuw >> MIN_CU_LOG2);
 
-        map_mv += ctx->w_scu;
+        map_mv += SCU_STRIDE(ctx->w_scu);
         src_map_mv += (src_cuw >> MIN_CU_LOG2);
         
-        map_refi += ctx->w_scu;
+        map_refi += SCU_STRIDE(ctx->w_scu);
         src_map_refi += (src_cuw >> MIN_CU_LOG2);
     }
 }
@@ -781,7 +805,7 @@ static void clear_map_scu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y, int
     u32 * map_scu;
     int   w, h, i, size;
 
-    map_scu = ctx->map_scu + (y >> MIN_CU_LOG2) * ctx->w_scu + (x >> MIN_CU_LOG2);
+    map_scu = ctx->map_scu + SCU_IDX(x >> MIN_CU_LOG2, y >> MIN_CU_LOG2, ctx->w_scu);
 
     if(x + cuw > ctx->w)
     {
@@ -801,7 +825,7 @@ static void clear_map_scu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y, int
     for(i = 0; i < h; i++)
     {
         evey_mset(map_scu, 0, size);
-        map_scu += ctx->w_scu;
+        map_scu += SCU_STRIDE(ctx->w_scu);
     }
 }
 
@@ -809,15 +833,19 @@ static double mode_coding_unit(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y,
 {
     double cost_intra = MAX_COST;
     double cost_inter = MAX_COST;
+    s64    t0;
 
     /* prepare CU mode decision */
     mode_cu_init(ctx, core, x, y, log2_cuw, log2_cuh, cud);
+    core->cnt.cu[cud]++;
 
     /* inter decision */
     if(ctx->sh.slice_type != SLICE_I)
     {
         /* inter mode decision */
+        t0 = evey_time_ns();
         cost_inter = ctx->fn_pinter_analyze_cu(ctx, core, x, y);
+        ctx->stage_ns[EVEYE_STAGE_INTER] += evey_time_ns() - t0;
         copy_best_cu_data(ctx, core);
     }
 
@@ -827,7 +855,9 @@ static double mode_coding_unit(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y,
 #endif
     {
         /* intra mode decision */
+        t0 = evey_time_ns();
         cost_intra = ctx->fn_pintra_analyze_cu(ctx, core, x, y);
+        ctx->stage_ns[EVEYE_STAGE_INTRA] += evey_time_ns() - t0;
         if(cost_intra < cost_inter)
         {
             copy_best_cu_data(ctx, core);
@@ -850,7 +880,8 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
     int             bit_cnt;
     double          cost_best = MAX_COST;
     double          cost_temp = MAX_COST;
-    EVEYE_SBAC      s_temp_depth = {0};
+    EVEYE_SBAC      s_temp_depth;
+    EVEYE_SBAC    * s_best_next = NULL; /* SBAC after the best candidate */
     int             boundary = !(x0 + cuw <= ctx->w && y0 + cuh <= ctx->h);
     int             split_allow[NUM_SPLIT_MODE]; /* allowed split by normative and non-normative selection */
     EVEY_SPLIT_MODE split_mode = NO_SPLIT;
@@ -887,7 +918,7 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
     if(!boundary)
     {
         cost_temp = 0.0;
-        init_cu_data(&core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
+        init_cu_data(core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
 
         ctx->sh.qp_prev_mode = core->dqp_data[log2_cuw - 2][log2_cuh - 2].prev_qp;
         best_dqp = ctx->sh.qp_prev_mode;
@@ -900,9 +931,9 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
                 /* count bits for CU split flag */
                 SBAC_LOAD(core->s_temp_run, core->s_curr_best[log2_cuw - 2][log2_cuh - 2]);
                 eveye_sbac_bit_reset(&core->s_temp_run);
-                evey_set_split_mode(NO_SPLIT, cud, 0, cuw, cuh, cuw, core->cu_data_temp[log2_cuw - 2][log2_cuh - 2].split_mode);
+                evey_set_split_mode(NO_SPLIT, cud, 0, cuw, cuh, cuw, core->cu_data_temp[log2_cuw - 2][log2_cuh - 2]->split_mode);
                 eveye_eco_split_mode(&core->bs_temp, ctx, core, cud, 0, cuw, cuh, cuw); /* split_cu_flag */
-                bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+                bit_cnt = eveye_get_bit_number(core);
                 cost_temp += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
                 SBAC_STORE(core->s_curr_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_run);
             }
@@ -914,7 +945,7 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
                 core->qp = GET_QP((s8)qp, dqp - (s8)qp);
                 core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2].curr_qp = core->qp;
                 cost_temp_dqp = cost_temp;
-                init_cu_data(&core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
+                init_cu_data(core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
                 clear_map_scu(ctx, core, x0, y0, cuw, cuh);
 
                 /* CU mode decision */
@@ -925,10 +956,20 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
                     cu_mode_dqp = core->pred_mode;
                     dist_cu_best_dqp = core->dist_cu_best;
                     /* backup the current best data */
-                    copy_cu_data(&core->cu_data_best[log2_cuw - 2][log2_cuh - 2], &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], 0, 0, log2_cuw, log2_cuh, log2_cuw, cud, ctx->sps.chroma_format_idc);
+                    swap_cu_data(&core->cu_data_best[log2_cuw - 2][log2_cuh - 2], &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2]);
                     cost_best = cost_temp_dqp;
                     best_split_mode = NO_SPLIT;
-                    SBAC_STORE(s_temp_depth, core->s_next_best[log2_cuw - 2][log2_cuh - 2]);
+                    /* the last QP candidate is not overwritten by the split test
+                       which uses smaller CU sizes only, so it is referenced */
+                    if(dqp == max_qp)
+                    {
+                        s_best_next = &core->s_next_best[log2_cuw - 2][log2_cuh - 2];
+                    }
+                    else
+                    {
+                        SBAC_STORE(s_temp_depth, core->s_next_best[log2_cuw - 2][log2_cuh - 2]);
+                        s_best_next = &s_temp_depth;
+                    }
                     DQP_STORE(dqp_temp_depth, core->dqp_next_best[log2_cuw - 2][log2_cuh - 2]);
                     copy_rec_to_pic(core, x0, y0, cuw, cuh, PIC_CURR(ctx), ctx->sps.chroma_format_idc);
                 }
@@ -991,7 +1032,7 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
             int prev_log2_sub_cuh = split_struct.log_cuh[0];
             int is_dqp_set = 0;
 
-            init_cu_data(&core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
+            init_cu_data(core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
             clear_map_scu(ctx, core, x0, y0, cuw, cuh);
             cost_temp = 0.0;
 
@@ -999,9 +1040,9 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
             {
                 SBAC_LOAD(core->s_temp_run, core->s_curr_before_split[log2_cuw - 2][log2_cuh - 2]);
                 eveye_sbac_bit_reset(&core->s_temp_run);
-                evey_set_split_mode(split_mode, cud, 0, cuw, cuh, cuw, core->cu_data_temp[log2_cuw - 2][log2_cuh - 2].split_mode);                
+                evey_set_split_mode(split_mode, cud, 0, cuw, cuh, cuw, core->cu_data_temp[log2_cuw - 2][log2_cuh - 2]->split_mode);                
                 eveye_eco_split_mode(&core->bs_temp, ctx, core, cud, 0, cuw, cuh, cuw); /* split_cu_flag */
-                bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+                bit_cnt = eveye_get_bit_number(core);
                 cost_temp += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
                 SBAC_STORE(core->s_curr_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_run);
             }
@@ -1024,7 +1065,7 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
                 }
 
                 cost_temp_dqp = cost_temp;
-                init_cu_data(&core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
+                init_cu_data(core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], log2_cuw, log2_cuh, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
                 clear_map_scu(ctx, core, x0, y0, cuw, cuh);
 
 #if TRACE_ENC_CU_DATA_CHECK
@@ -1058,7 +1099,7 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
 
                         core->qp = GET_QP((s8)qp, dqp - (s8)qp);
 
-                        copy_cu_data(&core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], &core->cu_data_best[log2_sub_cuw - 2][log2_sub_cuh - 2], x_pos - split_struct.x_pos[0], y_pos - split_struct.y_pos[0], log2_sub_cuw, log2_sub_cuh, log2_cuw, cud, ctx->sps.chroma_format_idc);
+                        copy_cu_data(core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], core->cu_data_best[log2_sub_cuw - 2][log2_sub_cuh - 2], x_pos - split_struct.x_pos[0], y_pos - split_struct.y_pos[0], log2_sub_cuw, log2_sub_cuh, log2_cuw, cud, ctx->sps.chroma_format_idc);
                         update_map_scu(ctx, core, x_pos, y_pos, cur_cuw, cur_cuh);
                         prev_log2_sub_cuw = log2_sub_cuw;
                         prev_log2_sub_cuh = log2_sub_cuh;
@@ -1084,7 +1125,7 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
                 static int counter_out = 0;
                 counter_out++;
                 {
-                    EVEYE_CU_DATA *cu_data = &(core->cu_data_temp[log2_cuw - 2][log2_cuh - 2]);
+                    EVEYE_CU_DATA *cu_data = core->cu_data_temp[log2_cuw - 2][log2_cuh - 2];
                     int cuw = 1 << (log2_cuw - MIN_CU_LOG2);
                     int cuh = 1 << (log2_cuh - MIN_CU_LOG2);
                     int cus = cuw;
@@ -1110,12 +1151,14 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
                 if(cost_best > cost_temp_dqp)
                 {
                     /* backup the current best data */
-                    copy_cu_data(&core->cu_data_best[log2_cuw - 2][log2_cuh - 2], &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2], 0, 0, log2_cuw, log2_cuh, log2_cuw, cud, ctx->sps.chroma_format_idc);
+                    swap_cu_data(&core->cu_data_best[log2_cuw - 2][log2_cuh - 2], &core->cu_data_temp[log2_cuw - 2][log2_cuh - 2]);
 
                     cost_best = cost_temp_dqp;
                     best_dqp = core->dqp_data[prev_log2_sub_cuw - 2][prev_log2_sub_cuh - 2].prev_qp;
                     DQP_STORE(dqp_temp_depth, core->dqp_next_best[prev_log2_sub_cuw - 2][prev_log2_sub_cuh - 2]);
+                    /* later split modes may recurse into the same sub-CU size */
                     SBAC_STORE(s_temp_depth, core->s_next_best[prev_log2_sub_cuw - 2][prev_log2_sub_cuh - 2]);
+                    s_best_next = &s_temp_depth;
                     best_split_mode = split_mode;
                 }
             }
@@ -1126,13 +1169,16 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
     copy_rec_to_pic(core, x0, y0, cuw, cuh, PIC_CURR(ctx), ctx->sps.chroma_format_idc);
 
     /* set best split mode */
-    evey_set_split_mode(best_split_mode, cud, 0, cuw, cuh, cuw, core->cu_data_best[log2_cuw - 2][log2_cuh - 2].split_mode);
-
-    SBAC_LOAD(core->s_next_best[log2_cuw - 2][log2_cuh - 2], s_temp_depth);
-    DQP_LOAD(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], dqp_temp_depth);
+    evey_set_split_mode(best_split_mode, cud, 0, cuw, cuh, cuw, core->cu_data_best[log2_cuw - 2][log2_cuh - 2]->split_mode);
 
     evey_assert(cost_best != MAX_COST);
 
+    if(s_best_next != &core->s_next_best[log2_cuw - 2][log2_cuh - 2])
+    {
+        SBAC_LOAD(core->s_next_best[log2_cuw - 2][log2_cuh - 2], *s_best_next);
+    }
+    DQP_LOAD(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], dqp_temp_depth);
+
 #if TRACE_ENC_CU_DATA_CHECK
     int i, j, w, h, w_scu;
     w = 1 << (core->log2_cuw - MIN_CU_LOG2);
@@ -1145,7 +1191,7 @@ static double mode_coding_tree(EVEYE_CTX * ctx, EVEYE_CORE * core, int x0, int y
         {
             int x_pos = core->x_pel + (i << MIN_CU_LOG2);
             if (x_pos < ctx->w && y_pos < ctx->h)
-                evey_assert(core->cu_data_best[log2_cuw - 2][log2_cuh - 2].trace_idx[i + j * w_scu] != 0);
+                evey_assert(core->cu_data_best[log2_cuw - 2][log2_cuh - 2]->trace_idx[i + j * w_scu] != 0);
         }
     }
 #endif
@@ -1184,7 +1230,7 @@ static void update_to_ctx_map(EVEYE_CTX * ctx, EVEYE_CORE * core)
     s16          (* map_mv)[LIST_NUM][MV_D];
     s8            * map_ipm;
 
-    cu_data = &core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2];
+    cu_data = core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2];
     cuw = ctx->ctu_size;
     cuh = ctx->ctu_size;
     x = core->x_pel;
@@ -1205,7 +1251,7 @@ static void update_to_ctx_map(EVEYE_CTX * ctx, EVEYE_CORE * core)
 
     /* copy mode info */
     core_idx = 0;
-    ctx_idx = PEL2SCU(y) * ctx->w_scu + PEL2SCU(x);
+    ctx_idx = SCU_IDX(PEL2SCU(x), PEL2SCU(y), ctx->w_scu);
 
     map_ipm = ctx->map_ipm;
     map_refi = ctx->map_refi;
@@ -1233,15 +1279,15 @@ static void update_to_ctx_map(EVEYE_CTX * ctx, EVEYE_CORE * core)
                 map_mv[ctx_idx + j][LIST_1][MV_Y] = cu_data->mv[core_idx + j][LIST_1][MV_Y];
             }
         }
-        ctx_idx += ctx->w_scu;
+        ctx_idx += SCU_STRIDE(ctx->w_scu);
         core_idx += (ctx->ctu_size >> MIN_CU_LOG2);
     }
 
     update_map_scu(ctx, core, core->x_pel, core->y_pel, ctx->ctu_size, ctx->ctu_size);
-    copy_cu_data(&ctx->map_cu_data[core->ctu_num], &core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2],
-                 0, 0, ctx->log2_ctu_size, ctx->log2_ctu_size, ctx->log2_ctu_size, 0, ctx->sps.chroma_format_idc);
+    /* the CTU map takes over the best buffers of the CTU */
+    swap_cu_data(&ctx->map_cu_data[core->ctu_num], &core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2]);
     /* copy split flags from the CTU map to the picture map */
-    evey_mcpy(ctx->map_split[core->ctu_num], ctx->map_cu_data[core->ctu_num].split_mode, sizeof(s8) * NUM_CU_DEPTH * NUM_BLOCK_SHAPE * MAX_CU_CNT_IN_CTU);
+    evey_mcpy(ctx->map_split[core->ctu_num], ctx->map_cu_data[core->ctu_num]->split_mode, sizeof(s8) * NUM_CU_DEPTH * NUM_BLOCK_SHAPE * MAX_CU_CNT_IN_CTU);
 }
 
 /* entry point for CTU level decision */
@@ -1251,8 +1297,8 @@ static int mode_analyze_ctu(EVEYE_CTX * ctx, EVEYE_CORE * core)
     int   i, j, w, h;
 
     /* initialize cu data */
-    init_cu_data(&core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], ctx->log2_ctu_size, ctx->log2_ctu_size, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
-    init_cu_data(&core->cu_data_temp[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], ctx->log2_ctu_size, ctx->log2_ctu_size, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
+    init_cu_data(core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], ctx->log2_ctu_size, ctx->log2_ctu_size, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
+    init_cu_data(core->cu_data_temp[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2], ctx->log2_ctu_size, ctx->log2_ctu_size, ctx->sh.qp, ctx->sh.qp, ctx->sh.qp);
 
     /* determine split mode */
     mode_coding_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->log2_ctu_size, ctx->log2_ctu_size, 0, ctx->sh.qp);
@@ -1263,7 +1309,7 @@ static int mode_analyze_ctu(EVEYE_CTX * ctx, EVEYE_CORE * core)
     /* reset coded flags for the current ctu */
     core->x_scu = PEL2SCU(core->x_pel);
     core->y_scu = PEL2SCU(core->y_pel);
-    map_scu = ctx->map_scu + ((u32)core->y_scu * ctx->w_scu) + core->x_scu;
+    map_scu = ctx->map_scu + SCU_IDX(core->x_scu, core->y_scu, ctx->w_scu);
     w = EVEY_MIN(1 << (ctx->log2_ctu_size - MIN_CU_LOG2), ctx->w_scu - core->x_scu);
     h = EVEY_MIN(1 << (ctx->log2_ctu_size - MIN_CU_LOG2), ctx->h_scu - core->y_scu);
 
@@ -1273,7 +1319,7 @@ static int mode_analyze_ctu(EVEYE_CTX * ctx, EVEYE_CORE * core)
         {
             MCU_CLR_COD(map_scu[j]);
         }
-        map_scu += ctx->w_scu;
+        map_scu += SCU_STRIDE(ctx->w_scu);
     }
 
 #if TRACE_ENC_CU_DATA_CHECK
@@ -1285,7 +1331,7 @@ static int mode_analyze_ctu(EVEYE_CTX * ctx, EVEYE_CORE * core)
         {
             int x_pos = core->x_pel + (i << MIN_CU_LOG2);
             if(x_pos < ctx->w && y_pos < ctx->h)
-                evey_assert(core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2].trace_idx[i + h * j] != 0);
+                evey_assert(core->cu_data_best[ctx->log2_ctu_size - 2][ctx->log2_ctu_size - 2]->trace_idx[i + h * j] != 0);
         }
     }
     for(j = 0; j < h; ++j)
@@ -1295,7 +1341,7 @@ static int mode_analyze_ctu(EVEYE_CTX * ctx, EVEYE_CORE * core)
         {
             int x_pos = core->x_pel + (i << MIN_CU_LOG2);
             if(x_pos < ctx->w && y_pos < ctx->h)
-                evey_assert(ctx->map_cu_data[core->ctu_num].trace_idx[i + h * j] != 0);
+                evey_assert(ctx->map_cu_data[core->ctu_num]->trace_idx[i + h * j] != 0);
         }
     }
 #endif
@@ -1333,6 +1379,10 @@ static int mode_set_complexity(EVEYE_CTX * ctx, int complexity)
 {
     EVEYE_MODE * mi = &ctx->mode;
     evey_assert_rv(mi != NULL, EVEY_ERR_UNEXPECTED);
+
+    mi->complexity = complexity;
+    mi->rate_est = complexity > 0 ? RATE_EST_TABLE : RATE_EST_SBAC;
+
     return EVEY_OK;
 }
 
@@ -1387,7 +1437,7 @@ void eveye_calc_delta_dist_filter_boundary(EVEYE_CTX * ctx, EVEYE_CORE * core, p
     pel      * org_v = pic_org->v + (y >> h_shift) * s_c_org + (x >> w_shift);
     int        x_scu = PEL2SCU(x);
     int        y_scu = PEL2SCU(y);
-    int        t = x_scu + y_scu * ctx->w_scu;
+    int        t = SCU_IDX(x_scu, y_scu, ctx->w_scu);
     /* cu info to save */
     u8         intra_flag_save, cbf_l_save;
     u8         do_filter = 0;
@@ -1565,7 +1615,7 @@ void eveye_calc_delta_dist_filter_boundary(EVEYE_CTX * ctx, EVEYE_CORE * core, p
         /* set map info of current cu to current mode */
         for(j = 0; j < h_scu; j++)
         {
-            ind = (y_scu + j) * ctx->w_scu + x_scu;
+            ind = SCU_IDX(x_scu, y_scu + j, ctx->w_scu);
             for(i = 0; i < w_scu; i++)
             {
                 k = ind + i;
@@ -1619,7 +1669,7 @@ void eveye_calc_delta_dist_filter_boundary(EVEYE_CTX * ctx, EVEYE_CORE * core, p
         /* clean coded flag in between two directional filtering (not necessary here) */
         for(j = 0; j < h_scu; j++)
         {
-            ind = (y_scu + j) * ctx->w_scu + x_scu;
+            ind = SCU_IDX(x_scu, y_scu + j, ctx->w_scu);
             for(i = 0; i < w_scu; i++)
             {
                 k = ind + i;
@@ -1633,7 +1683,7 @@ void eveye_calc_delta_dist_filter_boundary(EVEYE_CTX * ctx, EVEYE_CORE * core, p
         /* recover best cu info */
         for(j = 0; j < h_scu; j++)
         {
-            ind = (y_scu + j) * ctx->w_scu + x_scu;
+            ind = SCU_IDX(x_scu, y_scu + j, ctx->w_scu);
             for(i = 0; i < w_scu; i++)
             {
                 k = ind + i;
@@ -47,7 +47,9 @@ void eveye_rdo_bit_cnt_cu_inter_comp(EVEYE_CTX * ctx, EVEYE_CORE * core, s16 coe
 void eveye_rdo_bit_cnt_cu_skip(EVEYE_CTX * ctx, EVEYE_CORE * core, int mvp_idx0, int mvp_idx1, int c_num);
 void eveye_rdo_bit_cnt_mvp(EVEYE_CTX * ctx, EVEYE_CORE * core, s8 refi[LIST_NUM], s16 mvd[LIST_NUM][MV_D], int pidx, int mvp_idx);
 void eveye_sbac_bit_reset(EVEYE_SBAC * sbac);
-u32  eveye_get_bit_number(EVEYE_SBAC * sbac);
+u32  eveye_get_bit_number(EVEYE_CORE * core);
+/* fractional bits of a bin by its probability in 1/1024 unit */
+extern s32 eveye_entropy_bits[1024];
 void eveye_init_bits_est();
 void eveye_calc_delta_dist_filter_boundary(EVEYE_CTX * ctx, EVEYE_CORE * core, pel (*src)[MAX_CU_DIM], int s_src, int x, int y, u8 intra_flag, u8 cbf_l, s8 * refi, s16 (*mv)[MV_D], u8 is_mv_from_mvf);
 
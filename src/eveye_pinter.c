@@ -173,6 +173,7 @@ static u32 me_raster(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh
             
             /* get sad */
             cost += eveye_sad_16b(log2_cuw, log2_cuh, org, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
+            pi->cnt->me_pts++;
 
             /* check if motion cost_best is less than minimum cost_best */
             if(cost < cost_best)
@@ -215,6 +216,7 @@ static u32 me_raster(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh
 
                 /* get sad */
                 cost += eveye_sad_16b(log2_cuw, log2_cuh, org, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
+                pi->cnt->me_pts++;
 
                 /* check if motion cost_best is less than minimum cost_best */
                 if(cost < cost_best)
@@ -292,6 +294,7 @@ static u32 me_ipel_refinement(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int
             cost = MV_COST(pi, mv_bits);
 
             ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
+            pi->cnt->me_pts++;
             if (bi)
             {
                 /* get sad */
@@ -395,6 +398,7 @@ static u32 me_ipel_diamond(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int lo
 
                         ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
 
+                        pi->cnt->me_pts++;
                         if(bi)
                         {
                             /* get sad */
@@ -467,6 +471,7 @@ static u32 me_ipel_diamond(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int lo
                     cost = MV_COST(pi, mv_bits);
 
                     ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
+                    pi->cnt->me_pts++;
                     if(bi)
                     {
                         /* get sad */
@@ -569,6 +574,7 @@ static u32 me_spel_pattern(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int lo
         /* get the interpolated(predicted) image */
         evey_mc_l((mv_x << 2), (mv_y << 2), ref, (mv_x << 2), (mv_y << 2), s_ref, cuw, pred, cuw, cuh, bit_depth_luma);
 
+        pi->cnt->me_pts++;
         if(bi)
         {
             /* get sad */
@@ -616,6 +622,7 @@ static u32 me_spel_pattern(EVEYE_PINTER * pi, int x, int y, int log2_cuw, int lo
             /* get the interpolated(predicted) image */
             evey_mc_l((mv_x << 2), (mv_y << 2), ref, (mv_x << 2), (mv_y << 2), s_ref, cuw, pred, cuw, cuh, bit_depth_luma);
 
+            pi->cnt->me_pts++;
             if(bi)
             {
                 /* get sad */
@@ -859,7 +866,7 @@ static void check_best_mvp(EVEYE_CTX * ctx, EVEYE_CORE * core, s32 slice_type, s
         mvd_tmp[lidx][MV_Y] = mv[MV_Y] - mvp[idx][MV_Y];
 
         eveye_rdo_bit_cnt_mvp(ctx, core, refi, mvd_tmp, pidx, idx);
-        bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+        bit_cnt = eveye_get_bit_number(core);
         cost = RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
         if(cost < best_cost)
         {
@@ -1028,7 +1035,7 @@ static double pinter_residue_rdo(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
 
             eveye_rdo_bit_cnt_cu_inter(ctx, core, pi->refi[pidx], pi->mvd[pidx], coef, pidx, mvp_idx);
 
-            bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+            bit_cnt = eveye_get_bit_number(core);
             cost += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
 
             if(cost < cost_best)
@@ -1060,7 +1067,7 @@ static double pinter_residue_rdo(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
 
         eveye_rdo_bit_cnt_cu_inter(ctx, core, pi->refi[pidx], pi->mvd[pidx], coef, pidx, mvp_idx);
 
-        bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+        bit_cnt = eveye_get_bit_number(core);
         cost += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
 
         if(cost < cost_best)
@@ -1097,7 +1104,7 @@ static double pinter_residue_rdo(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
                     SBAC_LOAD(core->s_temp_run, core->s_temp_prev_comp_run);
                     eveye_sbac_bit_reset(&core->s_temp_run);
                     eveye_rdo_bit_cnt_cu_inter_comp(ctx, core, coef, i, pidx);
-                    bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+                    bit_cnt = eveye_get_bit_number(core);
                     cost += RATE_TO_COST_LAMBDA(ctx->lambda[i], bit_cnt);
                     if(cost < cost_comp_best)
                     {
@@ -1145,7 +1152,7 @@ static double pinter_residue_rdo(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
 
             eveye_rdo_bit_cnt_cu_inter(ctx, core, pi->refi[pidx], pi->mvd[pidx], coef, pidx, mvp_idx);
 
-            bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+            bit_cnt = eveye_get_bit_number(core);
             cost += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
 
             if(cost < cost_best)
@@ -1217,7 +1224,7 @@ static double pinter_residue_rdo(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
         eveye_sbac_bit_reset(&core->s_temp_run);
         eveye_rdo_bit_cnt_cu_inter(ctx, core, pi->refi[pidx], pi->mvd[pidx], coef, pidx, mvp_idx);
 
-        bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+        bit_cnt = eveye_get_bit_number(core);
         cost_best += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
         SBAC_STORE(core->s_temp_best, core->s_temp_run);
         DQP_STORE(core->dqp_temp_best, core->dqp_temp_run);
@@ -1333,7 +1340,7 @@ static double analyze_skip_mode(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
 
             eveye_rdo_bit_cnt_cu_skip(ctx, core, idx0, idx1, 0);
 
-            bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+            bit_cnt = eveye_get_bit_number(core);
             cost += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
 
             if(cost < cost_best)
@@ -1468,6 +1475,7 @@ static double analyze_inter_mode(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
     int            pidx, pidx_ref, pidx_cnd, i;
     u32            best_mecost = EVEY_UINT32_MAX;
     u32            mecost;
+    s64            t_me;
     double         cost;
     double         cost_best = MAX_COST;
 
@@ -1487,7 +1495,10 @@ static double analyze_inter_mode(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
             mvp_idx = pi->mvp_idx[PRED_SKIP][lidx];
 
             /* motion estimation */
+            t_me = evey_time_ns();
             mecost = pi->fn_me(pi, x, y, log2_cuw, log2_cuh, &refi_cur, lidx, pi->mvp_scale[lidx][refi_cur][mvp_idx], pi->mv[pidx][lidx], 0, ctx->sps.bit_depth_luma_minus8 + 8);
+            ctx->stage_ns[EVEYE_STAGE_ME] += evey_time_ns() - t_me;
+            pi->cnt->me++;
 
             pi->mv_scale[lidx][refi_cur][MV_X] = pi->mv[pidx][lidx][MV_X];
             pi->mv_scale[lidx][refi_cur][MV_Y] = pi->mv[pidx][lidx][MV_Y];
@@ -1606,7 +1617,10 @@ static double analyze_inter_mode(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int
             for(refi_cur = 0; refi_cur < pi->num_refp; refi_cur++)
             {
                 refi[lidx_ref] = refi_cur;
+                t_me = evey_time_ns();
                 mecost = pi->fn_me(pi, x, y, log2_cuw, log2_cuh, &refi[lidx_ref], lidx_ref, pi->mvp[lidx_ref][mvp_idx], pi->mv_scale[lidx_ref][refi_cur], 1, ctx->sps.bit_depth_luma_minus8 + 8);
+                ctx->stage_ns[EVEYE_STAGE_ME] += evey_time_ns() - t_me;
+                pi->cnt->me++;
                 if(mecost < best_mecost)
                 {
                     refi_best = refi_cur;
@@ -1763,6 +1777,7 @@ static int pinter_init_ctu(EVEYE_CTX * ctx, EVEYE_CORE * core)
     pi->lambda_mv = (u32)floor(65536.0 * ctx->sqrt_lambda[0]);
     pi->poc = ctx->poc.poc_val;
     pi->gop_size = ctx->param.gop_size;
+    pi->cnt = &core->cnt;
 
     return EVEY_OK;
 }
@@ -81,7 +81,7 @@ static double pintra_residue_rdo(EVEYE_CTX * ctx, EVEYE_CORE * core, s32 * dist,
         DQP_LOAD(core->dqp_temp_run, core->dqp_curr_best[log2_cuw - 2][log2_cuh - 2]);
         eveye_sbac_bit_reset(&core->s_temp_run);
         eveye_rdo_bit_cnt_cu_intra_luma(ctx, core, core->coef);
-        bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+        bit_cnt = eveye_get_bit_number(core);
         cost += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
     }
     else if(mode == 1) /* chroma */
@@ -130,7 +130,7 @@ static double pintra_residue_rdo(EVEYE_CTX * ctx, EVEYE_CORE * core, s32 * dist,
         /* calculate bit cost */
         eveye_sbac_bit_reset(&core->s_temp_run);
         eveye_rdo_bit_cnt_cu_intra_chroma(ctx, core, core->coef);
-        bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+        bit_cnt = eveye_get_bit_number(core);
         cost += RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
     }
     else
@@ -182,7 +182,7 @@ static int get_ipred_cand_list(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y,
         SBAC_LOAD(core->s_temp_run, core->s_curr_best[core->log2_cuw - 2][core->log2_cuh - 2]);
         eveye_sbac_bit_reset(&core->s_temp_run);
         eveye_eco_intra_dir(&core->bs_temp, i, core->mpm_b_list); /* count intra mode bits */
-        bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+        bit_cnt = eveye_get_bit_number(core);
         cost += RATE_TO_COST_SQRT_LAMBDA(ctx->sqrt_lambda[0], bit_cnt); /* calculate bit cost */
 
         /* sorting */
@@ -325,7 +325,7 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
             int   s_pic = (*pi_ctx)->s_l; // stride of pi_ctx
         
             /* NN_CONTEXT_SIZE x NN_CONTEXT_SIZE "DP" input for the server*/
-            pel *sent16bpp = (pel*)malloc(sizeof(pel) * NN_CONTEXT_SIZE * NN_CONTEXT_SIZE); //DP format
+            pel *sent16bpp = (pel*)evey_malloc(sizeof(pel) * NN_CONTEXT_SIZE * NN_CONTEXT_SIZE); //DP format
             memset(sent16bpp, 0, sizeof(pel) * NN_CONTEXT_SIZE * NN_CONTEXT_SIZE);
             
             /* Copying the context in the DP block allocated above and then the predictor as well */
@@ -340,12 +340,14 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
             NN_savePredictor("sent16bpp.yuv", sent16bpp, NN_CONTEXT_SIZE, NN_CONTEXT_SIZE, NN_CONTEXT_SIZE, true);
             
             /* We send the context + predictor in DP format to the server listening at port base_port + cuw to support distinct severs */
+            s64 t_nn = evey_time_ns();
             NN_sendTo16(sent16bpp, sizeof(Pel) * NN_CONTEXT_SIZE * NN_CONTEXT_SIZE, cuw);  //send DP context
-            free(sent16bpp);
+            evey_mfree(sent16bpp);
             
             /* We wait for the server to send back the new predictor and we store in rcvd16bpp as an array of Pel */
             Pel *rcvd16bpp;
             int nRcvdcBytes = NN_recvFrom16(&rcvd16bpp);
+            ctx->stage_ns[EVEYE_STAGE_NN] += evey_time_ns() - t_nn;
             if (nRcvdcBytes != cuw * cuh * sizeof(Pel)) {
                 printf("WARNING received %d rather than %d bytes\n", nRcvdcBytes, (int)(cuw * cuh * sizeof(Pel)));
             }
@@ -354,7 +356,7 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
             /* In "Oracle" mode, we replace the EVC predictor with the NN predictor if the latter has lower rate */
             float cost_evc = pintra_residue_rdo(ctx, core, &dist_t, 0, x, y);
             // We store a copy of the orginal predictor ...
-            pel *backupPredEVC = (pel*)malloc(sizeof(pel) * cuw * cuw); //DP format
+            pel *backupPredEVC = (pel*)evey_malloc(sizeof(pel) * cuw * cuw); //DP format
             evey_mcpy(backupPredEVC, pi->pred_cache[core->ipm[0]], sizeof(pel) * cuw * cuh);
             // ... since pintra_residue_rdo() requires us to temporarily overwite it ...
             evey_mcpy(pi->pred_cache[core->ipm[0]], rcvd16bpp, sizeof(pel) * cuw * cuh);
@@ -363,7 +365,7 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
             if (NN_ORACLE && cost_nn > cost_evc) {
                 evey_mcpy(pi->pred_cache[core->ipm[0]], backupPredEVC, sizeof(pel) * cuw * cuh);
             }
-            free(backupPredEVC);
+            evey_mfree(backupPredEVC);
             
             free(rcvd16bpp);
             printf("x %d y %d cuw %d cuy %d type %d COST_EVC %.0f COST_NN %.0f\n", x, y, cuw, cuh, i, cost_evc, cost_nn);
@@ -372,6 +374,7 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
 //        printf("x %d y %d cuw %d cuh %d type %d\n", x, y, cuw, cuh, j);
         /* RD cost for luma */
         cost_t = pintra_residue_rdo(ctx, core, &dist_t, 0, x, y);
+        core->cnt.intra_rdo[i]++;
 
 #if TRACE_COSTS
         EVEY_TRACE_COUNTER;
@@ -393,7 +396,6 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
             evey_mcpy(pi->rec_best[Y_C], pi->rec[Y_C], (cuw * cuh) * sizeof(pel));            
             evey_mcpy(pi->nnz_sub_best[Y_C], core->nnz_sub[Y_C], sizeof(int) * MAX_SUB_TB_NUM);
             pi->nnz_best[Y_C] = core->nnz[Y_C];
-            SBAC_STORE(core->s_temp_prev_comp_best, core->s_temp_run);
         }
     } // end for() loop over the modes
     
@@ -452,7 +454,7 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
     DQP_STORE(core->dqp_temp_run, core->dqp_curr_best[core->log2_cuw - 2][core->log2_cuh - 2]);
     eveye_sbac_bit_reset(&core->s_temp_run);
     eveye_rdo_bit_cnt_cu_intra(ctx, core, core->coef);
-    bit_cnt = eveye_get_bit_number(&core->s_temp_run);
+    bit_cnt = eveye_get_bit_number(core);
     cost = RATE_TO_COST_LAMBDA(ctx->lambda[0], bit_cnt);
 
     core->dist_cu = 0;
@@ -467,9 +469,6 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
         core->dist_cu += best_dist_c;
     }
 
-    SBAC_STORE(core->s_temp_best, core->s_temp_run);
-    DQP_STORE(core->dqp_temp_best, core->dqp_temp_run);
-
     if(cost < core->cost_best)
     {
         core->dist_cu_best = core->dist_cu;
@@ -481,8 +480,9 @@ static double pintra_analyze_cu(EVEYE_CTX * ctx, EVEYE_CORE * core, int x, int y
         mi->nnz = pi->nnz_best;
         mi->nnz_sub = pi->nnz_sub_best;
 
-        SBAC_STORE(core->s_next_best[core->log2_cuw - 2][core->log2_cuh - 2], core->s_temp_best);
-        DQP_STORE(core->dqp_next_best[core->log2_cuw - 2][core->log2_cuh - 2], core->dqp_temp_best);
+        /* s_temp_run is not used any more, so it is stored without a temporary copy */
+        SBAC_STORE(core->s_next_best[core->log2_cuw - 2][core->log2_cuh - 2], core->s_temp_run);
+        DQP_STORE(core->dqp_next_best[core->log2_cuw - 2][core->log2_cuh - 2], core->dqp_temp_run);
     }
 
     /* return intra best cost */
@@ -0,0 +1,299 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "eveye_def.h"
+#include <math.h>
+
+/* scales of MS-SSIM and their weights, finest first */
+#define QM_MS_SCALE_NUM            5
+static const double qm_ms_weight[QM_MS_SCALE_NUM] = {0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+
+s64 eveye_sse_plane_c(pel * org, pel * rec, int s_org, int s_rec, int w, int h)
+{
+    s64 sse = 0;
+    int i, j, d;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            d = org[j] - rec[j];
+            sse += d * d;
+        }
+        org += s_org;
+        rec += s_rec;
+    }
+    return sse;
+}
+
+void eveye_ssim_4x4_c(pel * org, pel * rec, int s_org, int s_rec, int n, int (*sum)[4])
+{
+    int i, j, k, a, b;
+
+    for(k = 0; k < n; k++)
+    {
+        sum[k][0] = sum[k][1] = sum[k][2] = sum[k][3] = 0;
+        for(i = 0; i < 4; i++)
+        {
+            for(j = 0; j < 4; j++)
+            {
+                a = org[i * s_org + j];
+                b = rec[i * s_rec + j];
+                sum[k][0] += a;
+                sum[k][1] += b;
+                sum[k][2] += a * a + b * b;
+                sum[k][3] += a * b;
+            }
+        }
+        org += 4;
+        rec += 4;
+    }
+}
+
+/* N-bit PSNR of JVET, as computed by the encoder application */
+static double qm_psnr(s64 sse, int w, int h, int bit_depth)
+{
+    double mse = (double)sse / ((double)w * h);
+    double factor = (double)(1 << (bit_depth - 8));
+
+    return (mse == 0.0) ? 100. : fabs(10 * log10(255 * 255 * factor * factor / mse));
+}
+
+/* mean SSIM of the 8x8 windows at a step of 4 of a plane, made of 2x2 of
+   the 4x4 block sums; the mean of the contrast-structure term goes to cs */
+static double qm_ssim(EVEYE_QM_JOB * job, pel * org, pel * rec, int s_org, int s_rec, int w, int h, double * cs)
+{
+    int   (*sum0)[4] = job->ssim_sum;
+    int   (*sum1)[4] = job->ssim_sum + job->ssim_sum_w;
+    int   (*t)[4];
+    int    bw = w >> 2, bh = h >> 2, x, y, k;
+    double max = (double)((1 << job->bit_depth) - 1);
+    /* constants of the sums over 64 samples, with the unbiased variance */
+    double c1 = .01 * .01 * max * max * 64 * 64;
+    double c2 = .03 * .03 * max * max * 64 * 63;
+    double s[4], vars, covar, c, sum_ssim = 0, sum_cs = 0;
+
+    if(bw < 2 || bh < 2)
+    {
+        *cs = 1.0;
+        return 1.0;
+    }
+
+    for(y = 0; y < bh; y++)
+    {
+        eveye_kfn.ssim_4x4(org + 4 * y * s_org, rec + 4 * y * s_rec, s_org, s_rec, bw, sum1);
+        for(x = 0; y > 0 && x < bw - 1; x++)
+        {
+            for(k = 0; k < 4; k++)
+            {
+                s[k] = (double)sum0[x][k] + sum0[x + 1][k] + sum1[x][k] + sum1[x + 1][k];
+            }
+            vars = s[2] * 64 - s[0] * s[0] - s[1] * s[1];
+            covar = s[3] * 64 - s[0] * s[1];
+            c = (2 * covar + c2) / (vars + c2);
+            sum_ssim += c * (2 * s[0] * s[1] + c1) / (s[0] * s[0] + s[1] * s[1] + c1);
+            sum_cs += c;
+        }
+        t = sum0;
+        sum0 = sum1;
+        sum1 = t;
+    }
+
+    *cs = sum_cs / ((bw - 1) * (bh - 1));
+    return sum_ssim / ((bw - 1) * (bh - 1));
+}
+
+/* 2x2 average; dst may be src, as each output is written behind the
+   samples still to be read */
+static void qm_down2(pel * src, int s_src, pel * dst, int w, int h)
+{
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            dst[j] = (pel)((src[2 * j] + src[2 * j + 1] + src[s_src + 2 * j] + src[s_src + 2 * j + 1] + 2) >> 2);
+        }
+        src += s_src << 1;
+        dst += w;
+    }
+}
+
+/* MS-SSIM of luma with the SSIM windows at each scale; a picture too small
+   for all scales ends at its coarsest one */
+static double qm_ms_ssim(EVEYE_QM_JOB * job)
+{
+    pel  * org = job->org.y;
+    pel  * rec = job->rec.y;
+    int    s_org = job->org.s_l;
+    int    s_rec = job->rec.s_l;
+    int    w = job->org.w_l;
+    int    h = job->org.h_l;
+    int    i;
+    double ssim, cs, ms = 1.0;
+
+    for(i = 0; i < QM_MS_SCALE_NUM; i++)
+    {
+        ssim = qm_ssim(job, org, rec, s_org, s_rec, w, h, &cs);
+        if(i == QM_MS_SCALE_NUM - 1 || (w >> 1) < 8 || (h >> 1) < 8)
+        {
+            return ms * pow(EVEY_MAX(ssim, 0.0), qm_ms_weight[i]);
+        }
+        ms *= pow(EVEY_MAX(cs, 0.0), qm_ms_weight[i]);
+
+        w >>= 1;
+        h >>= 1;
+        qm_down2(org, s_org, job->ms_org, w, h);
+        qm_down2(rec, s_rec, job->ms_rec, w, h);
+        org = job->ms_org;
+        rec = job->ms_rec;
+        s_org = s_rec = w;
+    }
+    return ms;
+}
+
+static int qm_run(void * arg)
+{
+    EVEYE_QM_JOB * job = (EVEYE_QM_JOB *)arg;
+    EVEYE_QM     * qm = &job->qm;
+    pel          * org[3] = {job->org.y, job->org.u, job->org.v};
+    pel          * rec[3] = {job->rec.y, job->rec.u, job->rec.v};
+    int            i, w, h, s_org, s_rec;
+    double         cs;
+
+    for(i = 0; i < job->np; i++)
+    {
+        w = i ? job->org.w_c : job->org.w_l;
+        h = i ? job->org.h_c : job->org.h_l;
+        s_org = i ? job->org.s_c : job->org.s_l;
+        s_rec = i ? job->rec.s_c : job->rec.s_l;
+
+        if(qm->metric & EVEYE_QM_PSNR)
+        {
+            qm->psnr[i] = qm_psnr(eveye_kfn.sse_plane(org[i], rec[i], s_org, s_rec, w, h), w, h, job->bit_depth);
+        }
+        if(qm->metric & EVEYE_QM_SSIM)
+        {
+            qm->ssim[i] = qm_ssim(job, org[i], rec[i], s_org, s_rec, w, h, &cs);
+        }
+    }
+    if(qm->metric & EVEYE_QM_MS_SSIM)
+    {
+        qm->ms_ssim = qm_ms_ssim(job);
+    }
+    return EVEY_OK;
+}
+
+int eveye_qm_create(EVEYE_CTX * ctx)
+{
+    EVEYE_QM_JOB * job;
+
+    job = (EVEYE_QM_JOB *)evey_arena_alloc(&ctx->arena, sizeof(EVEYE_QM_JOB));
+    evey_assert_rv(job != NULL, EVEY_ERR_OUT_OF_MEMORY);
+    evey_mset(job, 0, sizeof(EVEYE_QM_JOB));
+
+    /* luma has the most 4x4 blocks in a row */
+    job->ssim_sum_w = ctx->w >> 2;
+    job->ssim_sum = (int (*)[4])evey_arena_alloc(&ctx->arena, sizeof(int) * 4 * 2 * (job->ssim_sum_w + 1));
+    evey_assert_rv(job->ssim_sum != NULL, EVEY_ERR_OUT_OF_MEMORY);
+
+    if(ctx->cdsc.quality_metric & EVEYE_QM_MS_SSIM)
+    {
+        job->ms_org = (pel *)evey_arena_alloc(&ctx->arena, sizeof(pel) * (ctx->w >> 1) * (ctx->h >> 1));
+        job->ms_rec = (pel *)evey_arena_alloc(&ctx->arena, sizeof(pel) * (ctx->w >> 1) * (ctx->h >> 1));
+        evey_assert_rv(job->ms_org != NULL && job->ms_rec != NULL, EVEY_ERR_OUT_OF_MEMORY);
+    }
+
+    ctx->qm_job = job;
+    return EVEY_OK;
+}
+
+void eveye_qm_start(EVEYE_CTX * ctx, EVEYE_STAT * stat)
+{
+    EVEYE_QM_JOB * job = ctx->qm_job;
+
+    eveye_qm_wait(ctx);
+
+    job->org = *PIC_ORIG(ctx);
+    job->rec = *PIC_CURR(ctx);
+    job->imgb_org = PIC_ORIG(ctx)->imgb;
+    job->imgb_rec = PIC_CURR(ctx)->imgb;
+    if(job->imgb_org->addref)
+    {
+        job->imgb_org->addref(job->imgb_org);
+    }
+    job->imgb_rec->addref(job->imgb_rec);
+
+    job->bit_depth = ctx->cdsc.codec_bit_depth;
+    job->np = ctx->param.chroma_format_idc ? 3 : 1;
+    evey_mset(&job->qm, 0, sizeof(EVEYE_QM));
+    job->qm.metric = ctx->cdsc.quality_metric;
+    job->qm.fnum = stat->fnum;
+    job->qm.poc = stat->poc;
+    job->busy = 1;
+
+    /* measured here when no thread can be created */
+    job->thread = evey_thread_create(qm_run, job);
+    if(job->thread == NULL)
+    {
+        qm_run(job);
+    }
+}
+
+void eveye_qm_wait(EVEYE_CTX * ctx)
+{
+    EVEYE_QM_JOB * job = ctx->qm_job;
+
+    if(!job->busy) return;
+
+    if(job->thread)
+    {
+        evey_thread_join(job->thread);
+        job->thread = NULL;
+    }
+    if(job->imgb_org->release)
+    {
+        job->imgb_org->release(job->imgb_org);
+    }
+    job->imgb_rec->release(job->imgb_rec);
+    job->imgb_org = job->imgb_rec = NULL;
+    job->busy = 0;
+}
+
+void eveye_qm_take(EVEYE_CTX * ctx, EVEYE_QM * qm)
+{
+    EVEYE_QM_JOB * job = ctx->qm_job;
+
+    eveye_qm_wait(ctx);
+    *qm = job->qm;
+    job->qm.metric = 0;
+}
@@ -0,0 +1,58 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef _EVEYE_QM_H_
+#define _EVEYE_QM_H_
+
+#include "eveye_def.h"
+
+/* sum of squared errors of a w x h plane */
+typedef s64(*EVEYE_FN_SSE_PLANE)(pel * org, pel * rec, int s_org, int s_rec, int w, int h);
+/* sums of n horizontally adjacent 4x4 blocks for SSIM:
+   sum[0] of org, sum[1] of rec, sum[2] of org^2 + rec^2, sum[3] of org * rec */
+typedef void(*EVEYE_FN_SSIM_4X4)(pel * org, pel * rec, int s_org, int s_rec, int n, int (*sum)[4]);
+
+/* C kernels, registered by eveye_kfn_init_c() */
+s64 eveye_sse_plane_c(pel * org, pel * rec, int s_org, int s_rec, int w, int h);
+void eveye_ssim_4x4_c(pel * org, pel * rec, int s_org, int s_rec, int n, int (*sum)[4]);
+
+/* allocate the job of the quality metrics from the arena of ctx */
+int eveye_qm_create(EVEYE_CTX * ctx);
+/* start measuring the current picture against its original */
+void eveye_qm_start(EVEYE_CTX * ctx, EVEYE_STAT * stat);
+/* wait for the measuring picture and release its buffers; the metrics are
+   kept for eveye_qm_take() */
+void eveye_qm_wait(EVEYE_CTX * ctx);
+/* hand out the metrics of the last measured picture, metric is 0 if there
+   is none */
+void eveye_qm_take(EVEYE_CTX * ctx, EVEYE_QM * qm);
+
+#endif /* _EVEYE_QM_H_ */
@@ -39,23 +39,35 @@ extern "C"
 #include "eveye_def.h"
 
 typedef int(*EVEYE_FN_SAD) (int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
-extern const EVEYE_FN_SAD eveye_tbl_sad_16b[8][8];
 #define eveye_sad_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
-    eveye_tbl_sad_16b[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
+    eveye_kfn.sad[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define eveye_sad_bi_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
-    (eveye_tbl_sad_16b[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
+    (eveye_kfn.sad[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
 
 typedef int(*EVEYE_FN_SATD)(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
-extern const EVEYE_FN_SATD eveye_tbl_satd_16b[8][8];
 #define eveye_satd_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
-    eveye_tbl_satd_16b[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
+    eveye_kfn.satd[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define eveye_satd_bi_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
-    (eveye_tbl_satd_16b[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
+    (eveye_kfn.satd[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
 
 typedef s64(*EVEYE_FN_SSD) (int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
-extern const EVEYE_FN_SSD eveye_tbl_ssd_16b[8][8];
 #define eveye_ssd_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
-    eveye_tbl_ssd_16b[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
+    eveye_kfn.ssd[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
+
+/* hadamard transform of a single block, summed up by evey_had() */
+typedef int(*EVEYE_FN_HAD)(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+
+/* C kernels, registered by eveye_kfn_init_c() */
+int eveye_sad_16b_c(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+s64 eveye_ssd_16b_c(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+int evey_had(int w, int h, void * o, void * c, int s_org, int s_cur, int bit_depth);
+int evey_had_2x2(pel *org, pel *cur, int s_org, int s_cur, int step);
+int evey_had_4x4(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int evey_had_8x8(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int evey_had_16x8(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int evey_had_8x16(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int evey_had_8x4(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int evey_had_4x8(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
 
 #ifdef __cplusplus
 }
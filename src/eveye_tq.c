@@ -496,6 +496,73 @@ static __inline u32 get_coded_level_rl(s64 * rd64_uncoded_cost, s64 * rd64_coded
     return best_abs_level;
 }
 
+/* quantization kernels **********************************************************/
+/* RDOQ pre-pass: quantizes every coefficient of the block to its maximum level,
+   stores the signed level and level_double of each position (raster order) and
+   accumulates the uncoded distortion of the whole block. returns sum of levels */
+int eveye_rdoq_prepass_c(s16 * src_coef, int num_coef, int q_value, int q_bits, s64 err_scale,
+                         s16 * tmp_coef, s32 * tmp_level_double, s64 * block_uncoded_cost)
+{
+    const s64 half = (s64)1 << (q_bits - 1);
+    s64 cost = 0;
+    int sum_all = 0;
+    int i;
+
+    for(i = 0; i < num_coef; i++)
+    {
+        s64 level_double;
+        u32 max_abs_level;
+        s64 err;
+
+        level_double = (int)EVEY_MIN(((s64)EVEY_ABS(src_coef[i]) * (s64)q_value), (s64)EVEY_INT32_MAX - half);
+        max_abs_level = (u32)((level_double + half) >> q_bits);
+
+        err = (level_double * err_scale) >> ERR_SCALE_PRECISION_BITS;
+        cost += err * err;
+
+        tmp_level_double[i] = (s32)level_double;
+        tmp_coef[i] = src_coef[i] > 0 ? (s16)max_abs_level : -(s16)(max_abs_level);
+        sum_all += max_abs_level;
+    }
+
+    *block_uncoded_cost = cost;
+    return sum_all;
+}
+
+/* scalar quantization without RDOQ. returns number of non-zero coefficients */
+int eveye_quant_block_c(s16 * coef, int num_coef, int scale, int ns_scale, s64 offset, int shift)
+{
+    int nnz = 0;
+    int sign;
+    s64 lev;
+    int i;
+
+    for(i = 0; i < num_coef; i++)
+    {
+        sign = EVEY_SIGN_GET(coef[i]);
+        lev = (s64)EVEY_ABS(coef[i]) * (s64)scale;
+        lev = (s16)(((s64)lev * ns_scale + offset) >> shift);
+        coef[i] = (s16)EVEY_SIGN_SET(lev, sign);
+        nnz += !!(coef[i]);
+    }
+
+    return nnz;
+}
+
+int eveye_get_max_abs_coef_c(s16 * coef, int num_coef)
+{
+    int max_abs = 0;
+    int i;
+
+    for(i = 0; i < num_coef; i++)
+    {
+        max_abs = EVEY_MAX(max_abs, EVEY_ABS(coef[i]));
+    }
+
+    return max_abs;
+}
+
+
 int eveye_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 * src_coef, s16 * dst_tmp, int log2_cuw, int log2_cuh, int ch_type, EVEYE_CORE * core, int bit_depth)
 {
     const int   qp_rem = qp % 6;
@@ -508,51 +575,31 @@ int eveye_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 * src_coef
     const u32   max_num_coef = 1 << (log2_cuw + log2_cuh);
     const u16 * scan = evey_scan_tbl[COEF_SCAN_ZIGZAG][log2_cuw - 1][log2_cuh - 1];
     const int   ctx_last = (ch_type == Y_C) ? 0 : 1;
+    const int   ctx_run = (ch_type == Y_C) ? 0 : 2;
+    const int   ctx_level = (ch_type == Y_C) ? 0 : 2;
     const int   q_bits = QUANT_SHIFT + tr_shift + (qp / 6);
     const s64   lambda = (s64)(d_lambda * (double)(1 << SCALE_BITS) + 0.5);
     int nnz = 0;
     int sum_all = 0;
     u32 scan_pos;
     u32 run;
-    u32 prev_level;
+    u32 prev_pos;
+    u32 sig_cnt;
+    u32 i;
     u32 best_last_idx_p1 = 0;
     s16 tmp_coef[MAX_TR_DIM];
-    s64 tmp_level_double[MAX_TR_DIM];
-    s16 tmp_dst_coef[MAX_TR_DIM];    
+    s32 tmp_level_double[MAX_TR_DIM];
+    u16 sig_scan_pos[MAX_TR_DIM];
+    s16 sig_coef[MAX_TR_DIM];
     s64 err_scale = err_scale_tbl[qp_rem][log2_size - 1];
     s64 d64_best_cost = 0;
     s64 d64_base_cost = 0;
     s64 d64_coded_cost = 0;
     s64 d64_uncoded_cost = 0;
     s64 d64_block_uncoded_cost = 0;
-    s64 err;
 
     /* ===== quantization ===== */
-    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
-    {
-        u32 blk_pos = scan[scan_pos];
-        s64 level_double = src_coef[blk_pos];
-        u32 max_abs_level;
-        s8 lower_int;
-        s64 temp_level;
-
-        temp_level = ((s64)EVEY_ABS(src_coef[blk_pos]) * (s64)q_value);
-
-        level_double = (int)EVEY_MIN(((s64)temp_level), (s64)EVEY_INT32_MAX - (s64)(1 << (q_bits - 1)));
-        tmp_level_double[blk_pos] = level_double;
-        max_abs_level = (u32)(level_double >> q_bits);
-        lower_int = ((level_double - ((s64)max_abs_level << q_bits)) < (s64)(1 << (q_bits - 1))) ? 1 : 0;
-
-        if (!lower_int)
-        {
-            max_abs_level++;
-        }
-
-        err = (level_double * err_scale) >> ERR_SCALE_PRECISION_BITS;
-        d64_block_uncoded_cost += err * err;
-        tmp_coef[blk_pos] = src_coef[blk_pos] > 0 ? (s16)max_abs_level : -(s16)(max_abs_level);
-        sum_all += max_abs_level;
-    }
+    sum_all = eveye_kfn.rdoq_prepass(src_coef, max_num_coef, q_value, q_bits, err_scale, tmp_coef, tmp_level_double, &d64_block_uncoded_cost);
 
     evey_mset(dst_tmp, 0, sizeof(s16)*max_num_coef);
 
@@ -585,18 +632,39 @@ int eveye_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 * src_coef
         }     
     }
 
+    /* ===== collect significant coefficients in scan order ===== */
+    sig_cnt = 0;
+    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
+    {
+        if (tmp_coef[scan[scan_pos]])
+        {
+            sig_scan_pos[sig_cnt++] = (u16)scan_pos;
+        }
+    }
+
     run = 0;
-    prev_level = 6;
+    prev_pos = 0;
 
-    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
+    for (i = 0; i < sig_cnt; i++)
     {
-        u32 blk_pos = scan[scan_pos];
+        u32 blk_pos;
         u32 level;
-        int ctx_run = ch_type == Y_C ? 0 : 2;
-        int ctx_level = ch_type == Y_C ? 0 : 2;
 
+        scan_pos = sig_scan_pos[i];
+
+        /* zero coefficients between significant ones only add the rate of the run bins */
+        if (scan_pos > prev_pos)
+        {
+            s64 rate = core->rdoq_est_run[run == 0 ? ctx_run : ctx_run + 1][1];
+            rate += (s64)core->rdoq_est_run[ctx_run + 1][1] * (scan_pos - prev_pos - 1);
+            d64_base_cost += GET_I_COST(rate, lambda);
+            run += scan_pos - prev_pos;
+        }
+        prev_pos = scan_pos + 1;
+
+        blk_pos = scan[scan_pos];
         level = get_coded_level_rl(&d64_uncoded_cost, &d64_coded_cost, tmp_level_double[blk_pos], EVEY_ABS(tmp_coef[blk_pos]), run, ctx_run, ctx_level, q_bits, err_scale, lambda,  core);
-        tmp_dst_coef[blk_pos] = tmp_coef[blk_pos] < 0 ? -(s32)(level) : level;
+        sig_coef[i] = tmp_coef[blk_pos] < 0 ? -(s32)(level) : level;
         d64_base_cost -= d64_uncoded_cost;
         d64_base_cost += d64_coded_cost;
 
@@ -615,7 +683,6 @@ int eveye_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 * src_coef
                 best_last_idx_p1 = scan_pos + 1;
             }
             run = 0;
-            prev_level = level;
         }
         else
         {
@@ -623,24 +690,14 @@ int eveye_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 * src_coef
         }
     }
 
-    /* ===== clean uncoded coeficients ===== */
-    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
+    /* ===== write coefficients up to the last one ===== */
+    for (i = 0; i < sig_cnt && sig_scan_pos[i] < best_last_idx_p1; i++)
     {
-        u32 blk_pos = scan[scan_pos];
-
-        if (scan_pos < best_last_idx_p1)
-        {
-            if (tmp_dst_coef[blk_pos])
-            {
-                nnz++;
-            }
-        }
-        else
+        if (sig_coef[i])
         {
-            tmp_dst_coef[blk_pos] = 0;
+            dst_tmp[scan[sig_scan_pos[i]]] = sig_coef[i];
+            nnz++;
         }
-
-        dst_tmp[blk_pos] = tmp_dst_coef[blk_pos];
     }
 
     return nnz;
@@ -655,7 +712,6 @@ int eveye_quant_nnz(EVEYE_CORE * core, u8 qp, double lambda, int is_intra, s16 *
     int nnz = 0;
     s64 lev;
     s64 offset;
-    int i;
     int shift;
     int tr_shift;    
 
@@ -665,16 +721,10 @@ int eveye_quant_nnz(EVEYE_CORE * core, u8 qp, double lambda, int is_intra, s16 *
         shift = QUANT_SHIFT + tr_shift + (qp / 6);
         offset = (s64)(ch_type == Y_C ? 171 : 256) << (shift - 9);
 
-        for(i = 0; i < coef_num; i++)
-        {
-            lev = (s64)EVEY_ABS(coef[i]) * (s64)scale * ns_scale;
-            lev = (lev + offset) >> shift;
-            if(lev)
-            {
-                nnz = 1;
-                break;
-            }
-        }
+        /* quantized levels grow with |coef|, so the largest one decides */
+        lev = (s64)eveye_kfn.get_max_abs_coef(coef, coef_num) * (s64)scale * ns_scale;
+        lev = (lev + offset) >> shift;
+        nnz = lev ? 1 : 0;
 
         if(nnz)
         {
@@ -687,20 +737,11 @@ int eveye_quant_nnz(EVEYE_CORE * core, u8 qp, double lambda, int is_intra, s16 *
     }
     else
     {
-        int sign;        
-
         tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size + ns_shift;
         shift = QUANT_SHIFT + tr_shift + (qp / 6);
         offset = (s64)((slice_type == SLICE_I) ? 171 : 85) << (shift - 9);
 
-        for(i = 0; i < coef_num; i++)
-        {
-            sign = EVEY_SIGN_GET(coef[i]);
-            lev = (s64)EVEY_ABS(coef[i]) * (s64)scale;
-            lev = (s16)(((s64)lev * ns_scale + offset) >> shift);
-            coef[i] = (s16)EVEY_SIGN_SET(lev, sign);
-            nnz += !!(coef[i]);
-        }
+        nnz = eveye_kfn.quant_block(coef, coef_num, scale, ns_scale, offset, shift);
     }
 
     return nnz;
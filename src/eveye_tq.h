@@ -36,4 +36,15 @@
 int eveye_sub_block_tq(EVEYE_CTX * ctx, EVEYE_CORE * core, s16 coef[N_C][MAX_CU_DIM], int is_intra, int run_stats);
 void eveye_init_err_scale(int bit_depth);
 
+typedef int(*EVEYE_FN_RDOQ_PREPASS)(s16 * src_coef, int num_coef, int q_value, int q_bits, s64 err_scale,
+                                    s16 * tmp_coef, s32 * tmp_level_double, s64 * block_uncoded_cost);
+typedef int(*EVEYE_FN_QUANT_BLOCK)(s16 * coef, int num_coef, int scale, int ns_scale, s64 offset, int shift);
+typedef int(*EVEYE_FN_MAX_ABS_COEF)(s16 * coef, int num_coef);
+
+/* C kernels, registered by eveye_kfn_init_c() */
+int eveye_rdoq_prepass_c(s16 * src_coef, int num_coef, int q_value, int q_bits, s64 err_scale,
+                         s16 * tmp_coef, s32 * tmp_level_double, s64 * block_uncoded_cost);
+int eveye_quant_block_c(s16 * coef, int num_coef, int scale, int ns_scale, s64 offset, int shift);
+int eveye_get_max_abs_coef_c(s16 * coef, int num_coef);
+
 #endif /* _EVEYE_TQ_H_ */
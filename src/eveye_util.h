@@ -42,9 +42,9 @@ int eveye_bsw_write_nalu_size(EVEYE_BSW * bs);
 void eveye_diff_pred(EVEYE_CTX * ctx, int log2_cuw, int log2_cuh, pel org[N_C][MAX_CU_DIM], pel pred[N_C][MAX_CU_DIM], s16 diff[N_C][MAX_CU_DIM]);
 
 typedef void(*EVEYE_FN_DIFF)(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth);
-extern const EVEYE_FN_DIFF eveye_tbl_diff_16b[8][8];
-#define eveye_diff_16b(log2w, log2h, src1, src2, s_src1, s_src2, s_diff, diff, bit_depth) \
-    eveye_tbl_diff_16b[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, s_diff, diff, bit_depth)
+#define eveye_diff_16b(log2w, log2h, src1, src2, s_src1, s_src2, s_diff, dst, bit_depth) \
+    eveye_kfn.diff[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, s_diff, dst, bit_depth)
+void eveye_diff_16b_c(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth);
 
 #define SBAC_STORE(dst, src) evey_mcpy(&dst, &src, sizeof(EVEYE_SBAC))
 #define SBAC_LOAD(dst, src)  evey_mcpy(&dst, &src, sizeof(EVEYE_SBAC))